@@ -69,6 +69,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - converted some more function-like macros to static inline functions
 - converted the rest of the function-like macros to static inline functions
 - fix: forgot to comment out the EVE2 BITMAP_TRANSFORM_E when converting it to an inline function
+- Bugfix: BITMAP_SIZE() shifted the height into the bits of the width
 
 */
 
@@ -636,7 +637,7 @@ static inline uint32_t BITMAP_SIZE(uint8_t filter, uint8_t wrapx, uint8_t wrapy,
     uint32_t const wrapxv = (wrapx & 0x1UL) << 19U;
     uint32_t const wrapyv = (wrapy & 0x1UL) << 18U;
     uint32_t const widthv = (width & 0x1FFUL) << 9U;
-    uint32_t const heightv = (height & 0x1FFUL) << 9U;
+    uint32_t const heightv = (height & 0x1FFUL);
     return (DL_BITMAP_SIZE | filterv | wrapxv | wrapyv | widthv | heightv);
 }
 
@@ -0,0 +1,826 @@
+/*
+@file    EVE_cmd_stream.h
+@brief   C++ class to encode co-processor commands into a buffer of 32 bit words
+@version 5.0
+@date    2024-01-20
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2024 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+- burst() does not add anything to the burst after an overflow and returns E_NOT_OK then
+
+*/
+
+/* The co-processor commands as inline member functions that write the words of the command
+  into a buffer that is provided by the caller, with the same encoding as the EVE_cmd_xxx_burst() functions.
+  There is no SPI transfer and no check for burst-mode per command, a whole frame is encoded by inline code
+  and then sent with a single call to EVE_cmd_words_burst().
+
+  static uint32_t frame_words[1024U];
+  EVE_cmd_stream frame(frame_words, 1024U);
+
+  frame.clear();
+  frame.dlstart();
+  frame.dl(DL_CLEAR_COLOR_RGB | WHITE);
+  frame.dl(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+  frame.color_rgb(BLACK);
+  frame.text(10, 10, 28U, 0U, "Hello");
+  frame.text(10, 50, 28U, EVE_OPT_FORMAT, "%d mV", 3300U);
+  frame.dl(DL_DISPLAY);
+  frame.swap();
+  (void) frame.send();
+
+  The member functions are named like the EVE_cmd_xxx() functions, the display-list commands
+  from EVE.h are added with dl().
+  The format arguments for EVE_OPT_FORMAT are passed directly to text(), button() and toggle(),
+  they are ignored without EVE_OPT_FORMAT in the options like with EVE_cmd_text_var_burst().
+  Commands that return a result or that are followed by a block of data, like CMD_GETPTR, CMD_MEMCRC,
+  CMD_INFLATE or CMD_LOADIMAGE, are not available, these need EVE_cmd_xxx() to read the result
+  or to send the data.
+  The words that do not fit into the buffer are dropped and overflow() returns true, neither send() nor burst()
+  send an incomplete stream as the command the buffer ran out in would be cut in two.
+  This needs to be compiled with -std=c++11 or newer, for older standards this file is empty.
+*/
+
+#ifndef EVE_CMD_STREAM_H
+#define EVE_CMD_STREAM_H
+
+#include "EVE.h"
+
+#if defined (__cplusplus) && (__cplusplus >= 201103L)
+
+class EVE_cmd_stream
+{
+public:
+    /**
+     * @brief Use the buffer at p_words with space for "capacity" words.
+     */
+    EVE_cmd_stream(uint32_t *p_words, uint32_t capacity)
+        : p_words_(p_words), capacity_(capacity), count_(0UL), overflow_(false)
+    {
+    }
+
+    /* ##################################################################
+        buffer
+    ##################################################################### */
+
+    /**
+     * @brief Start over with an empty buffer.
+     */
+    void clear()
+    {
+        count_ = 0UL;
+        overflow_ = false;
+    }
+
+    /**
+     * @brief Number of words in the buffer.
+     */
+    uint32_t size() const
+    {
+        return (count_);
+    }
+
+    const uint32_t *data() const
+    {
+        return (p_words_);
+    }
+
+    /**
+     * @brief True if at least one word did not fit into the buffer.
+     */
+    bool overflow() const
+    {
+        return (overflow_);
+    }
+
+    /**
+     * @brief Add the words to a burst.
+     * @return - E_OK - if the words were added
+     * @return - E_NOT_OK - if the buffer overflowed, nothing is added then as the last command is incomplete
+     * @note - Needs to be called between EVE_start_cmd_burst() and EVE_end_cmd_burst().
+     * @note - With EVE_DL_BUDGET defined the words do not add to the display-list estimate.
+     */
+    uint8_t burst() const
+    {
+        uint8_t ret = E_NOT_OK;
+
+        if (!overflow_)
+        {
+            EVE_cmd_words_burst(p_words_, count_);
+            ret = E_OK;
+        }
+        return (ret);
+    }
+
+    /**
+     * @brief Send the words as one burst.
+     * @return - E_OK - if the words were sent
+     * @return - E_NOT_OK - if the buffer overflowed, nothing is sent then
+     * @note - With EVE_DMA this only queues the DMA transfer, the buffer can be filled again right away.
+     * @note - With EVE_DL_BUDGET defined the words do not add to the display-list estimate.
+     */
+    uint8_t send() const
+    {
+        uint8_t ret = E_NOT_OK;
+
+        if (!overflow_)
+        {
+            EVE_start_cmd_burst();
+            ret = burst();
+            EVE_end_cmd_burst();
+        }
+        return (ret);
+    }
+
+    /* ##################################################################
+        commands for display lists
+    ##################################################################### */
+
+    void dl(uint32_t command)
+    {
+        put(command);
+    }
+
+    void color_rgb(uint32_t color)
+    {
+        put(DL_COLOR_RGB | (color & 0x00ffffffUL));
+    }
+
+    void color_a(uint8_t alpha)
+    {
+        put(DL_COLOR_A | ((uint32_t) alpha));
+    }
+
+    void dlstart()
+    {
+        put(CMD_DLSTART);
+    }
+
+    void swap()
+    {
+        put(CMD_SWAP);
+    }
+
+    void coldstart()
+    {
+        put(CMD_COLDSTART);
+    }
+
+    void loadidentity()
+    {
+        put(CMD_LOADIDENTITY);
+    }
+
+    void setmatrix()
+    {
+        put(CMD_SETMATRIX);
+    }
+
+    void stop()
+    {
+        put(CMD_STOP);
+    }
+
+    void screensaver()
+    {
+        put(CMD_SCREENSAVER);
+    }
+
+    void videostart()
+    {
+        put(CMD_VIDEOSTART);
+    }
+
+    void append(uint32_t ptr, uint32_t num)
+    {
+        put(CMD_APPEND);
+        put(ptr);
+        put(num);
+    }
+
+    void bgcolor(uint32_t color)
+    {
+        put(CMD_BGCOLOR);
+        put(color);
+    }
+
+    template <typename... A>
+    void button(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t font, uint16_t options,
+                const char *p_text, A... arguments)
+    {
+        put(CMD_BUTTON);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(wid, hgt));
+        put(pair(font, options));
+        string(p_text);
+        format(options, arguments...);
+    }
+
+    void clock(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options, uint16_t hours, uint16_t mins,
+               uint16_t secs, uint16_t msecs)
+    {
+        put(CMD_CLOCK);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(rad, options));
+        put(pair(hours, mins));
+        put(pair(secs, msecs));
+    }
+
+    void dial(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options, uint16_t val)
+    {
+        put(CMD_DIAL);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(rad, options));
+        put((uint32_t) val);
+    }
+
+    void fgcolor(uint32_t color)
+    {
+        put(CMD_FGCOLOR);
+        put(color);
+    }
+
+    void gauge(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options, uint16_t major, uint16_t minor,
+               uint16_t val, uint16_t range)
+    {
+        put(CMD_GAUGE);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(rad, options));
+        put(pair(major, minor));
+        put(pair(val, range));
+    }
+
+    void gradcolor(uint32_t color)
+    {
+        put(CMD_GRADCOLOR);
+        put(color);
+    }
+
+    void gradient(int16_t xc0, int16_t yc0, uint32_t rgb0, int16_t xc1, int16_t yc1, uint32_t rgb1)
+    {
+        put(CMD_GRADIENT);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(rgb0);
+        put(pair((uint16_t) xc1, (uint16_t) yc1));
+        put(rgb1);
+    }
+
+    void keys(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t font, uint16_t options,
+              const char *p_text)
+    {
+        put(CMD_KEYS);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(wid, hgt));
+        put(pair(font, options));
+        string(p_text);
+    }
+
+    void number(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options, int32_t number)
+    {
+        put(CMD_NUMBER);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(font, options));
+        put((uint32_t) number);
+    }
+
+    void progress(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t options, uint16_t val,
+                  uint16_t range)
+    {
+        put(CMD_PROGRESS);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(wid, hgt));
+        put(pair(options, val));
+        put((uint32_t) range);
+    }
+
+    void romfont(uint32_t font, uint32_t romslot)
+    {
+        put(CMD_ROMFONT);
+        put(font);
+        put(romslot);
+    }
+
+    void rotate(uint32_t angle)
+    {
+        put(CMD_ROTATE);
+        put(angle & 0xFFFFUL);
+    }
+
+    void scale(int32_t scx, int32_t scy)
+    {
+        put(CMD_SCALE);
+        put((uint32_t) scx);
+        put((uint32_t) scy);
+    }
+
+    void scrollbar(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t options, uint16_t val,
+                   uint16_t size, uint16_t range)
+    {
+        put(CMD_SCROLLBAR);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(wid, hgt));
+        put(pair(options, val));
+        put(pair(size, range));
+    }
+
+    void setbase(uint32_t base)
+    {
+        put(CMD_SETBASE);
+        put(base);
+    }
+
+    void setbitmap(uint32_t addr, uint16_t fmt, uint16_t width, uint16_t height)
+    {
+        put(CMD_SETBITMAP);
+        put(addr);
+        put(pair(fmt, width));
+        put((uint32_t) height);
+    }
+
+    void setfont(uint32_t font, uint32_t ptr)
+    {
+        put(CMD_SETFONT);
+        put(font);
+        put(ptr);
+    }
+
+    void setfont2(uint32_t font, uint32_t ptr, uint32_t firstchar)
+    {
+        put(CMD_SETFONT2);
+        put(font);
+        put(ptr);
+        put(firstchar);
+    }
+
+    void setscratch(uint32_t handle)
+    {
+        put(CMD_SETSCRATCH);
+        put(handle);
+    }
+
+    void sketch(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint32_t ptr, uint16_t format)
+    {
+        put(CMD_SKETCH);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(wid, hgt));
+        put(ptr);
+        put((uint32_t) format);
+    }
+
+    void slider(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t options, uint16_t val,
+                uint16_t range)
+    {
+        put(CMD_SLIDER);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(wid, hgt));
+        put(pair(options, val));
+        put((uint32_t) range);
+    }
+
+    void spinner(int16_t xc0, int16_t yc0, uint16_t style, uint16_t scale)
+    {
+        put(CMD_SPINNER);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(style, scale));
+    }
+
+    template <typename... A>
+    void text(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options, const char *p_text, A... arguments)
+    {
+        put(CMD_TEXT);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(font, options));
+        string(p_text);
+        format(options, arguments...);
+    }
+
+    template <typename... A>
+    void toggle(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t font, uint16_t options, uint16_t state,
+                const char *p_text, A... arguments)
+    {
+        put(CMD_TOGGLE);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(wid, font));
+        put(pair(options, state));
+        string(p_text);
+        format(options, arguments...);
+    }
+
+    void track(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t tag)
+    {
+        put(CMD_TRACK);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(wid, hgt));
+        put((uint32_t) tag);
+    }
+
+    void translate(int32_t tr_x, int32_t tr_y)
+    {
+        put(CMD_TRANSLATE);
+        put((uint32_t) tr_x);
+        put((uint32_t) tr_y);
+    }
+
+    /* ##################################################################
+        commands that are executed without a result
+    ##################################################################### */
+
+    void interrupt(uint32_t msec)
+    {
+        put(CMD_INTERRUPT);
+        put(msec);
+    }
+
+    void mediafifo(uint32_t ptr, uint32_t size)
+    {
+        put(CMD_MEDIAFIFO);
+        put(ptr);
+        put(size);
+    }
+
+    void memcpy(uint32_t dest, uint32_t src, uint32_t num)
+    {
+        put(CMD_MEMCPY);
+        put(dest);
+        put(src);
+        put(num);
+    }
+
+    void memset(uint32_t ptr, uint8_t value, uint32_t num)
+    {
+        put(CMD_MEMSET);
+        put(ptr);
+        put((uint32_t) value);
+        put(num);
+    }
+
+    void memzero(uint32_t ptr, uint32_t num)
+    {
+        put(CMD_MEMZERO);
+        put(ptr);
+        put(num);
+    }
+
+    void setrotate(uint32_t rotation)
+    {
+        put(CMD_SETROTATE);
+        put(rotation);
+    }
+
+    void snapshot(uint32_t ptr)
+    {
+        put(CMD_SNAPSHOT);
+        put(ptr);
+    }
+
+    void snapshot2(uint32_t fmt, uint32_t ptr, int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt)
+    {
+        put(CMD_SNAPSHOT2);
+        put(fmt);
+        put(ptr);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(pair(wid, hgt));
+    }
+
+    void videoframe(uint32_t dest, uint32_t result_ptr)
+    {
+        put(CMD_VIDEOFRAME);
+        put(dest);
+        put(result_ptr);
+    }
+
+/* BT815 / BT816 */
+#if EVE_GEN > 2
+
+    void sync()
+    {
+        put(CMD_SYNC);
+    }
+
+    void resetfonts()
+    {
+        put(CMD_RESETFONTS);
+    }
+
+    void flashattach()
+    {
+        put(CMD_FLASHATTACH);
+    }
+
+    void flashdetach()
+    {
+        put(CMD_FLASHDETACH);
+    }
+
+    void flasherase()
+    {
+        put(CMD_FLASHERASE);
+    }
+
+    void flashspidesel()
+    {
+        put(CMD_FLASHSPIDESEL);
+    }
+
+    void flashread(uint32_t dest, uint32_t src, uint32_t num)
+    {
+        put(CMD_FLASHREAD);
+        put(dest);
+        put(src);
+        put(num);
+    }
+
+    void flashsource(uint32_t ptr)
+    {
+        put(CMD_FLASHSOURCE);
+        put(ptr);
+    }
+
+    void flashupdate(uint32_t dest, uint32_t src, uint32_t num)
+    {
+        put(CMD_FLASHUPDATE);
+        put(dest);
+        put(src);
+        put(num);
+    }
+
+    void animdraw(int32_t chnl)
+    {
+        put(CMD_ANIMDRAW);
+        put((uint32_t) chnl);
+    }
+
+    void animframe(int16_t xc0, int16_t yc0, uint32_t aoptr, uint32_t frame)
+    {
+        put(CMD_ANIMFRAME);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(aoptr);
+        put(frame);
+    }
+
+    void animstart(int32_t chnl, uint32_t aoptr, uint32_t loop)
+    {
+        put(CMD_ANIMSTART);
+        put((uint32_t) chnl);
+        put(aoptr);
+        put(loop);
+    }
+
+    void animstop(int32_t chnl)
+    {
+        put(CMD_ANIMSTOP);
+        put((uint32_t) chnl);
+    }
+
+    void animxy(int32_t chnl, int16_t xc0, int16_t yc0)
+    {
+        put(CMD_ANIMXY);
+        put((uint32_t) chnl);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+    }
+
+    void appendf(uint32_t ptr, uint32_t num)
+    {
+        put(CMD_APPENDF);
+        put(ptr);
+        put(num);
+    }
+
+    void bitmap_transform(int32_t xc0, int32_t yc0, int32_t xc1, int32_t yc1, int32_t xc2, int32_t yc2,
+                          int32_t tx0, int32_t ty0, int32_t tx1, int32_t ty1, int32_t tx2, int32_t ty2)
+    {
+        put(CMD_BITMAP_TRANSFORM);
+        put((uint32_t) xc0);
+        put((uint32_t) yc0);
+        put((uint32_t) xc1);
+        put((uint32_t) yc1);
+        put((uint32_t) xc2);
+        put((uint32_t) yc2);
+        put((uint32_t) tx0);
+        put((uint32_t) ty0);
+        put((uint32_t) tx1);
+        put((uint32_t) ty1);
+        put((uint32_t) tx2);
+        put((uint32_t) ty2);
+        put(0UL); /* result */
+    }
+
+    void fillwidth(uint32_t pixel)
+    {
+        put(CMD_FILLWIDTH);
+        put(pixel);
+    }
+
+    void gradienta(int16_t xc0, int16_t yc0, uint32_t argb0, int16_t xc1, int16_t yc1, uint32_t argb1)
+    {
+        put(CMD_GRADIENTA);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(argb0);
+        put(pair((uint16_t) xc1, (uint16_t) yc1));
+        put(argb1);
+    }
+
+    void rotatearound(int32_t xc0, int32_t yc0, uint32_t angle, int32_t scale)
+    {
+        put(CMD_ROTATEAROUND);
+        put((uint32_t) xc0);
+        put((uint32_t) yc0);
+        put(angle & 0xFFFFUL);
+        put((uint32_t) scale);
+    }
+
+#endif /* EVE_GEN > 2 */
+
+/* BT817 / BT818 */
+#if EVE_GEN > 3
+
+    void endlist()
+    {
+        put(CMD_ENDLIST);
+    }
+
+    void videostartf()
+    {
+        put(CMD_VIDEOSTARTF);
+    }
+
+    void animframeram(int16_t xc0, int16_t yc0, uint32_t aoptr, uint32_t frame)
+    {
+        put(CMD_ANIMFRAMERAM);
+        put(pair((uint16_t) xc0, (uint16_t) yc0));
+        put(aoptr);
+        put(frame);
+    }
+
+    void animstartram(int32_t chnl, uint32_t aoptr, uint32_t loop)
+    {
+        put(CMD_ANIMSTARTRAM);
+        put((uint32_t) chnl);
+        put(aoptr);
+        put(loop);
+    }
+
+    void apilevel(uint32_t level)
+    {
+        put(CMD_APILEVEL);
+        put(level);
+    }
+
+    void calllist(uint32_t adr)
+    {
+        put(CMD_CALLLIST);
+        put(adr);
+    }
+
+    void flashprogram(uint32_t dest, uint32_t src, uint32_t num)
+    {
+        put(CMD_FLASHPROGRAM);
+        put(dest);
+        put(src);
+        put(num);
+    }
+
+    void fontcache(uint32_t font, uint32_t ptr, uint32_t num)
+    {
+        put(CMD_FONTCACHE);
+        put(font);
+        put(ptr);
+        put(num);
+    }
+
+    void hsf(uint32_t hsf)
+    {
+        put(CMD_HSF);
+        put(hsf);
+    }
+
+    void linetime(uint32_t dest)
+    {
+        put(CMD_LINETIME);
+        put(dest);
+    }
+
+    void newlist(uint32_t adr)
+    {
+        put(CMD_NEWLIST);
+        put(adr);
+    }
+
+    void runanim(uint32_t waitmask, uint32_t play)
+    {
+        put(CMD_RUNANIM);
+        put(waitmask);
+        put(play);
+    }
+
+    void wait(uint32_t usec)
+    {
+        put(CMD_WAIT);
+        put(usec);
+    }
+
+#endif /* EVE_GEN > 3 */
+
+private:
+    uint32_t *p_words_;
+    uint32_t capacity_;
+    uint32_t count_;
+    bool overflow_;
+
+    void put(uint32_t word)
+    {
+        if (count_ < capacity_)
+        {
+            p_words_[count_] = word;
+            count_++;
+        }
+        else
+        {
+            overflow_ = true;
+        }
+    }
+
+    static uint32_t pair(uint16_t low, uint16_t high)
+    {
+        return (((uint32_t) low) + (((uint32_t) high) << 16U));
+    }
+
+    /* same as private_string_write() in burst-mode: 4 bytes per word, at least one zero byte, 249 characters max */
+    void string(const char *p_text)
+    {
+        const uint8_t *const p_bytes = (const uint8_t *) p_text;
+        uint32_t calc = 0UL;
+        uint8_t textindex = 0U;
+        bool done = false;
+
+        while (!done)
+        {
+            uint8_t data = 0U;
+
+            if (textindex < 252U)
+            {
+                data = p_bytes[textindex];
+            }
+
+            calc += ((uint32_t) data) << ((textindex & 3U) * 8U);
+
+            if ((0U == data) || (3U == (textindex & 3U)))
+            {
+                put(calc);
+                calc = 0UL;
+                done = (0U == data);
+            }
+            textindex++;
+        }
+    }
+
+    /* the arguments for EVE_OPT_FORMAT, like EVE_cmd_text_var_burst() these are only sent with EVE_OPT_FORMAT */
+    template <typename... A>
+    void format(uint16_t options, A... arguments)
+    {
+        const uint32_t words[] = {0UL, ((uint32_t) arguments)...};
+
+#if EVE_GEN > 2
+        if ((options & EVE_OPT_FORMAT) != 0U)
+        {
+            for (uint32_t index = 1UL; index < (sizeof(words) / sizeof(words[0])); index++)
+            {
+                put(words[index]);
+            }
+        }
+#else
+        (void) options;
+        (void) words;
+#endif
+    }
+};
+
+#endif /* C++11 */
+
+#endif /* EVE_CMD_STREAM_H */
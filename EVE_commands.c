@@ -153,6 +153,31 @@ without the traling _burst in the name when exceution speed is not an issue - e.
 - started to improve the embedded documentation
 - added more documentation
 - removed EVE_cmd_hsf_burst()
+- Bugfix: EVE_cmd_calibratesub() did not send the result word so the coprocessor took the next command for it
+- changed EVE_memWrite_flash_buffer(), EVE_memWrite_sram_buffer() and private_block_write() to use
+    the new target function spi_transmit_block() instead of calling spi_transmit() for every byte
+- changed EVE_memRead_sram_buffer() to use the new target function spi_receive_block()
+- added a ring of EVE_DMA_BUFFERS DMA buffers so the next burst can be written while the last one is sent,
+    EVE_busy() starts the queued transfers and reports EVE_IS_BUSY as long as there are any
+- added EVE_burst_segment() to split bursts that are longer than the DMA buffer or the free space in the CMD-FIFO
+- added EVE_cmd_poll() and non-blocking EVE_cmd_xxx_start() variants of EVE_cmd_flasherase(), EVE_cmd_flashupdate(),
+    EVE_cmd_inflate(), EVE_cmd_loadimage() and EVE_cmd_memcpy()
+- added EVE_int_set_callback(), EVE_int_edge() and EVE_int_service() to dispatch the interrupts from INT_N to callbacks
+- added EVE_frame_start() / EVE_frame_end() for EVE_DMA that do not send a frame that is identical to the last one
+- added EVE_media_start() and EVE_media_poll() to stream data from a read function thru the media FIFO
+- added EVE_cmd_words_burst() to add commands that are encoded in memory to a burst
+- added EVE_ctx_init(), EVE_ctx_select() and EVE_ctx_int_edge() to drive more than one EVE,
+    the DMA buffers are addressed thru p_dma_ring now
+- added EVE_set_spi_width() to switch to dual or quad SPI, EVE_init() switches the host back to single SPI
+- added EVE_ramp_spi_clock() and EVE_get_spi_clock(), EVE_init() raises the SPI clock with EVE_SPI_CLOCK_MAX defined
+- added EVE_memRead_regs() and EVE_memWrite_regs() for consecutive registers in one transfer and
+    EVE_reg_batch_init(), EVE_reg_batch_write() and EVE_reg_batch_send() to send register writes as CMD_MEMWRITE,
+    EVE_init(), EVE_write_display_parameters() and EVE_calibrate_manual() use EVE_memWrite_regs() for blocks of registers
+- added EVE_dl_budget_init(), EVE_dl_budget_left(), EVE_dl_budget_check() and EVE_dl_budget_get_stats()
+    with EVE_DL_BUDGET defined, the display-list commands add the bytes they are estimated to generate in RAM_DL
+- the SPI clock EVE_ramp_spi_clock() selected is kept in EVE_ctx_t, EVE_ctx_select() sets it for the EVE it selects
+- the display-list budget is kept in EVE_ctx_t
+- with EVE_DMA EVE_busy() drops the queued buffers when it recovers from a coprocessor fault
 
 */
 
@@ -169,6 +194,96 @@ without the traling _burst in the name when exceution speed is not an issue - e.
 
 static volatile uint8_t cmd_burst = 0U; /* flag to indicate cmd-burst is active */
 static volatile uint8_t fault_recovered = E_OK; /* flag to indicate if EVE_busy triggered a fault recovery */
+static uint16_t cmdb_space = 0U; /* bytes that are free in the CMD-FIFO at least, 0 if not known */
+
+#define BURST_SEGMENT_WORDS 512U /* limit for the segments after the first, see EVE_burst_segment() */
+
+uint16_t EVE_burst_words = 0U; /* words spi_transmit_burst() can write before it needs to call EVE_burst_segment() */
+
+static volatile uint8_t int_pending = 0U; /* set by EVE_int_edge(), INT_N went low since the last EVE_int_service() */
+static volatile uint8_t *p_int_pending = &int_pending; /* int_pending or the one of the current EVE_ctx_t */
+static EVE_int_callback_t int_callbacks[8U]; /* one for each bit in REG_INT_FLAGS */
+
+static EVE_ctx_t *p_ctx_current = NULL; /* the state above belongs to this context, NULL without EVE_ctx_select() */
+
+#if defined (EVE_SPI_CLOCK_MAX)
+#define SPI_CLOCK_TEST_SIZE 64U /* bytes of the test pattern at the start of RAM_G, see EVE_ramp_spi_clock() */
+#define SPI_CLOCK_TEST_ROUNDS 4U /* patterns that are written and read back for each step */
+
+static uint32_t spi_clock = EVE_SPI_CLOCK_INIT; /* the SPI clock that spi_set_clock() returned last, kept in EVE_ctx_t */
+#endif
+
+#if defined (EVE_DL_BUDGET)
+/* display-list bytes a coprocessor command generates, the numbers are estimates for the default options */
+typedef struct
+{
+    uint8_t command; /* the lowest byte of the command */
+    uint8_t unit; /* bytes per character of the string or per unit of the count passed to dl_budget_add() */
+    uint16_t bytes; /* bytes for the command itself */
+} dl_cost_t;
+
+static const dl_cost_t dl_costs[] =
+{
+    {(uint8_t) CMD_TEXT, 4U, 12U},
+    {(uint8_t) CMD_BUTTON, 4U, 64U},
+    {(uint8_t) CMD_KEYS, 52U, 16U}, /* every character is a key */
+    {(uint8_t) CMD_TOGGLE, 4U, 96U},
+    {(uint8_t) CMD_NUMBER, 0U, 56U},
+    {(uint8_t) CMD_PROGRESS, 0U, 56U},
+    {(uint8_t) CMD_SLIDER, 0U, 80U},
+    {(uint8_t) CMD_SCROLLBAR, 0U, 80U},
+    {(uint8_t) CMD_DIAL, 0U, 88U},
+    {(uint8_t) CMD_GAUGE, 8U, 96U}, /* the count is the number of ticks, major * minor */
+    {(uint8_t) CMD_CLOCK, 0U, 520U},
+    {(uint8_t) CMD_SPINNER, 0U, 136U},
+    {(uint8_t) CMD_GRADIENT, 0U, 72U},
+    {(uint8_t) CMD_SCREENSAVER, 0U, 16U},
+    {(uint8_t) CMD_SKETCH, 0U, 16U},
+    {(uint8_t) CMD_SETFONT2, 0U, 28U},
+    {(uint8_t) CMD_ROMFONT, 0U, 28U},
+    {(uint8_t) CMD_SETBITMAP, 0U, 28U},
+    {(uint8_t) CMD_SETMATRIX, 0U, 24U},
+    {(uint8_t) CMD_APPEND, 1U, 0U}, /* the count is the number of bytes */
+#if EVE_GEN > 2
+    {(uint8_t) CMD_BITMAP_TRANSFORM, 0U, 24U},
+    {(uint8_t) CMD_GRADIENTA, 0U, 72U},
+    {(uint8_t) CMD_ANIMFRAME, 0U, 64U},
+    {(uint8_t) CMD_APPENDF, 1U, 0U}, /* the count is the number of bytes */
+#endif
+#if EVE_GEN > 3
+    {(uint8_t) CMD_ANIMFRAMERAM, 0U, 64U},
+    {(uint8_t) CMD_CALLLIST, 0U, 4U},
+#endif
+};
+
+static uint32_t dl_estimate = 0UL; /* display-list bytes estimated for the commands since CMD_DLSTART */
+static uint32_t dl_correction = 0UL; /* how much the estimate for the last display list that was checked was too low */
+static uint32_t dl_limit = EVE_RAM_DL_SIZE;
+static uint8_t dl_unit = 0U; /* bytes per character for the string of the current command */
+static uint8_t dl_warned = 0U; /* the callback was called for the current display list */
+static EVE_dl_budget_callback_t p_dl_callback = NULL;
+static EVE_dl_budget_stats_t dl_stats;
+#endif
+
+#if defined (EVE_DMA)
+/* EVE_end_cmd_burst() queues the buffer that was just filled and the next burst goes into the next buffer, */
+/* the queued buffers are sent one after another as soon as the DMA is idle and the CMD-FIFO has room */
+static uint32_t dma_ring_default[EVE_DMA_RING_WORDS];
+static uint32_t *p_dma_ring = dma_ring_default; /* EVE_DMA_BUFFERS buffers of 1025 words */
+static uint16_t dma_length[EVE_DMA_BUFFERS]; /* EVE_dma_buffer_index of a queued buffer */
+static uint8_t dma_head = 0U; /* the buffer EVE_dma_buffer points to */
+static uint8_t dma_tail = 0U; /* the oldest buffer that is queued or in transfer */
+static uint8_t dma_count = 0U; /* number of buffers that are queued or in transfer */
+static uint8_t dma_active = 0U; /* the buffer at dma_tail is in transfer */
+static uint8_t dma_fifo_empty = 1U; /* EVE_busy() saw an empty CMD-FIFO since the last transfer was started */
+
+static uint8_t burst_segmented = 0U; /* the current burst did not fit in one buffer */
+static uint8_t frame_valid = 0U; /* frame_hash is the hash of the frame that is on screen */
+static uint32_t frame_hash = 0U;
+static EVE_frame_stats_t frame_stats;
+
+uint32_t *EVE_dma_buffer = dma_ring_default;
+#endif
 
 /* ##################################################################
     helper functions
@@ -283,12 +398,14 @@ void EVE_memWrite_flash_buffer(uint32_t const ft_address, const uint8_t *p_data,
         spi_transmit((uint8_t) (ft_address >> 8U));
         spi_transmit((uint8_t) (ft_address & 0x000000ffUL));
 
-    //    uint32_t length = (len + 3U) & (~3U);
-
+#if defined (EVE_FLASH_NOT_MAPPED)
         for (uint32_t count = 0U; count < len; count++)
         {
             spi_transmit(fetch_flash_byte(&p_data[count]));
         }
+#else
+        spi_transmit_block(p_data, len);
+#endif
 
         EVE_cs_clear();
     }    
@@ -305,14 +422,7 @@ void EVE_memWrite_sram_buffer(uint32_t const ft_address, const uint8_t *p_data,
         spi_transmit((uint8_t) (ft_address >> 16U) | MEM_WRITE);
         spi_transmit((uint8_t) (ft_address >> 8U));
         spi_transmit((uint8_t) (ft_address & 0x000000ffUL));
-
-    //    uint32_t length = (len + 3U) & (~3U);
-
-        for (uint32_t count = 0U; count < len; count++)
-        {
-            spi_transmit(p_data[count]);
-        }
-
+        spi_transmit_block(p_data, len);
         EVE_cs_clear();
     }
 }
@@ -327,13 +437,129 @@ void EVE_memRead_sram_buffer(uint32_t const ft_address, uint8_t *p_data, uint32_
         EVE_cs_set();
         spi_transmit_32(((ft_address >> 16U) & 0x0000007fUL) + (ft_address & 0x0000ff00UL) + ((ft_address & 0x000000ffUL) << 16U));
 
-        for (uint32_t count = 0U; count < len; count++)
+        spi_receive_block(p_data, len);
+        EVE_cs_clear();
+    }
+}
+
+/**
+ * @brief Read count consecutive 32 bit registers in one transfer, like the touch registers from REG_TOUCH_SCREEN_XY on.
+ */
+void EVE_memRead_regs(uint32_t const ft_address, uint32_t *p_values, uint32_t const count)
+{
+    if (p_values != NULL)
+    {
+        EVE_cs_set();
+        spi_transmit_32(((ft_address >> 16U) & 0x0000007fUL) + (ft_address & 0x0000ff00UL) + ((ft_address & 0x000000ffUL) << 16U));
+
+        for (uint32_t index = 0U; index < count; index++)
         {
-            p_data[count] = spi_receive(0U); /* read data byte by sending another dummy byte */
+            uint32_t data;
+
+            data = ((uint32_t) spi_receive(0U)); /* read low byte */
+            data = ((uint32_t) spi_receive(0U) << 8U) | data;
+            data = ((uint32_t) spi_receive(0U) << 16U) | data;
+            data = ((uint32_t) spi_receive(0U) << 24U) | data; /* read high byte */
+            p_values[index] = data;
         }
+        EVE_cs_clear();
+    }
+}
+
+/**
+ * @brief Write count consecutive 32 bit registers in one transfer, like the six REG_TOUCH_TRANSFORM_x registers.
+ * @note - The registers are written in the order of their addresses.
+ */
+void EVE_memWrite_regs(uint32_t const ft_address, const uint32_t *p_values, uint32_t const count)
+{
+    if (p_values != NULL)
+    {
+        EVE_cs_set();
+        spi_transmit((uint8_t) (ft_address >> 16U) | MEM_WRITE); /* send Memory Write plus high address byte */
+        spi_transmit((uint8_t) (ft_address >> 8U));              /* send middle address byte */
+        spi_transmit((uint8_t) (ft_address & 0x000000ffUL));     /* send low address byte */
 
+        for (uint32_t index = 0U; index < count; index++)
+        {
+            spi_transmit_32(p_values[index]);
+        }
         EVE_cs_clear();
-    }    
+    }
+}
+
+/**
+ * @brief Set up an empty batch of register writes in p_words.
+ * @param size - number of 32 bit words in p_words, each run of consecutive registers takes three words plus one for each register
+ */
+void EVE_reg_batch_init(EVE_reg_batch_t *p_batch, uint32_t *p_words, uint32_t size)
+{
+    if (p_batch != NULL)
+    {
+        p_batch->p_words = p_words;
+        p_batch->size = size;
+        p_batch->count = 0U;
+        p_batch->run = 0U;
+    }
+}
+
+/**
+ * @brief Add the write of a 32 bit register to the batch.
+ * @return - E_OK - if the write was added
+ * @return - E_NOT_OK - if the batch is full
+ * @note - A register at the address that follows the last one is added to the same CMD_MEMWRITE,
+ * add the registers of a block in the order of their addresses to send them together.
+ */
+uint8_t EVE_reg_batch_write(EVE_reg_batch_t *p_batch, uint32_t ft_address, uint32_t ft_data)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((p_batch != NULL) && (p_batch->p_words != NULL))
+    {
+        uint32_t run = p_batch->run;
+
+        if ((run != 0U) && ((p_batch->p_words[run - 1U] + p_batch->p_words[run]) == ft_address))
+        {
+            if ((p_batch->count + 1U) <= p_batch->size)
+            {
+                p_batch->p_words[p_batch->count] = ft_data;
+                p_batch->count++;
+                p_batch->p_words[run] += 4U;
+                ret = E_OK;
+            }
+        }
+        else if ((p_batch->count + 4U) <= p_batch->size)
+        {
+            p_batch->p_words[p_batch->count] = CMD_MEMWRITE;
+            p_batch->p_words[p_batch->count + 1U] = ft_address;
+            p_batch->p_words[p_batch->count + 2U] = 4U;
+            p_batch->p_words[p_batch->count + 3U] = ft_data;
+            p_batch->run = p_batch->count + 2U;
+            p_batch->count += 4U;
+            ret = E_OK;
+        }
+        else
+        {
+        }
+    }
+
+    return (ret);
+}
+
+/**
+ * @brief Send all the writes in the batch to the CMD-FIFO in one burst and empty the batch.
+ * @note - The registers are written by the co-processor in the order they were added.
+ * @note - Meant to be used outside display-list building, this is a burst of its own.
+ */
+void EVE_reg_batch_send(EVE_reg_batch_t *p_batch)
+{
+    if ((p_batch != NULL) && (p_batch->count != 0U))
+    {
+        EVE_start_cmd_burst();
+        EVE_cmd_words_burst(p_batch->p_words, p_batch->count);
+        EVE_end_cmd_burst();
+        p_batch->count = 0U;
+        p_batch->run = 0U;
+    }
 }
 
 static void CoprocessorFaultRecover(void)
@@ -364,13 +590,56 @@ static void CoprocessorFaultRecover(void)
         DELAY_MS(10U);                   /* just to be safe */
 }
 
+#if defined (EVE_DMA)
+/* free the buffer at the tail of the ring once its transfer is complete */
+static void dma_ring_release(void)
+{
+    if ((0U != dma_active) && (0U == EVE_dma_busy))
+    {
+        dma_active = 0U;
+        dma_tail = (uint8_t) ((dma_tail + 1U) % EVE_DMA_BUFFERS);
+        dma_count--;
+    }
+}
+
+/* send the buffer at the tail of the ring, EVE_start_dma_transfer() only knows EVE_dma_buffer and EVE_dma_buffer_index */
+static void dma_ring_start(void)
+{
+    uint32_t *p_buffer = EVE_dma_buffer;
+    uint16_t index = EVE_dma_buffer_index;
+
+    EVE_dma_buffer = &p_dma_ring[dma_tail * 1025U];
+    EVE_dma_buffer_index = dma_length[dma_tail];
+    dma_active = 1U;
+    dma_fifo_empty = 0U;
+    EVE_start_dma_transfer();
+    EVE_dma_buffer = p_buffer;
+    EVE_dma_buffer_index = index;
+}
+
+static void dma_ring_reset(void)
+{
+    dma_head = 0U;
+    dma_tail = 0U;
+    dma_count = 0U;
+    dma_active = 0U;
+    dma_fifo_empty = 1U;
+    EVE_dma_buffer = p_dma_ring;
+    frame_valid = 0U; /* the display list that was on screen is gone */
+}
+#endif
+
 /**
  * @brief Check if the coprocessor completed executing the current command list.
- * @return - E_OK - if EVE is not busy (no DMA transfer active and REG_CMDB_SPACE has the value 0xffc, meaning the CMD-FIFO is empty
- * @return - EVE_IS_BUSY - if a DMA transfer is active or REG_CMDB_SPACE has a value smaller than 0xffc
- * @return - EVE_FIFO_HALF_EMPTY - if no DMA transfer is active and REG_CMDB_SPACE shows more than 2048 bytes available
+ * @return - E_OK - if EVE is not busy (no DMA transfer active or queued and REG_CMDB_SPACE has the value 0xffc, meaning the CMD-FIFO is empty
+ * @return - EVE_IS_BUSY - if a DMA transfer is active or queued or REG_CMDB_SPACE has a value smaller than 0xffc
+ * @return - EVE_FIFO_HALF_EMPTY - if no DMA transfer is active or queued and REG_CMDB_SPACE shows more than 2048 bytes available
  * @return - E_NOT_OK - if there was a coprocessor fault and the recovery sequence was executed
  * @note - if there is a coprocessor fault the external flash is not reinitialized by EVE_busy()
+ * @note - with EVE_DMA this starts the transfer of the next queued buffer as soon as the CMD-FIFO has room for it,
+ * @note - any function that is not a burst function needs EVE_busy() to return E_OK first as the queued buffers would be sent after it
+ * @note - with EVE_DMA the buffers that are queued when a coprocessor fault is found are dropped,
+ * the frames in them are not sent and the next frame is not skipped by EVE_frame_end()
  */
 uint8_t EVE_busy(void)
 {
@@ -378,6 +647,8 @@ uint8_t EVE_busy(void)
     uint8_t ret = EVE_IS_BUSY;
 
 #if defined (EVE_DMA)
+    dma_ring_release();
+
     if (0 == EVE_dma_busy)
     {
 #endif
@@ -387,16 +658,38 @@ uint8_t EVE_busy(void)
     /* (REG_CMDB_SPACE & 0x03) != 0 -> we have a coprocessor fault */
     if ((space & 3U) != 0U) /* we have a coprocessor fault, make EVE play with us again */
     {
+        cmdb_space = 0U;
         ret = EVE_FAULT_RECOVERED;
         fault_recovered = EVE_FAULT_RECOVERED; /* save fault recovery state */
         CoprocessorFaultRecover();
+#if defined (EVE_DMA)
+        dma_ring_reset(); /* the queued buffers were built for the CMD-FIFO before the fault */
+#endif
     }
     else
     {
+        cmdb_space = space;
+
+#if defined (EVE_DMA)
+        if (0U != dma_count) /* there is a buffer waiting for its transfer */
+        {
+            if (space >= ((dma_length[dma_tail] - 1U) * 4U)) /* the first entry is the address */
+            {
+                dma_ring_start();
+            }
+            ret = EVE_IS_BUSY;
+        }
+        else if (0xffcU == space)
+        {
+            dma_fifo_empty = 1U;
+            ret = E_OK;
+        }
+#else
         if (0xffcU == space)
         {
             ret = E_OK;
         }
+#endif
         else if (space > 0x800U)
         {
             ret = EVE_FIFO_HALF_EMPTY;
@@ -442,9 +735,473 @@ void EVE_execute_cmd(void)
     }
 }
 
+/**
+ * @brief Register a function to be called by EVE_int_service() when EVE sets the interrupt flag int_flag.
+ * This updates REG_INT_MASK to the flags that have a callback and sets REG_INT_EN if there are any.
+ * @param int_flag - one of EVE_INT_SWAP, EVE_INT_TOUCH, EVE_INT_TAG, EVE_INT_SOUND, EVE_INT_PLAYBACK,
+ * EVE_INT_CMDEMPTY, EVE_INT_CMDFLAG or EVE_INT_CONVCOMPLETE
+ * @param p_callback - the function to call, NULL to remove the callback and to disable the interrupt
+ * @note - Meant to be called after EVE_init() and outside display-list building, this writes to EVE.
+ * @note - The flags in REG_INT_FLAGS are set regardless of REG_INT_MASK, a flag that was set before
+ * may trigger the interrupt right away.
+ * @note - EVE_cmd_interrupt() can be used to get an EVE_INT_CMDFLAG at a specific point of a command list.
+ */
+void EVE_int_set_callback(uint8_t int_flag, EVE_int_callback_t p_callback)
+{
+    uint8_t mask = 0U;
+
+    for (uint8_t index = 0U; index < 8U; index++)
+    {
+        if (int_flag == (uint8_t) (1U << index))
+        {
+            int_callbacks[index] = p_callback;
+        }
+
+        if (int_callbacks[index] != NULL)
+        {
+            mask |= (uint8_t) (1U << index);
+        }
+    }
+
+    EVE_memWrite8(REG_INT_MASK, mask);
+    EVE_memWrite8(REG_INT_EN, (0U != mask) ? 1U : 0U);
+}
+
+/**
+ * @brief To be called by the target for a falling edge on INT_N, usually from an external interrupt.
+ * @note - There is no SPI traffic in here so it can not interfere with a transfer that was interrupted,
+ * EVE_int_service() does the reading of REG_INT_FLAGS later on.
+ */
+void EVE_int_edge(void)
+{
+    *p_int_pending = 1U;
+}
+
+/**
+ * @brief Reads REG_INT_FLAGS once if EVE_int_edge() was called since the last time
+ * and calls the registered callbacks for the flags that are set.
+ * @return - the value of REG_INT_FLAGS, 0 if there was no interrupt and nothing was read
+ * @note - Meant to be called from the main loop instead of polling EVE_busy() or the touch registers,
+ * outside display-list building.
+ * @note - Reading REG_INT_FLAGS clears it and releases INT_N.
+ */
+uint8_t EVE_int_service(void)
+{
+    uint8_t flags = 0U;
+
+    if (0U != *p_int_pending)
+    {
+        *p_int_pending = 0U; /* cleared first, an edge during the read is not lost */
+        flags = EVE_memRead8(REG_INT_FLAGS);
+
+        for (uint8_t index = 0U; index < 8U; index++)
+        {
+            if ((0U != (flags & (uint8_t) (1U << index))) && (int_callbacks[index] != NULL))
+            {
+                int_callbacks[index](flags);
+            }
+        }
+    }
+    return (flags);
+}
+
+/* copy the state of the current EVE to its context */
+static void ctx_save(EVE_ctx_t *p_ctx)
+{
+    p_ctx->cmd_burst = cmd_burst;
+    p_ctx->fault_recovered = fault_recovered;
+    p_ctx->cmdb_space = cmdb_space;
+    p_ctx->burst_words = EVE_burst_words;
+
+    for (uint8_t index = 0U; index < 8U; index++)
+    {
+        p_ctx->int_callbacks[index] = int_callbacks[index];
+    }
+
+#if defined (EVE_SPI_CLOCK_MAX)
+    p_ctx->spi_clock = spi_clock;
+#endif
+
+#if defined (EVE_DL_BUDGET)
+    p_ctx->dl_estimate = dl_estimate;
+    p_ctx->dl_correction = dl_correction;
+    p_ctx->dl_limit = dl_limit;
+    p_ctx->dl_unit = dl_unit;
+    p_ctx->dl_warned = dl_warned;
+    p_ctx->p_dl_callback = p_dl_callback;
+    p_ctx->dl_stats = dl_stats;
+#endif
+
+#if defined (EVE_DMA)
+    p_ctx->p_dma_buffer = EVE_dma_buffer;
+    p_ctx->dma_buffer_index = EVE_dma_buffer_index;
+
+    for (uint8_t index = 0U; index < EVE_DMA_BUFFERS; index++)
+    {
+        p_ctx->dma_length[index] = dma_length[index];
+    }
+
+    p_ctx->dma_head = dma_head;
+    p_ctx->dma_tail = dma_tail;
+    p_ctx->dma_count = dma_count;
+    p_ctx->dma_active = dma_active;
+    p_ctx->dma_fifo_empty = dma_fifo_empty;
+    p_ctx->burst_segmented = burst_segmented;
+    p_ctx->frame_valid = frame_valid;
+    p_ctx->frame_hash = frame_hash;
+    p_ctx->frame_stats = frame_stats;
+#endif
+}
+
+/* make the state from the context the state of the current EVE */
+static void ctx_load(EVE_ctx_t *p_ctx)
+{
+    cmd_burst = p_ctx->cmd_burst;
+    fault_recovered = p_ctx->fault_recovered;
+    cmdb_space = p_ctx->cmdb_space;
+    EVE_burst_words = p_ctx->burst_words;
+    p_int_pending = &p_ctx->int_pending;
+
+    for (uint8_t index = 0U; index < 8U; index++)
+    {
+        int_callbacks[index] = p_ctx->int_callbacks[index];
+    }
+
+#if defined (EVE_SPI_CLOCK_MAX)
+    spi_clock = p_ctx->spi_clock;
+#endif
+
+#if defined (EVE_DL_BUDGET)
+    dl_estimate = p_ctx->dl_estimate;
+    dl_correction = p_ctx->dl_correction;
+    dl_limit = p_ctx->dl_limit;
+    dl_unit = p_ctx->dl_unit;
+    dl_warned = p_ctx->dl_warned;
+    p_dl_callback = p_ctx->p_dl_callback;
+    dl_stats = p_ctx->dl_stats;
+#endif
+
+#if defined (EVE_DMA)
+    p_dma_ring = p_ctx->p_dma_ring;
+    EVE_dma_buffer = p_ctx->p_dma_buffer;
+    EVE_dma_buffer_index = p_ctx->dma_buffer_index;
+
+    for (uint8_t index = 0U; index < EVE_DMA_BUFFERS; index++)
+    {
+        dma_length[index] = p_ctx->dma_length[index];
+    }
+
+    dma_head = p_ctx->dma_head;
+    dma_tail = p_ctx->dma_tail;
+    dma_count = p_ctx->dma_count;
+    dma_active = p_ctx->dma_active;
+    dma_fifo_empty = p_ctx->dma_fifo_empty;
+    burst_segmented = p_ctx->burst_segmented;
+    frame_valid = p_ctx->frame_valid;
+    frame_hash = p_ctx->frame_hash;
+    frame_stats = p_ctx->frame_stats;
+#endif
+}
+
+/**
+ * @brief Set up a context for one EVE when more than one EVE is connected.
+ * @param p_bus_select - function that is called by EVE_ctx_select() to switch chip-select, or the SPI,
+ * over to this EVE, or NULL
+ * @param p_ring - with EVE_DMA the DMA buffers for this EVE, EVE_DMA_RING_WORDS words,
+ * NULL to use the buffers in EVE_commands.c, which is only possible for one of the contexts, not used without EVE_DMA
+ * @note - There is no SPI traffic in here, EVE_init() needs to be called after EVE_ctx_select() for each EVE.
+ * @note - The context is zeroed like after a reset, the interrupt callbacks are not set.
+ */
+void EVE_ctx_init(EVE_ctx_t *p_ctx, void (*p_bus_select)(void), uint32_t *p_ring)
+{
+    if (p_ctx != NULL)
+    {
+        p_ctx->p_bus_select = p_bus_select;
+        p_ctx->int_pending = 0U;
+        p_ctx->cmd_burst = 0U;
+        p_ctx->fault_recovered = E_OK;
+        p_ctx->cmdb_space = 0U;
+        p_ctx->burst_words = 0U;
+
+        for (uint8_t index = 0U; index < 8U; index++)
+        {
+            p_ctx->int_callbacks[index] = NULL;
+        }
+
+#if defined (EVE_SPI_CLOCK_MAX)
+        p_ctx->spi_clock = EVE_SPI_CLOCK_INIT;
+#endif
+
+#if defined (EVE_DL_BUDGET)
+        p_ctx->dl_estimate = 0UL;
+        p_ctx->dl_correction = 0UL;
+        p_ctx->dl_limit = EVE_RAM_DL_SIZE;
+        p_ctx->dl_unit = 0U;
+        p_ctx->dl_warned = 0U;
+        p_ctx->p_dl_callback = NULL;
+        p_ctx->dl_stats.frames = 0UL;
+        p_ctx->dl_stats.estimate = 0UL;
+        p_ctx->dl_stats.measured = 0UL;
+        p_ctx->dl_stats.peak = 0UL;
+        p_ctx->dl_stats.warnings = 0UL;
+        p_ctx->dl_stats.over_limit = 0UL;
+#endif
+
+#if defined (EVE_DMA)
+        p_ctx->p_dma_ring = (NULL == p_ring) ? dma_ring_default : p_ring;
+        p_ctx->p_dma_buffer = p_ctx->p_dma_ring;
+        p_ctx->dma_buffer_index = 0U;
+
+        for (uint8_t index = 0U; index < EVE_DMA_BUFFERS; index++)
+        {
+            p_ctx->dma_length[index] = 0U;
+        }
+
+        p_ctx->dma_head = 0U;
+        p_ctx->dma_tail = 0U;
+        p_ctx->dma_count = 0U;
+        p_ctx->dma_active = 0U;
+        p_ctx->dma_fifo_empty = 1U;
+        p_ctx->burst_segmented = 0U;
+        p_ctx->frame_valid = 0U;
+        p_ctx->frame_hash = 0UL;
+        p_ctx->frame_stats.frames = 0UL;
+        p_ctx->frame_stats.skipped = 0UL;
+#else
+        (void) p_ring;
+#endif
+    }
+}
+
+/**
+ * @brief Make all following calls go to the EVE of this context.
+ * The state of the EVE that was selected before, like a burst that is being filled, queued DMA buffers
+ * and a recovered fault, is kept in its context until it is selected again.
+ * @note - With EVE_DMA this waits for a DMA transfer to finish as it uses chip-select of the last EVE,
+ * buffers that are queued are sent by EVE_busy() after the context was selected again.
+ * @note - With EVE_DMA a burst can be continued after switching back and forth,
+ * without EVE_DMA a burst keeps chip-select low and needs to be ended before switching.
+ * @note - All EVE share the parameters from EVE_config.h, the helpers in EVE_supplemental.c keep
+ * their state for one EVE only.
+ * @note - With EVE_SPI_CLOCK_MAX the SPI is set to the clock EVE_ramp_spi_clock() selected for this EVE.
+ * @note - There is no SPI traffic in here, besides what p_bus_select might do.
+ */
+void EVE_ctx_select(EVE_ctx_t *p_ctx)
+{
+    if ((p_ctx != NULL) && (p_ctx != p_ctx_current))
+    {
+#if defined (EVE_DMA)
+        while (0U != EVE_dma_busy)
+        {
+        }
+#endif
+
+        if (p_ctx_current != NULL)
+        {
+            ctx_save(p_ctx_current);
+        }
+
+        ctx_load(p_ctx);
+        p_ctx_current = p_ctx;
+
+        if (p_ctx->p_bus_select != NULL)
+        {
+            p_ctx->p_bus_select();
+        }
+
+#if defined (EVE_SPI_CLOCK_MAX)
+        spi_clock = spi_set_clock(spi_clock);
+#endif
+    }
+}
+
+/**
+ * @brief To be called by the target for a falling edge on INT_N of the EVE of this context,
+ * EVE_int_service() handles it when the context is selected.
+ */
+void EVE_ctx_int_edge(EVE_ctx_t *p_ctx)
+{
+    if (p_ctx != NULL)
+    {
+        p_ctx->int_pending = 1U;
+    }
+}
+
+#if defined (EVE_DL_BUDGET)
+
+static void dl_budget_bytes(uint32_t bytes)
+{
+    dl_estimate += bytes;
+
+    if ((0U == dl_warned) && ((dl_estimate + dl_correction) > dl_limit))
+    {
+        dl_warned = 1U;
+        dl_stats.warnings++;
+
+        if (p_dl_callback != NULL)
+        {
+            p_dl_callback(dl_estimate + dl_correction);
+        }
+    }
+}
+
+/* add the display-list bytes for a command to the estimate, the string of the command is added by private_string_write() */
+static void dl_budget_add(uint32_t command, uint32_t count)
+{
+    uint32_t bytes = 4UL; /* a display-list command */
+
+    dl_unit = 0U;
+
+    if (CMD_DLSTART == command)
+    {
+        dl_estimate = 0UL;
+        dl_warned = 0U;
+        bytes = 0UL;
+    }
+    else if (0xff000000UL == (command & 0xff000000UL)) /* a coprocessor command */
+    {
+        bytes = 0UL; /* commands that are not in the table do not add to the display list */
+
+        for (uint8_t index = 0U; index < (sizeof(dl_costs) / sizeof(dl_costs[0U])); index++)
+        {
+            if ((uint8_t) command == dl_costs[index].command)
+            {
+                bytes = dl_costs[index].bytes + (count * dl_costs[index].unit);
+                dl_unit = dl_costs[index].unit;
+            }
+        }
+    }
+    else
+    {
+    }
+
+    dl_budget_bytes(bytes);
+}
+
+/* add the display-list bytes for the string of the current command to the estimate */
+static void dl_budget_string(uint32_t length)
+{
+    dl_budget_bytes(length * dl_unit);
+}
+
+/**
+ * @brief Set the size the display list should stay below and the function that is called when the estimate goes over it.
+ * @param limit - bytes, 0 for EVE_RAM_DL_SIZE
+ * @param p_callback - called once per display list with the estimate when it goes over the limit, or NULL
+ * @note - The display-list bytes are estimated on the host for every command that is sent with the EVE_cmd_xxx()
+ * functions, from CMD_DLSTART on. Widgets like CMD_BUTTON, CMD_GAUGE or CMD_KEYS are estimated
+ * from a table and the length of their string or their number of ticks.
+ * @note - Commands that are added with EVE_cmd_words_burst(), like the words from EVE_cmd_stream or
+ * a batch from EVE_reg_batch_send(), are not estimated, EVE_dl_budget_check() adds what the estimate
+ * was too low to the display lists that follow.
+ * @note - The limit, the callback, the estimate and the numbers are kept for each EVE in its EVE_ctx_t.
+ * @note - The callback is called during display-list building, like from EVE_cmd_button_burst(), it should only set
+ * a flag for the application to leave out details, EVE_dl_budget_left() tells how much room there is left.
+ * @note - Only available with EVE_DL_BUDGET defined.
+ */
+void EVE_dl_budget_init(uint32_t limit, EVE_dl_budget_callback_t p_callback)
+{
+    dl_limit = (0UL != limit) ? limit : EVE_RAM_DL_SIZE;
+    p_dl_callback = p_callback;
+    dl_correction = 0UL;
+    dl_warned = 0U;
+}
+
+/**
+ * @brief Get the number of bytes that are estimated to be left below the limit for the display list that is being built.
+ * @return - bytes, 0 if the estimate already is over the limit
+ */
+uint32_t EVE_dl_budget_left(void)
+{
+    uint32_t used = dl_estimate + dl_correction;
+
+    return ((used < dl_limit) ? (dl_limit - used) : 0UL);
+}
+
+/**
+ * @brief Compare the estimate with REG_CMD_DL after the coprocessor built the display list.
+ * @return - E_OK - if the display list stayed below the limit
+ * @return - E_NOT_OK - if the display list went over the limit
+ * @note - Meant to be called after the CMD_SWAP was executed, like when EVE_busy() returned E_OK,
+ * and before the next CMD_DLSTART.
+ * @note - When the estimate was too low the difference is added to the estimates that follow,
+ * so for a display list that is much like the last one the callback is called in time.
+ * @note - A display list that overflowed RAM_DL makes the coprocessor fault, after the recovery by EVE_busy()
+ * REG_CMD_DL is 0, it is counted as over the limit when the estimate was over the limit and
+ * EVE_get_and_reset_fault_state() was not called yet.
+ */
+uint8_t EVE_dl_budget_check(void)
+{
+    uint8_t ret = E_OK;
+    uint32_t measured = EVE_memRead16(REG_CMD_DL);
+
+    dl_stats.frames++;
+    dl_stats.estimate = dl_estimate;
+    dl_stats.measured = measured;
+
+    if (measured > dl_stats.peak)
+    {
+        dl_stats.peak = measured;
+    }
+
+    if ((EVE_FAULT_RECOVERED == fault_recovered) && ((dl_estimate + dl_correction) > dl_limit))
+    {
+        /* the display list most likely overflowed RAM_DL, the fault recovery cleared REG_CMD_DL */
+        dl_stats.over_limit++;
+        ret = E_NOT_OK;
+    }
+    else
+    {
+        dl_correction = (measured > dl_estimate) ? (measured - dl_estimate) : 0UL;
+
+        if (measured > dl_limit)
+        {
+            dl_stats.over_limit++;
+            ret = E_NOT_OK;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Get the numbers from EVE_dl_budget_check().
+ * @param clear - the counters and the peak are reset if not zero
+ */
+void EVE_dl_budget_get_stats(EVE_dl_budget_stats_t *p_stats, uint8_t clear)
+{
+    if (p_stats != NULL)
+    {
+        *p_stats = dl_stats;
+    }
+
+    if (0U != clear)
+    {
+        dl_stats.frames = 0UL;
+        dl_stats.peak = 0UL;
+        dl_stats.warnings = 0UL;
+        dl_stats.over_limit = 0UL;
+    }
+}
+
+#else
+
+static inline void dl_budget_add(uint32_t command, uint32_t count)
+{
+    (void) command;
+    (void) count;
+}
+
+static inline void dl_budget_string(uint32_t length)
+{
+    (void) length;
+}
+
+#endif /* EVE_DL_BUDGET */
+
 /* begin a coprocessor command, this is used for non-display-list and non-burst-mode commands.*/
 static void eve_begin_cmd(uint32_t command)
 {
+    cmdb_space = 0U; /* the length of the command is not tracked */
     EVE_cs_set();
     spi_transmit((uint8_t) 0xB0U); /* high-byte of REG_CMDB_WRITE + MEM_WRITE */
     spi_transmit((uint8_t) 0x25U); /* middle-byte of REG_CMDB_WRITE */
@@ -462,10 +1219,14 @@ void private_block_write(const uint8_t *p_data, uint16_t len)
     padding = 4U - padding;         /* 4, 3, 2 or 1 */
     padding &= 3U;                  /* 3, 2 or 1 */
 
+#if defined (EVE_FLASH_NOT_MAPPED)
     for (uint16_t count = 0U; count < len; count++)
     {
         spi_transmit(fetch_flash_byte(&p_data[count]));
     }
+#else
+    spi_transmit_block(p_data, len);
+#endif
 
     while (padding > 0U)
     {
@@ -1263,28 +2024,383 @@ void EVE_cmd_track(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_
     spi_transmit((uint8_t) (hgt));
     spi_transmit((uint8_t) (hgt >> 8U));
 
-    spi_transmit((uint8_t) (tag));
-    spi_transmit((uint8_t) (tag >> 8U));
-    spi_transmit(0U);
-    spi_transmit(0U);
+    spi_transmit((uint8_t) (tag));
+    spi_transmit((uint8_t) (tag >> 8U));
+    spi_transmit(0U);
+    spi_transmit(0U);
+
+    EVE_cs_clear();
+    EVE_execute_cmd();
+}
+
+/**
+ * @brief Load the next frame of a video.
+ * @note - Meant to be called outside display-list building.
+ * @note - Includes executing the command and waiting for completion.
+ * @note - Does not support burst-mode.
+ */
+void EVE_cmd_videoframe(uint32_t dest, uint32_t result_ptr)
+{
+    eve_begin_cmd(CMD_VIDEOFRAME);
+    spi_transmit_32(dest);
+    spi_transmit_32(result_ptr);
+    EVE_cs_clear();
+    EVE_execute_cmd();
+}
+
+/* ##################################################################
+    non-blocking variants of long running commands
+#################################################################### */
+
+/* the states of an EVE_cmd_job_t */
+#define JOB_IDLE 0U /* finished or never started */
+#define JOB_WAIT 1U /* waiting for the CMD-FIFO to be empty to write the command */
+#define JOB_DATA 2U /* writing p_data to the CMD-FIFO as space becomes available */
+#define JOB_EXEC 3U /* waiting for the coprocessor to finish the command */
+
+/* fill in the job and make the first step */
+static uint8_t job_start(EVE_cmd_job_t *p_job, uint32_t command, uint8_t num_params, const uint8_t *p_data, uint32_t len)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if (p_job != NULL)
+    {
+        p_job->command = command;
+        p_job->num_params = num_params;
+        p_job->p_data = p_data;
+        p_job->length = (NULL == p_data) ? 0UL : len;
+        p_job->done = 0UL;
+        p_job->state = JOB_WAIT;
+        ret = EVE_cmd_poll(p_job);
+    }
+    return (ret);
+}
+
+/* write the next part of p_data to the CMD-FIFO, no more than there is room for */
+static void job_write_data(EVE_cmd_job_t *p_job)
+{
+    uint32_t block_len;
+
+    block_len = p_job->length - p_job->done;
+    if (block_len > cmdb_space)
+    {
+        block_len = cmdb_space; /* always a multiple of four, padding is only added to the last block */
+    }
+
+    EVE_cs_set();
+    spi_transmit((uint8_t) 0xB0U); /* high-byte of REG_CMDB_WRITE + MEM_WRITE */
+    spi_transmit((uint8_t) 0x25U); /* middle-byte of REG_CMDB_WRITE */
+    spi_transmit((uint8_t) 0x78U); /* low-byte of REG_CMDB_WRITE */
+    private_block_write(&p_job->p_data[p_job->done], (uint16_t) block_len);
+    EVE_cs_clear();
+    cmdb_space = 0U;
+    p_job->done += block_len;
+}
+
+/**
+ * @brief Advance a long running command that was started with one of the EVE_cmd_xxx_start() functions.
+ * Every call does at most one SPI transfer to the CMD-FIFO, either the command itself or as much of the
+ * data that follows the command as there is room for, and a couple of reads from REG_CMDB_SPACE.
+ * @return - EVE_IS_BUSY - if the command is not finished yet
+ * @return - E_OK - if the coprocessor finished the command
+ * @return - EVE_FAULT_RECOVERED - if the command resulted in a coprocessor fault, EVE_busy() executed the recovery
+ * @return - E_NOT_OK - if p_job is NULL
+ * @note - p_job->done and p_job->length show how much of the data was written to EVE so far.
+ * @note - The command is written when the CMD-FIFO is empty, any other command or display list has to wait
+ * until EVE_cmd_poll() returned something other than EVE_IS_BUSY.
+ */
+uint8_t EVE_cmd_poll(EVE_cmd_job_t *p_job)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if (p_job != NULL)
+    {
+        ret = EVE_IS_BUSY;
+
+        if (JOB_WAIT == p_job->state)
+        {
+            if (E_OK == EVE_busy())
+            {
+                eve_begin_cmd(p_job->command);
+                for (uint8_t index = 0U; index < p_job->num_params; index++)
+                {
+                    spi_transmit_32(p_job->params[index]);
+                }
+                EVE_cs_clear();
+                p_job->state = (p_job->done < p_job->length) ? JOB_DATA : JOB_EXEC;
+            }
+        }
+        else if (JOB_DATA == p_job->state)
+        {
+            uint8_t busy = EVE_busy();
+
+            if (EVE_FAULT_RECOVERED == busy)
+            {
+                p_job->state = JOB_IDLE;
+                ret = EVE_FAULT_RECOVERED;
+            }
+            else if ((E_OK == busy) || (EVE_FIFO_HALF_EMPTY == busy))
+            {
+                job_write_data(p_job);
+                if (p_job->done >= p_job->length)
+                {
+                    p_job->state = JOB_EXEC;
+                }
+            }
+            else
+            {
+                /* wait for more than 2048 bytes to be free in the CMD-FIFO */
+            }
+        }
+        else if (JOB_EXEC == p_job->state)
+        {
+            uint8_t busy = EVE_busy();
+
+            if ((E_OK == busy) || (EVE_FAULT_RECOVERED == busy))
+            {
+                p_job->state = JOB_IDLE;
+                ret = busy;
+            }
+        }
+        else
+        {
+            ret = E_OK;
+        }
+    }
+    return (ret);
+}
+
+#if EVE_GEN > 2
+
+/**
+ * @brief Start erasing the attached SPI flash storage, non-blocking variant of EVE_cmd_flasherase().
+ * @return - the result of the first EVE_cmd_poll(), E_NOT_OK if p_job is NULL
+ * @note - Call EVE_cmd_poll() with the same job until it returns something else than EVE_IS_BUSY.
+ */
+uint8_t EVE_cmd_flasherase_start(EVE_cmd_job_t *p_job)
+{
+    return (job_start(p_job, CMD_FLASHERASE, 0U, NULL, 0UL));
+}
+
+/**
+ * @brief Start writing "num" bytes from src in RAM_G to the attached SPI flash storage at address dest,
+ * non-blocking variant of EVE_cmd_flashupdate().
+ * @return - the result of the first EVE_cmd_poll(), E_NOT_OK if p_job is NULL
+ * @note - The alignment requirements of EVE_cmd_flashupdate() apply.
+ * @note - Call EVE_cmd_poll() with the same job until it returns something else than EVE_IS_BUSY.
+ */
+uint8_t EVE_cmd_flashupdate_start(EVE_cmd_job_t *p_job, uint32_t dest, uint32_t src, uint32_t num)
+{
+    if (p_job != NULL)
+    {
+        p_job->params[0U] = dest;
+        p_job->params[1U] = src;
+        p_job->params[2U] = num;
+    }
+    return (job_start(p_job, CMD_FLASHUPDATE, 3U, NULL, 0UL));
+}
+
+#endif /* EVE_GEN > 2 */
+
+/**
+ * @brief Start decompressing data into RAM_G, non-blocking variant of EVE_cmd_inflate().
+ * @return - the result of the first EVE_cmd_poll(), E_NOT_OK if p_job is NULL
+ * @note - The data must be correct and complete and it has to stay in place until the job is finished.
+ * @note - Call EVE_cmd_poll() with the same job until it returns something else than EVE_IS_BUSY.
+ */
+uint8_t EVE_cmd_inflate_start(EVE_cmd_job_t *p_job, uint32_t ptr, const uint8_t *p_data, uint32_t len)
+{
+    if (p_job != NULL)
+    {
+        p_job->params[0U] = ptr;
+    }
+    return (job_start(p_job, CMD_INFLATE, 1U, p_data, len));
+}
+
+/**
+ * @brief Start loading and decoding a JPEG/PNG image into RAM_G, non-blocking variant of EVE_cmd_loadimage().
+ * @return - the result of the first EVE_cmd_poll(), E_NOT_OK if p_job is NULL
+ * @note - The data has to stay in place until the job is finished.
+ * @note - Call EVE_cmd_poll() with the same job until it returns something else than EVE_IS_BUSY.
+ */
+uint8_t EVE_cmd_loadimage_start(EVE_cmd_job_t *p_job, uint32_t ptr, uint32_t options, const uint8_t *p_data, uint32_t len)
+{
+    const uint8_t *p_direct = p_data;
+
+    if (p_job != NULL)
+    {
+        p_job->params[0U] = ptr;
+        p_job->params[1U] = options;
+    }
+
+#if EVE_GEN > 2
+    if ((0UL != (options & EVE_OPT_MEDIAFIFO)) ||
+        (0UL != (options & EVE_OPT_FLASH))) /* the data comes by Media-FIFO or from Flash */
+#else
+    if (0UL != (options & EVE_OPT_MEDIAFIFO)) /* the data comes by Media-FIFO */
+#endif
+    {
+        p_direct = NULL;
+    }
+    return (job_start(p_job, CMD_LOADIMAGE, 2U, p_direct, len));
+}
+
+/**
+ * @brief Start copying a block of RAM_G, non-blocking variant of EVE_cmd_memcpy().
+ * @return - the result of the first EVE_cmd_poll(), E_NOT_OK if p_job is NULL
+ * @note - Call EVE_cmd_poll() with the same job until it returns something else than EVE_IS_BUSY.
+ */
+uint8_t EVE_cmd_memcpy_start(EVE_cmd_job_t *p_job, uint32_t dest, uint32_t src, uint32_t num)
+{
+    if (p_job != NULL)
+    {
+        p_job->params[0U] = dest;
+        p_job->params[1U] = src;
+        p_job->params[2U] = num;
+    }
+    return (job_start(p_job, CMD_MEMCPY, 3U, NULL, 0UL));
+}
+
+/* ##################################################################
+    streaming thru the media FIFO
+#################################################################### */
+
+/* write as much data to the media FIFO as there is room for, calls p_read when the host buffer is empty */
+static void media_fill(EVE_media_t *p_media, uint32_t fifo_read)
+{
+    uint32_t space;
+    uint32_t written = 0U;
+    uint8_t more = 1U;
+
+    /* four bytes are kept free as the media FIFO is empty when REG_MEDIAFIFO_READ equals REG_MEDIAFIFO_WRITE */
+    space = ((fifo_read + p_media->fifo_size) - p_media->write - 4U) % p_media->fifo_size;
+
+    while (0U != more)
+    {
+        if (p_media->buffer_pos < p_media->buffer_fill)
+        {
+            uint32_t block_len = p_media->buffer_fill - p_media->buffer_pos;
+
+            if (block_len > space)
+            {
+                block_len = space;
+            }
+            if (block_len > (p_media->fifo_size - p_media->write))
+            {
+                block_len = p_media->fifo_size - p_media->write; /* wrap-around */
+            }
+
+            if (0U == block_len)
+            {
+                more = 0U;
+            }
+            else
+            {
+                EVE_memWrite_sram_buffer(p_media->fifo_address + p_media->write, &p_media->p_buffer[p_media->buffer_pos], block_len);
+                p_media->buffer_pos += block_len;
+                p_media->write = (p_media->write + block_len) % p_media->fifo_size;
+                p_media->total += block_len;
+                space -= block_len;
+                written += block_len;
+            }
+        }
+        else if ((0U == p_media->end) && (0U != space))
+        {
+            p_media->buffer_pos = 0U;
+            p_media->buffer_fill = p_media->p_read(p_media->p_buffer, p_media->buffer_size);
+            if (p_media->buffer_fill > p_media->buffer_size)
+            {
+                p_media->buffer_fill = p_media->buffer_size;
+            }
+            if (0U == p_media->buffer_fill)
+            {
+                p_media->end = 1U;
+            }
+        }
+        else
+        {
+            more = 0U;
+        }
+    }
+
+    if (0U != written)
+    {
+        EVE_memWrite32(REG_MEDIAFIFO_WRITE, p_media->write);
+    }
+}
+
+/**
+ * @brief Set up a media FIFO in RAM_G and fill it with the first data from p_read.
+ * This is the first step for CMD_PLAYVIDEO and CMD_LOADIMAGE with EVE_OPT_MEDIAFIFO, send the command
+ * afterwards and call EVE_media_poll() until it returns something else than EVE_IS_BUSY.
+ * @return - E_OK - if the stream is set up
+ * @return - E_NOT_OK - if a pointer is NULL, if fifo_address or fifo_size are not a multiple of four
+ * or if fifo_size is too small
+ * @note - p_buffer is the only buffer on the host, a couple of kiB are enough, the media FIFO itself
+ * should be large enough to bridge the time between two calls of EVE_media_poll().
+ * @note - Executes CMD_MEDIAFIFO and waits for the completion, the CMD-FIFO has to be empty.
+ */
+uint8_t EVE_media_start(EVE_media_t *p_media, uint32_t fifo_address, uint32_t fifo_size,
+                        uint8_t *p_buffer, uint32_t buffer_size, EVE_media_read_t p_read)
+{
+    uint8_t ret = E_NOT_OK;
 
-    EVE_cs_clear();
-    EVE_execute_cmd();
+    if ((p_media != NULL) && (p_buffer != NULL) && (p_read != NULL) && (0U != buffer_size)
+        && (0U == (fifo_address & 3U)) && (0U == (fifo_size & 3U)) && (fifo_size > 4U))
+    {
+        p_media->p_read = p_read;
+        p_media->p_buffer = p_buffer;
+        p_media->buffer_size = buffer_size;
+        p_media->buffer_fill = 0U;
+        p_media->buffer_pos = 0U;
+        p_media->fifo_address = fifo_address;
+        p_media->fifo_size = fifo_size;
+        p_media->write = 0U;
+        p_media->total = 0U;
+        p_media->end = 0U;
+
+        EVE_cmd_mediafifo(fifo_address, fifo_size); /* sets REG_MEDIAFIFO_READ and REG_MEDIAFIFO_WRITE to 0 */
+        media_fill(p_media, 0U);
+        ret = E_OK;
+    }
+    return (ret);
 }
 
 /**
- * @brief Load the next frame of a video.
- * @note - Meant to be called outside display-list building.
- * @note - Includes executing the command and waiting for completion.
- * @note - Does not support burst-mode.
+ * @brief Keep the media FIFO topped up, to be called periodically after EVE_media_start() and the command
+ * that reads from the media FIFO.
+ * Every call reads REG_MEDIAFIFO_READ and REG_CMDB_SPACE, writes the free part of the media FIFO in
+ * one or two SPI transfers, depending on the wrap-around, and updates REG_MEDIAFIFO_WRITE.
+ * @return - EVE_IS_BUSY - if the command is still reading from the media FIFO
+ * @return - E_OK - if the coprocessor finished the command, data that was not used by it is discarded
+ * @return - EVE_FAULT_RECOVERED - if the data resulted in a coprocessor fault, EVE_busy() executed the recovery
+ * @return - E_NOT_OK - if p_media is NULL
+ * @note - This can be called from the main loop or from a timer interrupt, as long as nothing else
+ * uses the SPI at the same time, it is not allowed between EVE_start_cmd_burst() and EVE_end_cmd_burst().
+ * @note - p_read is called from EVE_media_poll() and within the same context.
+ * @note - The data has to be complete, when p_read runs out of data before the end of the image or video
+ * the coprocessor keeps waiting for more and EVE_media_poll() keeps returning EVE_IS_BUSY.
  */
-void EVE_cmd_videoframe(uint32_t dest, uint32_t result_ptr)
+uint8_t EVE_media_poll(EVE_media_t *p_media)
 {
-    eve_begin_cmd(CMD_VIDEOFRAME);
-    spi_transmit_32(dest);
-    spi_transmit_32(result_ptr);
-    EVE_cs_clear();
-    EVE_execute_cmd();
+    uint8_t ret = E_NOT_OK;
+
+    if (p_media != NULL)
+    {
+        ret = EVE_busy();
+
+        if ((E_OK == ret) || (EVE_FAULT_RECOVERED == ret))
+        {
+            p_media->end = 1U; /* the command is done, stop reading */
+            p_media->buffer_pos = p_media->buffer_fill;
+        }
+        else
+        {
+            media_fill(p_media, EVE_memRead32(REG_MEDIAFIFO_READ));
+            ret = EVE_IS_BUSY;
+        }
+    }
+    return (ret);
 }
 
 /* ##################################################################
@@ -1539,20 +2655,30 @@ static uint8_t wait_reset(void)
  */
 void EVE_write_display_parameters(void)
 {
+    /* the timing registers from REG_HCYCLE to REG_VSYNC1 are consecutive and written in one transfer */
+    static const uint32_t timing[10U] =
+    {
+        EVE_HCYCLE,  /* REG_HCYCLE: total number of clocks per line, incl front/back porch */
+        EVE_HOFFSET, /* REG_HOFFSET: start of active line */
+        EVE_HSIZE,   /* REG_HSIZE: active display width */
+        EVE_HSYNC0,  /* REG_HSYNC0: start of horizontal sync pulse */
+        EVE_HSYNC1,  /* REG_HSYNC1: end of horizontal sync pulse */
+        EVE_VCYCLE,  /* REG_VCYCLE: total number of lines per screen, including pre/post */
+        EVE_VOFFSET, /* REG_VOFFSET: start of active screen */
+        EVE_VSIZE,   /* REG_VSIZE: active display height */
+        EVE_VSYNC0,  /* REG_VSYNC0: start of vertical sync pulse */
+        EVE_VSYNC1   /* REG_VSYNC1: end of vertical sync pulse */
+    };
+    static const uint32_t output[3U] =
+    {
+        EVE_SWIZZLE, /* REG_SWIZZLE: FT8xx output to LCD - pin order */
+        EVE_CSPREAD, /* REG_CSPREAD: helps with noise, when set to 1 fewer signals are changed simultaneously, reset-default: 1 */
+        EVE_PCLKPOL  /* REG_PCLK_POL: LCD data is clocked in on this PCLK edge */
+    };
+
     /* Initialize Display */
-    EVE_memWrite16(REG_HSIZE, EVE_HSIZE);     /* active display width */
-    EVE_memWrite16(REG_HCYCLE, EVE_HCYCLE);   /* total number of clocks per line, incl front/back porch */
-    EVE_memWrite16(REG_HOFFSET, EVE_HOFFSET); /* start of active line */
-    EVE_memWrite16(REG_HSYNC0, EVE_HSYNC0);   /* start of horizontal sync pulse */
-    EVE_memWrite16(REG_HSYNC1, EVE_HSYNC1);   /* end of horizontal sync pulse */
-    EVE_memWrite16(REG_VSIZE, EVE_VSIZE);     /* active display height */
-    EVE_memWrite16(REG_VCYCLE, EVE_VCYCLE);   /* total number of lines per screen, including pre/post */
-    EVE_memWrite16(REG_VOFFSET, EVE_VOFFSET); /* start of active screen */
-    EVE_memWrite16(REG_VSYNC0, EVE_VSYNC0);   /* start of vertical sync pulse */
-    EVE_memWrite16(REG_VSYNC1, EVE_VSYNC1);   /* end of vertical sync pulse */
-    EVE_memWrite8(REG_SWIZZLE, EVE_SWIZZLE);  /* FT8xx output to LCD - pin order */
-    EVE_memWrite8(REG_PCLK_POL, EVE_PCLKPOL); /* LCD data is clocked in on this PCLK edge */
-    EVE_memWrite8(REG_CSPREAD, EVE_CSPREAD);  /* helps with noise, when set to 1 fewer signals are changed simultaneously, reset-default: 1 */
+    EVE_memWrite_regs(REG_HCYCLE, timing, 10U);
+    EVE_memWrite_regs(REG_SWIZZLE, output, 3U);
 
     /* configure Touch */
     EVE_memWrite8(REG_TOUCH_MODE, EVE_TMODE_CONTINUOUS); /* enable touch */
@@ -1595,11 +2721,32 @@ static void enable_pixel_clock(void)
  * @note - needs a set of calibration values for the selected rotation since this rotates before calibration!
  * @note - EVE_BACKLIGHT_FREQ - configure the backlight frequency, default is not writing it which results in 250Hz.
  * @note - EVE_BACKLIGHT_PWM - configure the backlight pwm, defaults to 0x20 / 25%.
+ * @note - EVE_SPI_CLOCK_MAX - raise the SPI clock at the end with EVE_ramp_spi_clock(), the target needs spi_set_clock().
  */
 uint8_t EVE_init(void)
 {
+    static const uint32_t audio[3U] =
+    {
+        0U,      /* REG_VOL_PB: turn recorded audio volume down, reset-default is 0xff */
+        0U,      /* REG_VOL_SOUND: turn synthesizer volume down, reset-default is 0xff */
+        EVE_MUTE /* REG_SOUND: set synthesizer to mute */
+    };
+    static const uint32_t basic_dl[3U] =
+    {
+        DL_CLEAR_COLOR_RGB,
+        (DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG),
+        DL_DISPLAY /* end of display list */
+    };
     uint8_t ret;
 
+#if EVE_SPI_WIDTH_MAX > 1
+    spi_set_width(1U); /* EVE comes out of reset with single SPI */
+#endif
+
+#if defined (EVE_SPI_CLOCK_MAX)
+    spi_clock = spi_set_clock(EVE_SPI_CLOCK_INIT);
+#endif
+
     EVE_pdn_set();
     DELAY_MS(6U); /* minimum time for power-down is 5ms */
     EVE_pdn_clear();
@@ -1647,14 +2794,10 @@ uint8_t EVE_init(void)
             EVE_write_display_parameters();
 
             /* disable Audio for now */
-            EVE_memWrite8(REG_VOL_PB, 0U);      /* turn recorded audio volume down, reset-default is 0xff */
-            EVE_memWrite8(REG_VOL_SOUND, 0U);   /* turn synthesizer volume down, reset-default is 0xff */
-            EVE_memWrite16(REG_SOUND, EVE_MUTE); /* set synthesizer to mute */
+            EVE_memWrite_regs(REG_VOL_PB, audio, 3U); /* REG_VOL_PB, REG_VOL_SOUND and REG_SOUND */
 
             /* write a basic display-list to get things started */
-            EVE_memWrite32(EVE_RAM_DL, DL_CLEAR_COLOR_RGB);
-            EVE_memWrite32(EVE_RAM_DL + 4U, (DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG));
-            EVE_memWrite32(EVE_RAM_DL + 8U, DL_DISPLAY); /* end of display list */
+            EVE_memWrite_regs(EVE_RAM_DL, basic_dl, 3U);
             EVE_memWrite32(REG_DLSWAP, EVE_DLSWAP_FRAME);
             /* nothing is being displayed yet... the pixel clock is still 0x00 */
 
@@ -1680,7 +2823,12 @@ uint8_t EVE_init(void)
             DELAY_MS(1U);
             EVE_execute_cmd(); /* just to be safe, wait for EVE to not be busy */
 
+#if defined (EVE_SPI_CLOCK_MAX)
+            (void) EVE_ramp_spi_clock();
+#endif
+
 #if defined (EVE_DMA)
+            dma_ring_reset();
             EVE_init_dma(); /* prepare DMA */
 #endif
         }
@@ -1689,55 +2837,396 @@ uint8_t EVE_init(void)
     return (ret);
 }
 
-/* ##################################################################
-    functions for display lists
-##################################################################### */
+/**
+ * @brief Switch EVE and the SPI of the host to 1, 2 or 4 data lines.
+ * @param width - the number of data lines, 1U for single, 2U for dual and 4U for quad SPI
+ * @return - E_OK - if the SPI is using width data lines now
+ * @return - E_NOT_OK - if width is not 1U, 2U or 4U or not supported by the target, see EVE_SPI_WIDTH_MAX
+ * @note - Meant to be called after EVE_init() and outside display-list building,
+ * this waits for the CMD-FIFO to be empty and for the DMA to be finished first.
+ * @note - REG_SPI_WIDTH changes the width for the next transfer, the transfer that writes it still uses the old width.
+ * @note - The extra dummy clock cycle of bit 2 in REG_SPI_WIDTH is not used.
+ * @note - EVE_init() resets the host to single SPI as EVE comes out of reset with single SPI.
+ */
+uint8_t EVE_set_spi_width(uint8_t width)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if (((1U == width) || (2U == width) || (4U == width)) && (width <= EVE_SPI_WIDTH_MAX))
+    {
+        EVE_execute_cmd();
+        EVE_memWrite8(REG_SPI_WIDTH, width >> 1U); /* 0 = single, 1 = dual, 2 = quad */
+#if EVE_SPI_WIDTH_MAX > 1
+        spi_set_width(width);
+#endif
+        ret = E_OK;
+    }
+
+    return (ret);
+}
+
+#if defined (EVE_SPI_CLOCK_MAX)
+/* fill in the test pattern for seed, every other byte is inverted so that all the bits toggle */
+static void spi_clock_pattern(uint8_t *p_pattern, uint8_t seed)
+{
+    for (uint8_t count = 0U; count < SPI_CLOCK_TEST_SIZE; count++)
+    {
+        uint8_t value = (uint8_t) ((count * 37U) + seed);
+
+        if (0U != (count & 1U))
+        {
+            value = (uint8_t) ~value;
+        }
+        p_pattern[count] = value;
+    }
+}
+
+static void spi_clock_write(uint8_t seed)
+{
+    uint8_t pattern[SPI_CLOCK_TEST_SIZE];
+
+    spi_clock_pattern(pattern, seed);
+    EVE_memWrite_sram_buffer(EVE_RAM_G, pattern, SPI_CLOCK_TEST_SIZE);
+}
+
+/* read back the test pattern from RAM_G, E_OK if it is the one for seed */
+static uint8_t spi_clock_verify(uint8_t seed)
+{
+    uint8_t pattern[SPI_CLOCK_TEST_SIZE];
+    uint8_t readback[SPI_CLOCK_TEST_SIZE];
+    uint8_t ret = E_OK;
+
+    spi_clock_pattern(pattern, seed);
+    EVE_memRead_sram_buffer(EVE_RAM_G, readback, SPI_CLOCK_TEST_SIZE);
+
+    for (uint8_t count = 0U; count < SPI_CLOCK_TEST_SIZE; count++)
+    {
+        if (pattern[count] != readback[count])
+        {
+            ret = E_NOT_OK;
+        }
+    }
+
+    return (ret);
+}
 
 /**
- * @brief Begin a sequence of commands or prepare a DMA transfer if applicable.
- * @note - Needs to be used with EVE_end_cmd_burst().
- * @note - Do not use any functions in the sequence that do not address the command-fifo as for example any of EVE_mem...() functions.
- * @note - Do not use any of the functions that do not support burst-mode.
+ * @brief Raises the SPI clock in steps of EVE_SPI_CLOCK_STEP from EVE_SPI_CLOCK_INIT up to EVE_SPI_CLOCK_MAX
+ * and keeps the fastest clock that a test pattern in RAM_G could be written and read back with.
+ * @return the SPI clock in Hz that is used now, as returned by spi_set_clock()
+ * @note - Called by EVE_init() with EVE_SPI_CLOCK_MAX defined, can be called again outside display-list building
+ * after EVE_busy() returned E_OK, e.g. when the temperature changed.
+ * @note - The ramp stops at the first step that fails, the clock goes back to the last step that worked.
+ * @note - Each step first reads back the pattern that was written with a working clock before it writes
+ * new patterns as a header that is damaged on the way could make EVE write somewhere else.
+ * @note - This overwrites the first 64 bytes of RAM_G, these are zero afterwards.
  */
-void EVE_start_cmd_burst(void)
+uint32_t EVE_ramp_spi_clock(void)
 {
-#if defined (EVE_DMA)
-    if (EVE_dma_busy)
+    static const uint8_t zero[SPI_CLOCK_TEST_SIZE] = {0U};
+    uint32_t good;
+    uint32_t request = EVE_SPI_CLOCK_INIT;
+    uint32_t clock;
+    uint8_t seed = 0U;
+    uint8_t status;
+
+    good = spi_set_clock(EVE_SPI_CLOCK_INIT);
+    spi_clock_write(seed);
+    status = spi_clock_verify(seed);
+
+    while ((E_OK == status) && (request < EVE_SPI_CLOCK_MAX))
     {
-        EVE_execute_cmd(); /* this is a safe-guard to protect segmented display-list building with DMA from overlapping */
+        request += EVE_SPI_CLOCK_STEP;
+        if (request > EVE_SPI_CLOCK_MAX)
+        {
+            request = EVE_SPI_CLOCK_MAX;
+        }
+
+        clock = spi_set_clock(request);
+        if (clock > good) /* the SPI may only be able to do some of the steps */
+        {
+            status = spi_clock_verify(seed);
+
+            for (uint8_t round = 0U; (round < SPI_CLOCK_TEST_ROUNDS) && (E_OK == status); round++)
+            {
+                seed++;
+                spi_clock_write(seed);
+                status = spi_clock_verify(seed);
+            }
+
+            if (E_OK == status)
+            {
+                good = clock;
+            }
+        }
     }
-#endif
 
-    cmd_burst = 42U;
+    spi_clock = spi_set_clock(good);
+    EVE_memWrite_sram_buffer(EVE_RAM_G, zero, SPI_CLOCK_TEST_SIZE);
+    return (spi_clock);
+}
+
+/**
+ * @brief Get the SPI clock in Hz that EVE_init() or EVE_ramp_spi_clock() selected.
+ */
+uint32_t EVE_get_spi_clock(void)
+{
+    return (spi_clock);
+}
+#endif /* EVE_SPI_CLOCK_MAX */
+
+/* ##################################################################
+    functions for display lists
+##################################################################### */
 
 #if defined (EVE_DMA)
+/* wait for a free buffer and prepare it for a burst */
+static void burst_begin(void)
+{
+    dma_ring_release();
+
+    while (dma_count >= EVE_DMA_BUFFERS) /* no free buffer, wait for the oldest one to be sent */
+    {
+        (void) EVE_busy();
+    }
+
     EVE_dma_buffer[0U] = 0x7825B000UL; /* REG_CMDB_WRITE + MEM_WRITE low mid hi 00 */
 //    ((uint8_t) (ft_address >> 16U) | MEM_WRITE) | (ft_address & 0x0000ff00UL) | ((uint8_t) (ft_address) << 16U);
 //    EVE_dma_buffer[0U] = EVE_dma_buffer[0U] << 8U;
     EVE_dma_buffer_index = 1U;
+}
+
+/* queue the buffer that was just filled and send it if nothing is in the way */
+static void burst_end(void)
+{
+    dma_ring_release();
+    dma_length[dma_head] = EVE_dma_buffer_index;
+    dma_head = (uint8_t) ((dma_head + 1U) % EVE_DMA_BUFFERS);
+    dma_count++;
+    EVE_dma_buffer = &p_dma_ring[dma_head * 1025U];
+
+    if ((1U == dma_count) && (0U != dma_fifo_empty))
+    {
+        dma_ring_start(); /* begin DMA transfer */
+    }
+    else
+    {
+        (void) EVE_busy(); /* begin DMA transfer if the CMD-FIFO has room for it */
+    }
+}
 #else
+/* wait for the co-processor to free up more than half of the CMD-FIFO */
+static void burst_wait(void)
+{
+    while (cmdb_space <= 0x800U)
+    {
+        (void) EVE_busy();
+    }
+}
+
+static void burst_begin(void)
+{
     EVE_cs_set();
     spi_transmit((uint8_t) 0xB0U); /* high-byte of REG_CMDB_WRITE + MEM_WRITE */
     spi_transmit((uint8_t) 0x25U); /* middle-byte of REG_CMDB_WRITE */
     spi_transmit((uint8_t) 0x78U); /* low-byte of REG_CMDB_WRITE */
+}
+#endif
+
+/**
+ * @brief Begin a sequence of commands or prepare a DMA transfer if applicable.
+ * @note - Needs to be used with EVE_end_cmd_burst().
+ * @note - Do not use any functions in the sequence that do not address the command-fifo as for example any of EVE_mem...() functions.
+ * @note - Do not use any of the functions that do not support burst-mode.
+ * @note - With EVE_DMA this only waits if all EVE_DMA_BUFFERS buffers are queued or in transfer.
+ * @note - Without EVE_DMA this reads REG_CMDB_SPACE first if the free space in the CMD-FIFO is not known
+ * from EVE_busy() as the burst is split into segments that fit.
+ */
+void EVE_start_cmd_burst(void)
+{
+    cmd_burst = 42U;
+
+#if defined (EVE_DMA)
+    burst_segmented = 0U;
+    burst_begin();
+    EVE_burst_words = 1023U; /* 4092 bytes, the buffer has one more entry for the address */
+#else
+    if (cmdb_space < 4U)
+    {
+        burst_wait();
+    }
+    EVE_burst_words = cmdb_space / 4U;
+    burst_begin();
 #endif
 }
 
 /**
  * @brief End a sequence of commands or trigger a prepared DMA transfer if applicable.
  * @note - Needs to be used with EVE_start_cmd_burst().
+ * @note - With EVE_DMA the buffer is queued if the DMA is still busy with a previous buffer
+ * or if the CMD-FIFO could still be executing a previous buffer, EVE_busy() starts the transfer later on.
  */
 void EVE_end_cmd_burst(void)
 {
     cmd_burst = 0U;
 
 #if defined (EVE_DMA)
-    EVE_start_dma_transfer(); /* begin DMA transfer */
+    burst_end();
+#else
+    EVE_cs_clear();
+    cmdb_space = (uint16_t) (EVE_burst_words * 4U);
+#endif
+    EVE_burst_words = 0U;
+}
+
+/**
+ * @brief Helper function, called by spi_transmit_burst() when the current segment of a burst is full.
+ * @note - With EVE_DMA the buffer is queued like by EVE_end_cmd_burst() and the burst continues in the next free buffer.
+ * @note - Without EVE_DMA chip-select is released and REG_CMDB_SPACE is polled until more than half
+ * of the CMD-FIFO is free before the burst continues.
+ * @note - The segments after the first one are limited to half of the CMD-FIFO as a command that
+ * is cut in two can hold back the co-processor from freeing up all of the CMD-FIFO.
+ */
+void EVE_burst_segment(void)
+{
+#if defined (EVE_DMA)
+    burst_segmented = 1U;
+    burst_end();
+    burst_begin();
+    EVE_burst_words = BURST_SEGMENT_WORDS;
 #else
     EVE_cs_clear();
+    cmdb_space = 0U; /* the segment used up all of the space that was known to be free */
+    burst_wait();
+    EVE_burst_words = cmdb_space / 4U;
+    burst_begin();
+#endif
+}
+
+/**
+ * @brief Add a block of commands that already are encoded into 32 bit words to a burst,
+ * like the words from the C++ EVE_cmd_stream class in EVE_cmd_stream.h.
+ * @note - Needs to be called between EVE_start_cmd_burst() and EVE_end_cmd_burst().
+ * @note - The block is split into segments like every other burst.
+ * @note - With EVE_DMA the words are copied into the DMA buffer in one loop per segment.
+ * @note - With EVE_DL_BUDGET defined the words do not add to the display-list estimate.
+ */
+void EVE_cmd_words_burst(const uint32_t *p_words, uint32_t count)
+{
+    uint32_t done = 0UL;
+
+    if (p_words != NULL)
+    {
+        while (done < count)
+        {
+            uint32_t block;
+
+            if (0U == EVE_burst_words) /* the DMA buffer or the CMD-FIFO is full */
+            {
+                EVE_burst_segment();
+            }
+
+            block = count - done;
+            if (block > EVE_burst_words)
+            {
+                block = EVE_burst_words;
+            }
+
+            for (uint32_t index = 0UL; index < block; index++)
+            {
+#if defined (EVE_DMA)
+                EVE_dma_buffer[EVE_dma_buffer_index++] = p_words[done + index];
+#else
+                spi_transmit_32(p_words[done + index]);
 #endif
+            }
+
+            EVE_burst_words -= (uint16_t) block;
+            done += block;
+        }
+    }
+}
+
+#if defined (EVE_DMA)
+
+/**
+ * @brief Begin a frame, this is EVE_start_cmd_burst() with EVE_frame_end() to finish it.
+ * @note - The frame is everything from CMD_DLSTART to CMD_SWAP.
+ */
+void EVE_frame_start(void)
+{
+    EVE_start_cmd_burst();
 }
 
+/**
+ * @brief End a frame that was started with EVE_frame_start().
+ * The frame is sent like with EVE_end_cmd_burst() unless it is identical to the last frame that was sent,
+ * the display list from the last frame is still on screen then and there is no transfer and no CMD_SWAP.
+ * @return - E_OK - if the frame was sent
+ * @return - EVE_FRAME_SKIPPED - if the frame was identical to the last one
+ * @note - Frames are compared by a 32 bit FNV-1a hash over the words in the DMA buffer.
+ * @note - A frame that does not fit in one DMA buffer is always sent as the first segments are already queued.
+ * @note - Call EVE_frame_invalidate() when the result would change with the same commands, like when data
+ * that is copied into the display list by CMD_APPEND changed.
+ */
+uint8_t EVE_frame_end(void)
+{
+    uint8_t ret = E_OK;
+    uint32_t hash = 2166136261UL;
+    const uint8_t *p_bytes = (const uint8_t *) &EVE_dma_buffer[1U];
+
+    for (uint32_t index = 0U; index < ((EVE_dma_buffer_index - 1UL) * 4UL); index++)
+    {
+        hash ^= p_bytes[index];
+        hash *= 16777619UL;
+    }
+
+    frame_stats.frames++;
+
+    if ((0U != frame_valid) && (0U == burst_segmented) && (hash == frame_hash))
+    {
+        cmd_burst = 0U;
+        EVE_burst_words = 0U; /* the buffer is not queued, the next burst uses it again */
+        frame_stats.skipped++;
+        ret = EVE_FRAME_SKIPPED;
+    }
+    else
+    {
+        frame_valid = (0U == burst_segmented) ? 1U : 0U;
+        frame_hash = hash;
+        EVE_end_cmd_burst();
+    }
+    return (ret);
+}
+
+/**
+ * @brief Make EVE_frame_end() send the next frame, even if it is identical to the last one.
+ */
+void EVE_frame_invalidate(void)
+{
+    frame_valid = 0U;
+}
+
+/**
+ * @brief Get the number of frames and the number of skipped frames, the skip rate is skipped / frames.
+ * @param clear - the counters are reset if not zero
+ */
+void EVE_frame_get_stats(EVE_frame_stats_t *p_stats, uint8_t clear)
+{
+    if (p_stats != NULL)
+    {
+        *p_stats = frame_stats;
+    }
+
+    if (0U != clear)
+    {
+        frame_stats.frames = 0UL;
+        frame_stats.skipped = 0UL;
+    }
+}
+
+#endif /* EVE_DMA */
+
 /* write a string to coprocessor memory in context of a command: */
 /* no chip-select, just plain SPI-transfers */
 static void private_string_write(const char *p_text)
@@ -1756,6 +3245,7 @@ static void private_string_write(const char *p_text)
             spi_transmit(p_bytes[textindex]);
             textindex++;
         }
+        dl_budget_string(textindex);
 
         /* transmit at least one 0x00 byte */
         /* and up to four if the string happens to be 4-byte aligned already */
@@ -1783,6 +3273,7 @@ static void private_string_write(const char *p_text)
                 if (0U == data)
                 {
                     spi_transmit_burst(calc);
+                    dl_budget_string((uint32_t) textindex + index);
                     return; /* MISRA 2012 rule 15.5 (advisory) violation */
                 }
 
@@ -1793,6 +3284,7 @@ static void private_string_write(const char *p_text)
         }
 
         spi_transmit_burst(0U); /* executed when the line is too long */
+        dl_budget_string(252UL);
     }
 }
 
@@ -1804,6 +3296,8 @@ static void private_string_write(const char *p_text)
  */
 void EVE_cmd_animframeram(int16_t xc0, int16_t yc0, uint32_t aoptr, uint32_t frame)
 {
+    dl_budget_add(CMD_ANIMFRAMERAM, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_ANIMFRAMERAM);
@@ -1830,6 +3324,7 @@ void EVE_cmd_animframeram(int16_t xc0, int16_t yc0, uint32_t aoptr, uint32_t fra
 void EVE_cmd_animframeram_burst(int16_t xc0, int16_t yc0, uint32_t aoptr,
                                 uint32_t frame)
 {
+    dl_budget_add(CMD_ANIMFRAMERAM, 0UL);
     spi_transmit_burst(CMD_ANIMFRAMERAM);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(aoptr);
@@ -1913,6 +3408,7 @@ void EVE_cmd_calibratesub(uint16_t xc0, uint16_t yc0, uint16_t width, uint16_t h
         spi_transmit((uint8_t) (width >> 8U));
         spi_transmit((uint8_t) (height));
         spi_transmit((uint8_t) (height >> 8U));
+        spi_transmit_32(0UL);
         EVE_cs_clear();
     }
 }
@@ -1922,6 +3418,8 @@ void EVE_cmd_calibratesub(uint16_t xc0, uint16_t yc0, uint16_t width, uint16_t h
  */
 void EVE_cmd_calllist(uint32_t adr)
 {
+    dl_budget_add(CMD_CALLLIST, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_CALLLIST);
@@ -1940,6 +3438,7 @@ void EVE_cmd_calllist(uint32_t adr)
  */
 void EVE_cmd_calllist_burst(uint32_t adr)
 {
+    dl_budget_add(CMD_CALLLIST, 0UL);
     spi_transmit_burst(CMD_CALLLIST);
     spi_transmit_burst(adr);
 }
@@ -2025,6 +3524,8 @@ void EVE_cmd_animdraw_burst(int32_t chnl)
  */
 void EVE_cmd_animframe(int16_t xc0, int16_t yc0, uint32_t aoptr, uint32_t frame)
 {
+    dl_budget_add(CMD_ANIMFRAME, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_ANIMFRAME);
@@ -2051,6 +3552,7 @@ void EVE_cmd_animframe(int16_t xc0, int16_t yc0, uint32_t aoptr, uint32_t frame)
 void EVE_cmd_animframe_burst(int16_t xc0, int16_t yc0, uint32_t aoptr,
                                 uint32_t frame)
 {
+    dl_budget_add(CMD_ANIMFRAME, 0UL);
     spi_transmit_burst(CMD_ANIMFRAME);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(aoptr);
@@ -2155,6 +3657,8 @@ void EVE_cmd_animxy_burst(int32_t chnl, int16_t xc0, int16_t yc0)
  */
 void EVE_cmd_appendf(uint32_t ptr, uint32_t num)
 {
+    dl_budget_add(CMD_APPENDF, num);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_APPENDF);
@@ -2175,6 +3679,7 @@ void EVE_cmd_appendf(uint32_t ptr, uint32_t num)
  */
 void EVE_cmd_appendf_burst(uint32_t ptr, uint32_t num)
 {
+    dl_budget_add(CMD_APPENDF, num);
     spi_transmit_burst(CMD_APPENDF);
     spi_transmit_burst(ptr);
     spi_transmit_burst(num);
@@ -2190,6 +3695,8 @@ uint16_t EVE_cmd_bitmap_transform(int32_t xc0, int32_t yc0, int32_t xc1,
 {
     uint16_t ret_val = 0U;
 
+    dl_budget_add(CMD_BITMAP_TRANSFORM, 0UL);
+
     if (0U == cmd_burst)
     {
         uint16_t cmdoffset;
@@ -2244,6 +3751,7 @@ void EVE_cmd_bitmap_transform_burst(int32_t xc0, int32_t yc0, int32_t xc1,
                                 int32_t tx0, int32_t ty0, int32_t tx1,
                                 int32_t ty1, int32_t tx2, int32_t ty2)
 {
+    dl_budget_add(CMD_BITMAP_TRANSFORM, 0UL);
     spi_transmit_burst(CMD_BITMAP_TRANSFORM);
     spi_transmit_burst((uint32_t) xc0);
     spi_transmit_burst((uint32_t) yc0);
@@ -2293,6 +3801,8 @@ void EVE_cmd_fillwidth_burst(uint32_t pixel)
  */
 void EVE_cmd_gradienta(int16_t xc0, int16_t yc0, uint32_t argb0, int16_t xc1, int16_t yc1, uint32_t argb1)
 {
+    dl_budget_add(CMD_GRADIENTA, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_GRADIENTA);
@@ -2323,6 +3833,7 @@ void EVE_cmd_gradienta(int16_t xc0, int16_t yc0, uint32_t argb0, int16_t xc1, in
  */
 void EVE_cmd_gradienta_burst(int16_t xc0, int16_t yc0, uint32_t argb0, int16_t xc1, int16_t yc1, uint32_t argb1)
 {
+    dl_budget_add(CMD_GRADIENTA, 0UL);
     spi_transmit_burst(CMD_GRADIENTA);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(argb0);
@@ -2376,6 +3887,8 @@ void EVE_cmd_button_var(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                         uint16_t font, uint16_t options, const char *p_text,
                         uint8_t num_args, const uint32_t p_arguments[])
 {
+    dl_budget_add(CMD_BUTTON, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_BUTTON);
@@ -2435,6 +3948,7 @@ void EVE_cmd_button_var_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t h
                               uint16_t font, uint16_t options, const char *p_text,
                               uint8_t num_args, const uint32_t p_arguments[])
 {
+    dl_budget_add(CMD_BUTTON, 0UL);
     spi_transmit_burst(CMD_BUTTON);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) wid) + ((uint32_t) hgt << 16U));
@@ -2462,6 +3976,8 @@ void EVE_cmd_text_var(int16_t xc0, int16_t yc0, uint16_t font,
                         uint16_t options, const char *p_text,
                         uint8_t num_args, const uint32_t p_arguments[])
 {
+    dl_budget_add(CMD_TEXT, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_TEXT);
@@ -2516,6 +4032,7 @@ void EVE_cmd_text_var_burst(int16_t xc0, int16_t yc0, uint16_t font,
                             uint16_t options, const char *p_text,
                             uint8_t num_args, const uint32_t p_arguments[])
 {
+    dl_budget_add(CMD_TEXT, 0UL);
     spi_transmit_burst(CMD_TEXT);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) font) + (((uint32_t) options) << 16U));
@@ -2542,6 +4059,8 @@ void EVE_cmd_toggle_var(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t font,
                         uint16_t options, uint16_t state, const char *p_text,
                         uint8_t num_args, const uint32_t p_arguments[])
 {
+    dl_budget_add(CMD_TOGGLE, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_TOGGLE);
@@ -2601,6 +4120,7 @@ void EVE_cmd_toggle_var_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t f
                             uint16_t options, uint16_t state, const char *p_text,
                             uint8_t num_args, const uint32_t p_arguments[])
 {
+    dl_budget_add(CMD_TOGGLE, 0UL);
     spi_transmit_burst(CMD_TOGGLE);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) wid) + (((uint32_t) font) << 16U));
@@ -2631,6 +4151,8 @@ void EVE_cmd_toggle_var_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t f
  */
 void EVE_cmd_dl(uint32_t command)
 {
+    dl_budget_add(command, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(command);
@@ -2647,6 +4169,7 @@ void EVE_cmd_dl(uint32_t command)
  */
 void EVE_cmd_dl_burst(uint32_t command)
 {
+    dl_budget_add(command, 0UL);
     spi_transmit_burst(command);
 }
 
@@ -2655,6 +4178,8 @@ void EVE_cmd_dl_burst(uint32_t command)
  */
 void EVE_cmd_append(uint32_t ptr, uint32_t num)
 {
+    dl_budget_add(CMD_APPEND, num);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_APPEND);
@@ -2675,6 +4200,7 @@ void EVE_cmd_append(uint32_t ptr, uint32_t num)
  */
 void EVE_cmd_append_burst(uint32_t ptr, uint32_t num)
 {
+    dl_budget_add(CMD_APPEND, num);
     spi_transmit_burst(CMD_APPEND);
     spi_transmit_burst(ptr);
     spi_transmit_burst(num);
@@ -2716,6 +4242,8 @@ void EVE_cmd_bgcolor_burst(uint32_t color)
 void EVE_cmd_button(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                     uint16_t font, uint16_t options, const char *p_text)
 {
+    dl_budget_add(CMD_BUTTON, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_BUTTON);
@@ -2750,6 +4278,7 @@ void EVE_cmd_button(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
 void EVE_cmd_button_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                             uint16_t font, uint16_t options, const char *p_text)
 {
+    dl_budget_add(CMD_BUTTON, 0UL);
     spi_transmit_burst(CMD_BUTTON);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) wid) + (((uint32_t) hgt) << 16U));
@@ -2777,6 +4306,8 @@ void EVE_cmd_calibrate(void)
 void EVE_cmd_clock(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options,
                     uint16_t hours, uint16_t mins, uint16_t secs, uint16_t msecs)
 {
+    dl_budget_add(CMD_CLOCK, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_CLOCK);
@@ -2814,6 +4345,7 @@ void EVE_cmd_clock(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options,
 void EVE_cmd_clock_burst(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options, uint16_t hours,
                             uint16_t mins, uint16_t secs, uint16_t msecs)
 {
+    dl_budget_add(CMD_CLOCK, 0UL);
     spi_transmit_burst(CMD_CLOCK);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) rad) + (((uint32_t) options) << 16U));
@@ -2826,6 +4358,8 @@ void EVE_cmd_clock_burst(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t option
  */
 void EVE_cmd_dial(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options, uint16_t val)
 {
+    dl_budget_add(CMD_DIAL, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_DIAL);
@@ -2858,6 +4392,7 @@ void EVE_cmd_dial(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options, uint
 void EVE_cmd_dial_burst(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options,
                         uint16_t val)
 {
+    dl_budget_add(CMD_DIAL, 0UL);
     spi_transmit_burst(CMD_DIAL);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) rad) + (((uint32_t) options) << 16U));
@@ -2900,6 +4435,8 @@ void EVE_cmd_fgcolor_burst(uint32_t color)
 void EVE_cmd_gauge(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options,
                     uint16_t major, uint16_t minor, uint16_t val, uint16_t range)
 {
+    dl_budget_add(CMD_GAUGE, (uint32_t) major * minor);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_GAUGE);
@@ -2937,6 +4474,7 @@ void EVE_cmd_gauge(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options,
 void EVE_cmd_gauge_burst(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options,
                             uint16_t major, uint16_t minor, uint16_t val, uint16_t range)
 {
+    dl_budget_add(CMD_GAUGE, (uint32_t) major * minor);
     spi_transmit_burst(CMD_GAUGE);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) rad) + (((uint32_t) options) << 16U));
@@ -3037,6 +4575,8 @@ void EVE_cmd_gradcolor_burst(uint32_t color)
 void EVE_cmd_gradient(int16_t xc0, int16_t yc0, uint32_t rgb0, int16_t xc1,
                         int16_t yc1, uint32_t rgb1)
 {
+    dl_budget_add(CMD_GRADIENT, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_GRADIENT);
@@ -3074,6 +4614,7 @@ void EVE_cmd_gradient(int16_t xc0, int16_t yc0, uint32_t rgb0, int16_t xc1,
 void EVE_cmd_gradient_burst(int16_t xc0, int16_t yc0, uint32_t rgb0, int16_t xc1,
                             int16_t yc1, uint32_t rgb1)
 {
+    dl_budget_add(CMD_GRADIENT, 0UL);
     spi_transmit_burst(CMD_GRADIENT);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(rgb0);
@@ -3089,6 +4630,8 @@ void EVE_cmd_gradient_burst(int16_t xc0, int16_t yc0, uint32_t rgb0, int16_t xc1
 void EVE_cmd_keys(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                     uint16_t font, uint16_t options, const char *p_text)
 {
+    dl_budget_add(CMD_KEYS, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_KEYS);
@@ -3125,6 +4668,7 @@ void EVE_cmd_keys(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
 void EVE_cmd_keys_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                         uint16_t font, uint16_t options, const char *p_text)
 {
+    dl_budget_add(CMD_KEYS, 0UL);
     spi_transmit_burst(CMD_KEYS);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) wid) + (((uint32_t) hgt) << 16U));
@@ -3138,6 +4682,8 @@ void EVE_cmd_keys_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
 void EVE_cmd_number(int16_t xc0, int16_t yc0, uint16_t font,
                     uint16_t options, int32_t number)
 {
+    dl_budget_add(CMD_NUMBER, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_NUMBER);
@@ -3167,6 +4713,7 @@ void EVE_cmd_number(int16_t xc0, int16_t yc0, uint16_t font,
 void EVE_cmd_number_burst(int16_t xc0, int16_t yc0, uint16_t font,
                             uint16_t options, int32_t number)
 {
+    dl_budget_add(CMD_NUMBER, 0UL);
     spi_transmit_burst(CMD_NUMBER);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) font) + (((uint32_t) options) << 16U));
@@ -3179,6 +4726,8 @@ void EVE_cmd_number_burst(int16_t xc0, int16_t yc0, uint16_t font,
 void EVE_cmd_progress(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                         uint16_t options, uint16_t val, uint16_t range)
 {
+    dl_budget_add(CMD_PROGRESS, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_PROGRESS);
@@ -3216,6 +4765,7 @@ void EVE_cmd_progress(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
 void EVE_cmd_progress_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                             uint16_t options, uint16_t val, uint16_t range)
 {
+    dl_budget_add(CMD_PROGRESS, 0UL);
     spi_transmit_burst(CMD_PROGRESS);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) wid) + (((uint32_t) hgt) << 16U));
@@ -3229,6 +4779,8 @@ void EVE_cmd_progress_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt
  */
 void EVE_cmd_romfont(uint32_t font, uint32_t romslot)
 {
+    dl_budget_add(CMD_ROMFONT, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_ROMFONT);
@@ -3250,6 +4802,7 @@ void EVE_cmd_romfont(uint32_t font, uint32_t romslot)
  */
 void EVE_cmd_romfont_burst(uint32_t font, uint32_t romslot)
 {
+    dl_budget_add(CMD_ROMFONT, 0UL);
     spi_transmit_burst(CMD_ROMFONT);
     spi_transmit_burst(font);
     spi_transmit_burst(romslot);
@@ -3318,6 +4871,8 @@ void EVE_cmd_scale_burst(int32_t scx, int32_t scy)
 void EVE_cmd_scrollbar(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
             uint16_t options, uint16_t val, uint16_t size, uint16_t range)
 {
+    dl_budget_add(CMD_SCROLLBAR, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_SCROLLBAR);
@@ -3355,6 +4910,7 @@ void EVE_cmd_scrollbar(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
 void EVE_cmd_scrollbar_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                 uint16_t options, uint16_t val, uint16_t size, uint16_t range)
 {
+    dl_budget_add(CMD_SCROLLBAR, 0UL);
     spi_transmit_burst(CMD_SCROLLBAR);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) wid) + (((uint32_t) hgt) << 16U));
@@ -3395,6 +4951,8 @@ void EVE_cmd_setbase_burst(uint32_t base)
 void EVE_cmd_setbitmap(uint32_t addr, uint16_t fmt, uint16_t width,
                         uint16_t height)
 {
+    dl_budget_add(CMD_SETBITMAP, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_SETBITMAP);
@@ -3424,6 +4982,7 @@ void EVE_cmd_setbitmap(uint32_t addr, uint16_t fmt, uint16_t width,
 void EVE_cmd_setbitmap_burst(uint32_t addr, uint16_t fmt, uint16_t width,
                                 uint16_t height)
 {
+    dl_budget_add(CMD_SETBITMAP, 0UL);
     spi_transmit_burst(CMD_SETBITMAP);
     spi_transmit_burst(addr);
     spi_transmit_burst(((uint32_t) fmt) + (((uint32_t) width) << 16U));
@@ -3468,6 +5027,8 @@ void EVE_cmd_setfont_burst(uint32_t font, uint32_t ptr)
  */
 void EVE_cmd_setfont2(uint32_t font, uint32_t ptr, uint32_t firstchar)
 {
+    dl_budget_add(CMD_SETFONT2, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_SETFONT2);
@@ -3491,6 +5052,7 @@ void EVE_cmd_setfont2(uint32_t font, uint32_t ptr, uint32_t firstchar)
  */
 void EVE_cmd_setfont2_burst(uint32_t font, uint32_t ptr, uint32_t firstchar)
 {
+    dl_budget_add(CMD_SETFONT2, 0UL);
     spi_transmit_burst(CMD_SETFONT2);
     spi_transmit_burst(font);
     spi_transmit_burst(ptr);
@@ -3530,6 +5092,8 @@ void EVE_cmd_setscratch_burst(uint32_t handle)
 void EVE_cmd_sketch(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                     uint32_t ptr, uint16_t format)
 {
+    dl_budget_add(CMD_SKETCH, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_SKETCH);
@@ -3564,6 +5128,7 @@ void EVE_cmd_sketch(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
 void EVE_cmd_sketch_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                             uint32_t ptr, uint16_t format)
 {
+    dl_budget_add(CMD_SKETCH, 0UL);
     spi_transmit_burst(CMD_SKETCH);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) ((uint16_t) wid)) + (((uint32_t) ((uint16_t) hgt)) << 16U));
@@ -3577,6 +5142,8 @@ void EVE_cmd_sketch_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
 void EVE_cmd_slider(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                     uint16_t options, uint16_t val, uint16_t range)
 {
+    dl_budget_add(CMD_SLIDER, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_SLIDER);
@@ -3614,6 +5181,7 @@ void EVE_cmd_slider(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
 void EVE_cmd_slider_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
                             uint16_t options, uint16_t val, uint16_t range)
 {
+    dl_budget_add(CMD_SLIDER, 0UL);
     spi_transmit_burst(CMD_SLIDER);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) wid) + (((uint32_t) hgt) << 16U));
@@ -3626,6 +5194,8 @@ void EVE_cmd_slider_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
  */
 void EVE_cmd_spinner(int16_t xc0, int16_t yc0, uint16_t style, uint16_t scale)
 {
+    dl_budget_add(CMD_SPINNER, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_SPINNER);
@@ -3653,6 +5223,7 @@ void EVE_cmd_spinner(int16_t xc0, int16_t yc0, uint16_t style, uint16_t scale)
 void EVE_cmd_spinner_burst(int16_t xc0, int16_t yc0, uint16_t style,
                             uint16_t scale)
 {
+    dl_budget_add(CMD_SPINNER, 0UL);
     spi_transmit_burst(CMD_SPINNER);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) style) + (((uint32_t) scale) << 16U));
@@ -3664,6 +5235,8 @@ void EVE_cmd_spinner_burst(int16_t xc0, int16_t yc0, uint16_t style,
 void EVE_cmd_text(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options,
                     const char *p_text)
 {
+    dl_budget_add(CMD_TEXT, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_TEXT);
@@ -3693,6 +5266,7 @@ void EVE_cmd_text(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options,
 void EVE_cmd_text_burst(int16_t xc0, int16_t yc0, uint16_t font,
                         uint16_t options, const char *p_text)
 {
+    dl_budget_add(CMD_TEXT, 0UL);
     spi_transmit_burst(CMD_TEXT);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) font) + (((uint32_t) options) << 16U));
@@ -3705,6 +5279,8 @@ void EVE_cmd_text_burst(int16_t xc0, int16_t yc0, uint16_t font,
 void EVE_cmd_toggle(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t font,
                     uint16_t options, uint16_t state, const char *p_text)
 {
+    dl_budget_add(CMD_TOGGLE, 0UL);
+
     if (0U == cmd_burst)
     {
         eve_begin_cmd(CMD_TOGGLE);
@@ -3739,6 +5315,7 @@ void EVE_cmd_toggle(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t font,
 void EVE_cmd_toggle_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t font,
                             uint16_t options, uint16_t state, const char *p_text)
 {
+    dl_budget_add(CMD_TOGGLE, 0UL);
     spi_transmit_burst(CMD_TOGGLE);
     spi_transmit_burst(((uint32_t) ((uint16_t) xc0)) + (((uint32_t) ((uint16_t) yc0)) << 16U));
     spi_transmit_burst(((uint32_t) wid) + (((uint32_t) font) << 16U));
@@ -3789,6 +5366,7 @@ void EVE_color_rgb(uint32_t color)
  */
 void EVE_color_rgb_burst(uint32_t color)
 {
+    dl_budget_add(DL_COLOR_RGB, 0UL);
     spi_transmit_burst(DL_COLOR_RGB | (color & 0x00ffffffUL));
 }
 
@@ -3805,6 +5383,7 @@ void EVE_color_a(uint8_t alpha)
  */
 void EVE_color_a_burst(uint8_t alpha)
 {
+    dl_budget_add(DL_COLOR_A, 0UL);
     spi_transmit_burst(DL_COLOR_A | ((uint32_t) alpha));
 }
 
@@ -3834,6 +5413,7 @@ void EVE_calibrate_manual(uint16_t width, uint16_t height)
     int32_t tmp;
     int32_t divi;
     int32_t trans_matrix[6U];
+    uint32_t transform[6U];
     uint8_t count = 0U;
     uint8_t calc = 0U;
     uint32_t calc32 = 0U;
@@ -3935,10 +5515,9 @@ void EVE_calibrate_manual(uint16_t width, uint16_t height)
            (touch_y[2U] * (((touch_x[1U] * display_y[0U]) - (touch_x[0U] * display_y[1U])))));
     trans_matrix[5U] = (int32_t) (((int64_t) tmp * 65536) / divi);
 
-    EVE_memWrite32(REG_TOUCH_TRANSFORM_A, (uint32_t) trans_matrix[0U]);
-    EVE_memWrite32(REG_TOUCH_TRANSFORM_B, (uint32_t) trans_matrix[1U]);
-    EVE_memWrite32(REG_TOUCH_TRANSFORM_C, (uint32_t) trans_matrix[2U]);
-    EVE_memWrite32(REG_TOUCH_TRANSFORM_D, (uint32_t) trans_matrix[3U]);
-    EVE_memWrite32(REG_TOUCH_TRANSFORM_E, (uint32_t) trans_matrix[4U]);
-    EVE_memWrite32(REG_TOUCH_TRANSFORM_F, (uint32_t) trans_matrix[5U]);
+    for (count = 0U; count < 6U; count++)
+    {
+        transform[count] = (uint32_t) trans_matrix[count];
+    }
+    EVE_memWrite_regs(REG_TOUCH_TRANSFORM_A, transform, 6U); /* REG_TOUCH_TRANSFORM_A to REG_TOUCH_TRANSFORM_F */
 }
@@ -84,6 +84,21 @@ EVE_cmd_animstartram_burst()
     updated BT81x series programming guide V2.4
 - commented out EVE_cmd_regread() prototype
 - removed prototype for EVE_cmd_hsf_burst()
+- added EVE_int_callback_t and the prototypes for EVE_int_set_callback(), EVE_int_edge() and EVE_int_service()
+- added EVE_FRAME_SKIPPED, EVE_frame_stats_t and the prototypes for EVE_frame_start(), EVE_frame_end(),
+    EVE_frame_invalidate() and EVE_frame_get_stats()
+- added EVE_cmd_job_t and the prototypes for the non-blocking EVE_cmd_xxx_start() functions and EVE_cmd_poll()
+- added EVE_media_read_t, EVE_media_t and the prototypes for EVE_media_start() and EVE_media_poll()
+- added the prototype for EVE_cmd_words_burst()
+- added EVE_ctx_t, EVE_DMA_RING_WORDS and the prototypes for EVE_ctx_init(), EVE_ctx_select() and EVE_ctx_int_edge(),
+    moved EVE_frame_stats_t up for EVE_ctx_t
+- added the prototype for EVE_set_spi_width()
+- added the prototypes for EVE_ramp_spi_clock() and EVE_get_spi_clock()
+- added EVE_reg_batch_t and the prototypes for EVE_memRead_regs(), EVE_memWrite_regs(), EVE_reg_batch_init(),
+    EVE_reg_batch_write() and EVE_reg_batch_send()
+- added EVE_dl_budget_callback_t, EVE_dl_budget_stats_t and the prototypes for EVE_dl_budget_init(),
+    EVE_dl_budget_left(), EVE_dl_budget_check() and EVE_dl_budget_get_stats()
+- added the display-list budget to EVE_ctx_t
 
 */
 
@@ -113,12 +128,133 @@ EVE_cmd_animstartram_burst()
 #define EVE_IS_BUSY 12U
 #define EVE_FIFO_HALF_EMPTY 13U
 #define EVE_FAULT_RECOVERED 14U
+#define EVE_FRAME_SKIPPED 15U
 
 #define EVE_FLASH_STATUS_INIT 0U
 #define EVE_FLASH_STATUS_DETACHED 1U
 #define EVE_FLASH_STATUS_BASIC 2U
 #define EVE_FLASH_STATUS_FULL 3U
 
+/* function that is called by EVE_int_service() for the flag it was registered for, */
+/* int_flags is the value read from REG_INT_FLAGS with all the flags that were set */
+typedef void (*EVE_int_callback_t)(uint8_t int_flags);
+
+/* state of a long running coprocessor command that is executed by EVE_cmd_poll() */
+/* a job is started by one of the EVE_cmd_xxx_start() functions, the fields are not to be changed by the application */
+typedef struct
+{
+    const uint8_t *p_data; /* data that follows the command, like the zlib stream for CMD_INFLATE, or NULL */
+    uint32_t length; /* number of bytes in p_data */
+    uint32_t done; /* number of bytes from p_data that are in the CMD-FIFO already */
+    uint32_t command;
+    uint32_t params[3U];
+    uint8_t num_params;
+    uint8_t state;
+} EVE_cmd_job_t;
+
+/* function that supplies the data for the media FIFO, like from a file on a SD card, */
+/* it copies up to "max" bytes to p_buffer and returns how many it did, 0 for the end of the data */
+typedef uint32_t (*EVE_media_read_t)(uint8_t *p_buffer, uint32_t max);
+
+/* state of a data stream thru the media FIFO that is fed by EVE_media_poll() */
+/* a stream is started by EVE_media_start(), the fields are not to be changed by the application */
+typedef struct
+{
+    EVE_media_read_t p_read;
+    uint8_t *p_buffer; /* buffer on the host for the data from p_read */
+    uint32_t buffer_size;
+    uint32_t buffer_fill; /* number of bytes in p_buffer */
+    uint32_t buffer_pos; /* first byte in p_buffer that is not in the media FIFO yet */
+    uint32_t fifo_address; /* start of the media FIFO in RAM_G */
+    uint32_t fifo_size;
+    uint32_t write; /* offset of the next byte in the media FIFO, the value for REG_MEDIAFIFO_WRITE */
+    uint32_t total; /* number of bytes written to the media FIFO so far */
+    uint8_t end; /* p_read returned 0 */
+} EVE_media_t;
+
+/* register writes that are collected by EVE_reg_batch_write() and sent by EVE_reg_batch_send() */
+/* a batch is set up by EVE_reg_batch_init(), the fields are not to be changed by the application */
+typedef struct
+{
+    uint32_t *p_words; /* CMD_MEMWRITE, address, length and the values for each run of consecutive registers */
+    uint32_t size; /* number of 32 bit words in p_words */
+    uint32_t count; /* number of words in use */
+    uint32_t run; /* index of the length of the last CMD_MEMWRITE, 0 if there is none */
+} EVE_reg_batch_t;
+
+#if defined (EVE_DL_BUDGET)
+
+/* function that is called when the display-list bytes estimated since CMD_DLSTART go over the limit, */
+/* with the estimate, see EVE_dl_budget_init() */
+typedef void (*EVE_dl_budget_callback_t)(uint32_t estimate);
+
+/* numbers from EVE_dl_budget_check() since the last EVE_dl_budget_get_stats() with clear set */
+typedef struct
+{
+    uint32_t frames; /* calls of EVE_dl_budget_check() */
+    uint32_t estimate; /* bytes the last display list was estimated at */
+    uint32_t measured; /* bytes in the last display list, from REG_CMD_DL */
+    uint32_t peak; /* the largest display list that was measured */
+    uint32_t warnings; /* display lists the estimate went over the limit for */
+    uint32_t over_limit; /* display lists that were measured over the limit */
+} EVE_dl_budget_stats_t;
+
+#endif /* EVE_DL_BUDGET */
+
+#if defined (EVE_DMA)
+
+/* counters for EVE_frame_end() since the last EVE_frame_get_stats() with clear set */
+typedef struct
+{
+    uint32_t frames; /* number of calls to EVE_frame_end() */
+    uint32_t skipped; /* frames that were identical to the last one and not sent */
+} EVE_frame_stats_t;
+
+#define EVE_DMA_RING_WORDS (EVE_DMA_BUFFERS * 1025U) /* size of the DMA buffers of one EVE_ctx_t in 32 bit words */
+
+#endif /* EVE_DMA */
+
+/* the state EVE_commands.c keeps for one EVE, to drive more than one EVE from the same controller */
+/* a context is set up by EVE_ctx_init() and made the current one by EVE_ctx_select(), */
+/* the fields are not to be changed by the application */
+typedef struct
+{
+    void (*p_bus_select)(void); /* called by EVE_ctx_select() to switch chip-select and / or the SPI to this EVE */
+    volatile uint8_t int_pending; /* set by EVE_ctx_int_edge() */
+    uint8_t cmd_burst;
+    uint8_t fault_recovered;
+    uint16_t cmdb_space;
+    uint16_t burst_words;
+    EVE_int_callback_t int_callbacks[8U];
+#if defined (EVE_SPI_CLOCK_MAX)
+    uint32_t spi_clock; /* the SPI clock EVE_ramp_spi_clock() selected for this EVE */
+#endif
+#if defined (EVE_DL_BUDGET)
+    uint32_t dl_estimate;
+    uint32_t dl_correction;
+    uint32_t dl_limit;
+    uint8_t dl_unit;
+    uint8_t dl_warned;
+    EVE_dl_budget_callback_t p_dl_callback;
+    EVE_dl_budget_stats_t dl_stats;
+#endif
+#if defined (EVE_DMA)
+    uint32_t *p_dma_ring; /* EVE_DMA_RING_WORDS words */
+    uint32_t *p_dma_buffer;
+    uint16_t dma_buffer_index;
+    uint16_t dma_length[EVE_DMA_BUFFERS];
+    uint8_t dma_head;
+    uint8_t dma_tail;
+    uint8_t dma_count;
+    uint8_t dma_active;
+    uint8_t dma_fifo_empty;
+    uint8_t burst_segmented;
+    uint8_t frame_valid;
+    uint32_t frame_hash;
+    EVE_frame_stats_t frame_stats;
+#endif
+} EVE_ctx_t;
+
 /* ##################################################################
     helper functions
 ##################################################################### */
@@ -134,9 +270,27 @@ void EVE_memWrite32(uint32_t const ft_address, uint32_t const ft_data);
 void EVE_memWrite_flash_buffer(uint32_t const ft_address, const uint8_t *p_data, uint32_t const len);
 void EVE_memWrite_sram_buffer(uint32_t const ft_address, const uint8_t *p_data, uint32_t const len);
 void EVE_memRead_sram_buffer(uint32_t const ft_address, uint8_t *p_data, uint32_t const len);
+void EVE_memRead_regs(uint32_t const ft_address, uint32_t *p_values, uint32_t const count);
+void EVE_memWrite_regs(uint32_t const ft_address, const uint32_t *p_values, uint32_t const count);
+void EVE_reg_batch_init(EVE_reg_batch_t *p_batch, uint32_t *p_words, uint32_t size);
+uint8_t EVE_reg_batch_write(EVE_reg_batch_t *p_batch, uint32_t ft_address, uint32_t ft_data);
+void EVE_reg_batch_send(EVE_reg_batch_t *p_batch);
 uint8_t EVE_busy(void);
 uint8_t EVE_get_and_reset_fault_state(void);
 void EVE_execute_cmd(void);
+void EVE_int_set_callback(uint8_t int_flag, EVE_int_callback_t p_callback);
+void EVE_int_edge(void);
+uint8_t EVE_int_service(void);
+void EVE_ctx_init(EVE_ctx_t *p_ctx, void (*p_bus_select)(void), uint32_t *p_ring);
+void EVE_ctx_select(EVE_ctx_t *p_ctx);
+void EVE_ctx_int_edge(EVE_ctx_t *p_ctx);
+
+#if defined (EVE_DL_BUDGET)
+void EVE_dl_budget_init(uint32_t limit, EVE_dl_budget_callback_t p_callback);
+uint32_t EVE_dl_budget_left(void);
+uint8_t EVE_dl_budget_check(void);
+void EVE_dl_budget_get_stats(EVE_dl_budget_stats_t *p_stats, uint8_t clear);
+#endif
 
 /* ##################################################################
     commands and functions to be used outside of display-lists
@@ -194,6 +348,31 @@ void EVE_cmd_videoframe(uint32_t dest, uint32_t result_ptr);
 /*void EVE_cmd_memwrite(uint32_t dest, uint32_t num, const uint8_t *p_data);*/
 /*uint32_t EVE_cmd_regread(uint32_t ptr);*/
 
+/* ##################################################################
+    non-blocking variants of long running commands
+##################################################################### */
+
+/* EVE3: BT815 / BT816 */
+#if EVE_GEN > 2
+
+uint8_t EVE_cmd_flasherase_start(EVE_cmd_job_t *p_job);
+uint8_t EVE_cmd_flashupdate_start(EVE_cmd_job_t *p_job, uint32_t dest, uint32_t src, uint32_t num);
+
+#endif /* EVE_GEN > 2 */
+
+uint8_t EVE_cmd_inflate_start(EVE_cmd_job_t *p_job, uint32_t ptr, const uint8_t *p_data, uint32_t len);
+uint8_t EVE_cmd_loadimage_start(EVE_cmd_job_t *p_job, uint32_t ptr, uint32_t options, const uint8_t *p_data, uint32_t len);
+uint8_t EVE_cmd_memcpy_start(EVE_cmd_job_t *p_job, uint32_t dest, uint32_t src, uint32_t num);
+uint8_t EVE_cmd_poll(EVE_cmd_job_t *p_job);
+
+/* ##################################################################
+    streaming thru the media FIFO
+##################################################################### */
+
+uint8_t EVE_media_start(EVE_media_t *p_media, uint32_t fifo_address, uint32_t fifo_size,
+                        uint8_t *p_buffer, uint32_t buffer_size, EVE_media_read_t p_read);
+uint8_t EVE_media_poll(EVE_media_t *p_media);
+
 /* ##################################################################
     patching and initialization
 ##################################################################### */
@@ -204,6 +383,12 @@ uint8_t EVE_init_flash(void);
 
 void EVE_write_display_parameters(void);
 uint8_t EVE_init(void);
+uint8_t EVE_set_spi_width(uint8_t width);
+
+#if defined (EVE_SPI_CLOCK_MAX)
+uint32_t EVE_ramp_spi_clock(void);
+uint32_t EVE_get_spi_clock(void);
+#endif
 
 /* ##################################################################
     functions for display lists
@@ -211,6 +396,16 @@ uint8_t EVE_init(void);
 
 void EVE_start_cmd_burst(void);
 void EVE_end_cmd_burst(void);
+void EVE_cmd_words_burst(const uint32_t *p_words, uint32_t count);
+
+#if defined (EVE_DMA)
+
+void EVE_frame_start(void);
+uint8_t EVE_frame_end(void);
+void EVE_frame_invalidate(void);
+void EVE_frame_get_stats(EVE_frame_stats_t *p_stats, uint8_t clear);
+
+#endif /* EVE_DMA */
 
 /* EVE4: BT817 / BT818 */
 #if EVE_GEN > 3
@@ -64,6 +64,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - removed the switching of clock speeds for ESP32 Arduino buffer transfers to give back control to the application
 - removed the unfortunately defunct WIZIOPICO
 - switched from the custom PICOPI macro to ARDUINO_RASPBERRY_PI_PICO
+- removed the definitions of EVE_dma_buffer, the DMA buffers are in EVE_commands.c now
 
  */
 
@@ -78,7 +79,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -170,7 +170,6 @@ void EVE_init_spi(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -242,7 +241,6 @@ void EVE_start_dma_transfer(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -297,7 +295,6 @@ void EVE_init_spi(void)
 #include "hardware/dma.h"
 #include "hardware/irq.h"
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 int dma_tx;
@@ -349,7 +346,6 @@ void EVE_start_dma_transfer(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -435,7 +431,6 @@ void EVE_start_dma_transfer(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -463,7 +458,6 @@ void EVE_start_dma_transfer(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -538,7 +532,6 @@ void EVE_init_spi(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -579,7 +572,6 @@ void EVE_start_dma_transfer(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -39,6 +39,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - added workaround for non-standard implementations of SPI.transfer(buffer, count)
 - optimized for ESP32 by using SPI.write() and SPI.write32()
 - removed the unfortunately defunct WIZIOPICO
+- added wrapper_spi_transmit_block()
+- added wrapper_spi_receive_block()
 
 */
 
@@ -63,6 +65,17 @@ extern "C" {
     {
         SPI.write32(data);
     }
+
+    void wrapper_spi_transmit_block(const uint8_t *p_data, uint32_t length)
+    {
+        SPI.writeBytes(p_data, length);
+    }
+
+    void wrapper_spi_receive_block(uint8_t *p_data, uint32_t length)
+    {
+        memset(p_data, 0, length); /* the buffer is used for the dummy bytes as well */
+        SPI.transferBytes(p_data, p_data, length);
+    }
 #else
     void wrapper_spi_transmit(uint8_t data)
     {
@@ -81,6 +94,22 @@ extern "C" {
     }
 #endif
 
+    void wrapper_spi_transmit_block(const uint8_t *p_data, uint32_t length)
+    {
+        for (uint32_t count = 0U; count < length; count++)
+        {
+            SPI.transfer(p_data[count]);
+        }
+    }
+
+    void wrapper_spi_receive_block(uint8_t *p_data, uint32_t length)
+    {
+        for (uint32_t count = 0U; count < length; count++)
+        {
+            p_data[count] = SPI.transfer(0U);
+        }
+    }
+
 #endif
 
     uint8_t wrapper_spi_receive(uint8_t data)
@@ -33,6 +33,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 5.0
 - added wrapper_spi_transmit_32()
 - changed return type of wrapper_spi_transmit_32() to void as intended
+- added wrapper_spi_transmit_block()
+- added wrapper_spi_receive_block()
 
 */
 
@@ -47,7 +49,9 @@ extern "C" {
 
     void wrapper_spi_transmit(uint8_t data);
     void wrapper_spi_transmit_32(uint32_t data);
+    void wrapper_spi_transmit_block(const uint8_t *p_data, uint32_t length);
     uint8_t wrapper_spi_receive(uint8_t data);
+    void wrapper_spi_receive_block(uint8_t *p_data, uint32_t length);
 
 #ifdef __cplusplus
 }
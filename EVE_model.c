@@ -0,0 +1,2699 @@
+/*
+@file    EVE_model.c
+@brief   behavioral software model of a FT81x / BT81x for the host target SOFTWARE_TEST
+@version 5.0
+@date    2023-10-01
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2023 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+This is not an emulator, nothing is rendered.
+The model covers what can be observed thru the SPI:
+- the SPI protocol with host commands, memory reads with dummy byte and memory writes
+- RAM_G, RAM_DL, the register file and RAM_CMD
+- the command co-processor FIFO with REG_CMD_READ, REG_CMD_WRITE, REG_CMDB_SPACE and REG_CMDB_WRITE
+- the co-processor itself, it decodes the commands, keeps track of REG_CMD_DL,
+    executes the memory and flash commands, inflates zlib data, writes back results
+    and faults the same way the real thing does, for example on a display-list overflow
+- a display that is running with the timing from the display registers, this increments REG_FRAMES
+    and completes display-list swaps
+- the external flash of BT81x
+- the media FIFO, CMD_LOADIMAGE and CMD_PLAYVIDEO with EVE_OPT_MEDIAFIFO read their data from it
+- dual and quad SPI with REG_SPI_WIDTH, the host tells the model how many data lines it is using
+- the SPI clock of the host, bytes are damaged above a limit that stands for the traces on a board
+
+Widgets only write an approximation of the display-list they would generate and
+CMD_LOADIMAGE does not decode any pixels, it only reads the headers to find the end of the data.
+
+The time in the model is not the time on the host, it advances with every byte on the SPI
+and with DELAY_MS().
+
+@section History
+
+5.0
+- initial version
+- added the INT_N output with EVE_model_set_int_hook() and EVE_model_touch() to raise INT_TOUCH and INT_TAG
+- CMD_MEMCPY copies from and to memory other than RAM_G, like RAM_DL
+- the chip-id is written to RAM_G at 0xc0000 by a reset like with the real thing instead of always being read from there
+- CMD_LOADIMAGE and CMD_PLAYVIDEO with EVE_OPT_MEDIAFIFO consume the data between REG_MEDIAFIFO_READ and
+    REG_MEDIAFIFO_WRITE and stay at the top of the CMD-FIFO until the end of the data
+- added EVE_model_select() for more than one EVE, there are EVE_MODEL_INSTANCES instances of the model
+- added REG_SPI_WIDTH and EVE_model_spi_width(), bytes sent with a different number of data lines than
+    the model is set to are protocol errors
+- added EVE_model_spi_clock() and EVE_model_spi_limit() to damage bytes above a SPI clock
+- added EVE_model_touch_point() for the touch points 1 to 4, REG_CTOUCH_TOUCH2_XY starts without a touch
+- the helpers for OPT_FORMAT and the external flash are only built for BT81x and later
+
+*/
+
+#include "EVE.h"
+
+#if defined (SOFTWARE_TEST)
+
+#include <string.h>
+
+#define MODEL_RAM_REG_SIZE  ((uint32_t) 4096UL)
+#define MODEL_RAM_REG2      ((uint32_t) 0x00309000UL) /* REG_TRACKER, REG_MEDIAFIFO_READ, RAM_ERR_REPORT, ... */
+#define MODEL_RAM_FLASH     ((uint32_t) 0x00800000UL) /* only for EVE_model_peek32(), the flash is not in the memory map */
+#define MODEL_OPT_FLASH     ((uint32_t) 64UL) /* EVE_OPT_FLASH is only defined for BT81x */
+#define MODEL_CMD_MASK      ((uint32_t) 0x00000fffUL)
+#define MODEL_RAM_G_MASK    (EVE_RAM_G_SIZE - 1UL)
+#define MODEL_STREAM_SIZE   ((uint32_t) 1024UL*1024UL) /* max size of zlib, image or video data thru the command FIFO */
+#define MODEL_PNG_SCRATCH   ((uint32_t) 42UL*1024UL) /* CMD_LOADIMAGE uses the top 42 KiB of RAM_G as scratch for PNG */
+#define MODEL_SPI_CLOCK     ((uint32_t) 8000000UL) /* the SPI clock of the host until EVE_model_spi_clock() is used */
+#define MODEL_FRAME_DEFAULT ((uint32_t) 16666667UL) /* 60Hz in ns, used when the pixel clock can not be calculated */
+
+/* states of the SPI transaction decoder */
+#define MODEL_SPI_HEADER  0U
+#define MODEL_SPI_WRITE   1U
+#define MODEL_SPI_DUMMY   2U
+#define MODEL_SPI_READ    3U
+#define MODEL_SPI_HOSTCMD 4U
+
+/* data following a co-processor command thru the FIFO */
+#define MODEL_STREAM_NONE    0U
+#define MODEL_STREAM_MEMORY  1U /* CMD_MEMWRITE */
+#define MODEL_STREAM_FLASH   2U /* CMD_FLASHWRITE */
+#define MODEL_STREAM_DISCARD 3U /* CMD_FLASHSPITX */
+#define MODEL_STREAM_INFLATE 4U /* CMD_INFLATE, CMD_INFLATE2, zlib */
+#define MODEL_STREAM_IMAGE   5U /* CMD_LOADIMAGE, JPEG or PNG */
+#define MODEL_STREAM_VIDEO   6U /* CMD_PLAYVIDEO, AVI */
+
+/* results of the functions that look for the end of data with no length given */
+#define MODEL_SCAN_MORE  0U
+#define MODEL_SCAN_DONE  1U
+#define MODEL_SCAN_ERROR 2U
+
+/* flags for the command table */
+#define MODEL_CMD_STRING 0x01U /* a zero-terminated string follows the parameters */
+
+typedef struct
+{
+    uint8_t params; /* number of 32 bit parameters following the command */
+    uint8_t gen; /* first EVE generation that knows the command, 0 = no command */
+    uint8_t flags;
+    uint8_t dl_words; /* approximate number of display-list entries a widget generates */
+} model_command_t;
+
+typedef struct
+{
+    uint32_t width;
+    uint32_t height;
+    uint8_t format;
+    uint8_t png;
+} model_image_t;
+
+typedef struct
+{
+    const uint8_t *p_src;
+    uint32_t length;
+    uint32_t pos;
+    uint32_t bits;
+    uint32_t count;
+    uint32_t dest;
+    uint32_t out;
+    uint8_t more;
+} model_inflate_t;
+
+typedef struct
+{
+    uint16_t count[16U];
+    uint16_t symbol[288U];
+} model_huffman_t;
+
+/* indexed by the lowest byte of the command, CMD_DLSTART = 0xffffff00 */
+static const model_command_t model_commands[0x71U] =
+{
+    {0U, 2U, 0U, 0U},  /* 0x00 CMD_DLSTART */
+    {0U, 2U, 0U, 0U},  /* 0x01 CMD_SWAP */
+    {1U, 2U, 0U, 0U},  /* 0x02 CMD_INTERRUPT */
+    {0U, 0U, 0U, 0U},
+    {0U, 0U, 0U, 0U},
+    {0U, 0U, 0U, 0U},
+    {0U, 0U, 0U, 0U},
+    {0U, 0U, 0U, 0U},
+    {0U, 0U, 0U, 0U},
+    {1U, 2U, 0U, 0U},  /* 0x09 CMD_BGCOLOR */
+    {1U, 2U, 0U, 0U},  /* 0x0a CMD_FGCOLOR */
+    {4U, 2U, 0U, 16U}, /* 0x0b CMD_GRADIENT */
+    {2U, 2U, MODEL_CMD_STRING, 0U}, /* 0x0c CMD_TEXT */
+    {3U, 2U, MODEL_CMD_STRING, 10U}, /* 0x0d CMD_BUTTON */
+    {3U, 2U, MODEL_CMD_STRING, 0U}, /* 0x0e CMD_KEYS */
+    {4U, 2U, 0U, 12U}, /* 0x0f CMD_PROGRESS */
+    {4U, 2U, 0U, 18U}, /* 0x10 CMD_SLIDER */
+    {4U, 2U, 0U, 18U}, /* 0x11 CMD_SCROLLBAR */
+    {3U, 2U, MODEL_CMD_STRING, 18U}, /* 0x12 CMD_TOGGLE */
+    {4U, 2U, 0U, 60U}, /* 0x13 CMD_GAUGE */
+    {4U, 2U, 0U, 80U}, /* 0x14 CMD_CLOCK */
+    {1U, 2U, 0U, 16U}, /* 0x15 CMD_CALIBRATE */
+    {2U, 2U, 0U, 32U}, /* 0x16 CMD_SPINNER */
+    {0U, 2U, 0U, 0U},  /* 0x17 CMD_STOP */
+    {3U, 2U, 0U, 0U},  /* 0x18 CMD_MEMCRC */
+    {2U, 2U, 0U, 0U},  /* 0x19 CMD_REGREAD */
+    {2U, 2U, 0U, 0U},  /* 0x1a CMD_MEMWRITE */
+    {3U, 2U, 0U, 0U},  /* 0x1b CMD_MEMSET */
+    {2U, 2U, 0U, 0U},  /* 0x1c CMD_MEMZERO */
+    {3U, 2U, 0U, 0U},  /* 0x1d CMD_MEMCPY */
+    {2U, 2U, 0U, 0U},  /* 0x1e CMD_APPEND */
+    {1U, 2U, 0U, 0U},  /* 0x1f CMD_SNAPSHOT */
+    {0U, 0U, 0U, 0U},
+    {13U, 3U, 0U, 0U}, /* 0x21 CMD_BITMAP_TRANSFORM */
+    {1U, 2U, 0U, 0U},  /* 0x22 CMD_INFLATE */
+    {1U, 2U, 0U, 0U},  /* 0x23 CMD_GETPTR */
+    {2U, 2U, 0U, 0U},  /* 0x24 CMD_LOADIMAGE */
+    {3U, 2U, 0U, 0U},  /* 0x25 CMD_GETPROPS */
+    {0U, 2U, 0U, 0U},  /* 0x26 CMD_LOADIDENTITY */
+    {2U, 2U, 0U, 0U},  /* 0x27 CMD_TRANSLATE */
+    {2U, 2U, 0U, 0U},  /* 0x28 CMD_SCALE */
+    {1U, 2U, 0U, 0U},  /* 0x29 CMD_ROTATE */
+    {0U, 2U, 0U, 0U},  /* 0x2a CMD_SETMATRIX */
+    {2U, 2U, 0U, 0U},  /* 0x2b CMD_SETFONT */
+    {3U, 2U, 0U, 0U},  /* 0x2c CMD_TRACK */
+    {3U, 2U, 0U, 20U}, /* 0x2d CMD_DIAL */
+    {3U, 2U, 0U, 11U}, /* 0x2e CMD_NUMBER */
+    {0U, 2U, 0U, 4U},  /* 0x2f CMD_SCREENSAVER */
+    {4U, 2U, 0U, 4U},  /* 0x30 CMD_SKETCH */
+    {0U, 2U, 0U, 20U}, /* 0x31 CMD_LOGO */
+    {0U, 2U, 0U, 0U},  /* 0x32 CMD_COLDSTART */
+    {6U, 2U, 0U, 0U},  /* 0x33 CMD_GETMATRIX */
+    {1U, 2U, 0U, 0U},  /* 0x34 CMD_GRADCOLOR */
+    {0U, 0U, 0U, 0U},
+    {1U, 2U, 0U, 0U},  /* 0x36 CMD_SETROTATE */
+    {4U, 2U, 0U, 0U},  /* 0x37 CMD_SNAPSHOT2 */
+    {1U, 2U, 0U, 0U},  /* 0x38 CMD_SETBASE */
+    {2U, 2U, 0U, 0U},  /* 0x39 CMD_MEDIAFIFO */
+    {1U, 2U, 0U, 0U},  /* 0x3a CMD_PLAYVIDEO */
+    {3U, 2U, 0U, 5U},  /* 0x3b CMD_SETFONT2 */
+    {1U, 2U, 0U, 0U},  /* 0x3c CMD_SETSCRATCH */
+    {0U, 0U, 0U, 0U},
+    {0U, 0U, 0U, 0U},
+    {2U, 2U, 0U, 5U},  /* 0x3f CMD_ROMFONT */
+    {0U, 2U, 0U, 0U},  /* 0x40 CMD_VIDEOSTART */
+    {2U, 2U, 0U, 0U},  /* 0x41 CMD_VIDEOFRAME */
+    {0U, 3U, 0U, 0U},  /* 0x42 CMD_SYNC */
+    {3U, 2U, 0U, 0U},  /* 0x43 CMD_SETBITMAP */
+    {0U, 3U, 0U, 0U},  /* 0x44 CMD_FLASHERASE */
+    {2U, 3U, 0U, 0U},  /* 0x45 CMD_FLASHWRITE */
+    {3U, 3U, 0U, 0U},  /* 0x46 CMD_FLASHREAD */
+    {3U, 3U, 0U, 0U},  /* 0x47 CMD_FLASHUPDATE */
+    {0U, 3U, 0U, 0U},  /* 0x48 CMD_FLASHDETACH */
+    {0U, 3U, 0U, 0U},  /* 0x49 CMD_FLASHATTACH */
+    {1U, 3U, 0U, 0U},  /* 0x4a CMD_FLASHFAST */
+    {0U, 3U, 0U, 0U},  /* 0x4b CMD_FLASHSPIDESEL */
+    {1U, 3U, 0U, 0U},  /* 0x4c CMD_FLASHSPITX */
+    {2U, 3U, 0U, 0U},  /* 0x4d CMD_FLASHSPIRX */
+    {1U, 3U, 0U, 0U},  /* 0x4e CMD_FLASHSOURCE */
+    {0U, 3U, 0U, 0U},  /* 0x4f CMD_CLEARCACHE */
+    {2U, 3U, 0U, 0U},  /* 0x50 CMD_INFLATE2 */
+    {4U, 3U, 0U, 0U},  /* 0x51 CMD_ROTATEAROUND */
+    {0U, 3U, 0U, 0U},  /* 0x52 CMD_RESETFONTS */
+    {3U, 3U, 0U, 0U},  /* 0x53 CMD_ANIMSTART */
+    {1U, 3U, 0U, 0U},  /* 0x54 CMD_ANIMSTOP */
+    {2U, 3U, 0U, 0U},  /* 0x55 CMD_ANIMXY */
+    {1U, 3U, 0U, 8U},  /* 0x56 CMD_ANIMDRAW */
+    {4U, 3U, 0U, 20U}, /* 0x57 CMD_GRADIENTA */
+    {1U, 3U, 0U, 0U},  /* 0x58 CMD_FILLWIDTH */
+    {2U, 3U, 0U, 0U},  /* 0x59 CMD_APPENDF */
+    {3U, 3U, 0U, 8U},  /* 0x5a CMD_ANIMFRAME */
+    {0U, 0U, 0U, 0U},
+    {0U, 0U, 0U, 0U},
+    {0U, 0U, 0U, 0U},
+    {1U, 4U, 0U, 0U},  /* 0x5e CMD_LINETIME */
+    {0U, 3U, 0U, 0U},  /* 0x5f CMD_VIDEOSTARTF */
+    {3U, 4U, 0U, 16U}, /* 0x60 CMD_CALIBRATESUB */
+    {0U, 4U, 0U, 60U}, /* 0x61 CMD_TESTCARD */
+    {1U, 4U, 0U, 0U},  /* 0x62 CMD_HSF */
+    {1U, 4U, 0U, 0U},  /* 0x63 CMD_APILEVEL */
+    {5U, 4U, 0U, 0U},  /* 0x64 CMD_GETIMAGE */
+    {1U, 4U, 0U, 0U},  /* 0x65 CMD_WAIT */
+    {0U, 4U, 0U, 0U},  /* 0x66 CMD_RETURN */
+    {1U, 4U, 0U, 0U},  /* 0x67 CMD_CALLLIST */
+    {1U, 4U, 0U, 0U},  /* 0x68 CMD_NEWLIST */
+    {0U, 4U, 0U, 0U},  /* 0x69 CMD_ENDLIST */
+    {3U, 4U, 0U, 0U},  /* 0x6a CMD_PCLKFREQ */
+    {3U, 4U, 0U, 0U},  /* 0x6b CMD_FONTCACHE */
+    {2U, 4U, 0U, 0U},  /* 0x6c CMD_FONTCACHEQUERY */
+    {3U, 4U, 0U, 8U},  /* 0x6d CMD_ANIMFRAMERAM */
+    {3U, 4U, 0U, 0U},  /* 0x6e CMD_ANIMSTARTRAM */
+    {2U, 4U, 0U, 8U},  /* 0x6f CMD_RUNANIM */
+    {3U, 4U, 0U, 0U}   /* 0x70 CMD_FLASHPROGRAM */
+};
+
+/* the memory of all instances, the pointers below point to the one of the selected instance */
+static uint8_t model_ram_g_banks[EVE_MODEL_INSTANCES][EVE_RAM_G_SIZE];
+static uint8_t model_ram_dl_banks[EVE_MODEL_INSTANCES][EVE_RAM_DL_SIZE];
+static uint8_t model_ram_reg_banks[EVE_MODEL_INSTANCES][MODEL_RAM_REG_SIZE];
+static uint8_t model_ram_reg2_banks[EVE_MODEL_INSTANCES][MODEL_RAM_REG_SIZE];
+static uint8_t model_ram_cmd_banks[EVE_MODEL_INSTANCES][EVE_CMDFIFO_SIZE];
+static uint8_t model_flash_banks[EVE_MODEL_INSTANCES][EVE_MODEL_FLASH_SIZE];
+static uint8_t model_stream_banks[EVE_MODEL_INSTANCES][MODEL_STREAM_SIZE];
+
+static uint8_t *model_ram_g = model_ram_g_banks[0U];
+static uint8_t *model_ram_dl = model_ram_dl_banks[0U];
+static uint8_t *model_ram_reg = model_ram_reg_banks[0U];
+static uint8_t *model_ram_reg2 = model_ram_reg2_banks[0U];
+static uint8_t *model_ram_cmd = model_ram_cmd_banks[0U];
+static uint8_t *model_flash = model_flash_banks[0U];
+static uint8_t *model_stream_buffer = model_stream_banks[0U];
+
+static EVE_model_stats_t model_stats;
+
+static void (*model_int_hook)(void) = NULL; /* called for a falling edge on INT_N, not changed by a reset */
+static uint8_t model_host_lines = 1U; /* data lines the host is using, set by EVE_model_spi_width() */
+static uint32_t model_host_clock = MODEL_SPI_CLOCK; /* SPI clock of the host, set by EVE_model_spi_clock() */
+static uint32_t model_spi_limit = 0U; /* bit errors above this SPI clock, 0 for none, set by EVE_model_spi_limit() */
+static uint32_t model_spi_noise = 0U; /* bytes transferred above model_spi_limit */
+
+typedef struct
+{
+    uint8_t initialized;
+    uint8_t powered; /* PD is high */
+    uint8_t active; /* host command ACTIVE was received */
+    uint8_t lazy; /* the co-processor only runs between SPI transactions */
+    uint8_t swap_pending;
+    uint8_t int_active; /* INT_N is low */
+    uint8_t spi_width; /* REG_SPI_WIDTH, it takes effect at the end of the transaction that wrote it */
+    uint64_t time_ns;
+    uint64_t frame_ns; /* time since the last frame */
+    uint64_t clock_ns; /* time not yet accounted for in REG_CLOCK */
+} model_chip_t;
+
+typedef struct
+{
+    uint8_t selected;
+    uint8_t state;
+    uint8_t header[3U];
+    uint8_t fifo_bytes; /* bytes of the current 32 bit word written to REG_CMDB_WRITE */
+    uint32_t count;
+    uint32_t address;
+} model_spi_t;
+
+typedef struct
+{
+    uint8_t fault;
+    uint8_t running;
+    uint8_t stream;
+    uint32_t stream_address;
+    uint32_t stream_payload; /* bytes left to store */
+    uint32_t stream_left; /* bytes left to consume, including the padding */
+    uint32_t stream_length; /* bytes collected in model_stream_buffer */
+    uint32_t stream_options;
+    uint32_t string_length; /* length of the string of the current command, without the terminating zero */
+    uint32_t result_ptr; /* for CMD_GETPTR */
+    uint32_t flash_source; /* for CMD_FLASHSOURCE */
+    uint32_t bitmap_ptr; /* for CMD_GETPROPS and CMD_GETIMAGE */
+    uint32_t bitmap_width;
+    uint32_t bitmap_height;
+    uint32_t bitmap_format;
+    uint8_t media; /* the stream comes from the media FIFO */
+    uint32_t media_base; /* for CMD_MEDIAFIFO */
+    uint32_t media_size;
+    uint32_t media_next; /* REG_CMD_READ after the command that reads from the media FIFO */
+} model_copro_t;
+
+static model_chip_t model;
+static model_spi_t model_spi;
+static model_copro_t model_copro;
+
+#if EVE_MODEL_INSTANCES > 1
+/* the state of the instances that are not selected, see EVE_model_select() */
+static struct
+{
+    model_chip_t chip;
+    model_spi_t spi;
+    model_copro_t copro;
+    EVE_model_stats_t stats;
+    void (*int_hook)(void);
+} model_instances[EVE_MODEL_INSTANCES];
+
+static uint8_t model_instance = 0U; /* the selected instance */
+#endif
+
+/* ################################################################## */
+/* helper functions */
+/* ################################################################## */
+
+static uint32_t model_get32(const uint8_t *p_mem)
+{
+    return (((uint32_t) p_mem[0U])
+        | (((uint32_t) p_mem[1U]) << 8U)
+        | (((uint32_t) p_mem[2U]) << 16U)
+        | (((uint32_t) p_mem[3U]) << 24U));
+}
+
+static void model_put32(uint8_t *p_mem, uint32_t data)
+{
+    p_mem[0U] = (uint8_t) data;
+    p_mem[1U] = (uint8_t) (data >> 8U);
+    p_mem[2U] = (uint8_t) (data >> 16U);
+    p_mem[3U] = (uint8_t) (data >> 24U);
+}
+
+static uint32_t model_get32_be(const uint8_t *p_mem)
+{
+    return ((((uint32_t) p_mem[0U]) << 24U)
+        | (((uint32_t) p_mem[1U]) << 16U)
+        | (((uint32_t) p_mem[2U]) << 8U)
+        | ((uint32_t) p_mem[3U]));
+}
+
+static uint32_t model_get16_be(const uint8_t *p_mem)
+{
+    return ((((uint32_t) p_mem[0U]) << 8U) | ((uint32_t) p_mem[1U]));
+}
+
+/* returns a pointer to the byte at address, NULL for addresses without memory behind them */
+/* note: the external flash of BT81x is not in the memory map */
+static uint8_t *model_map(uint32_t address)
+{
+    uint8_t *p_ret = NULL;
+
+    if (address < EVE_RAM_G_SIZE)
+    {
+        p_ret = &model_ram_g[address];
+    }
+    else if ((address >= EVE_RAM_DL) && (address < (EVE_RAM_DL + EVE_RAM_DL_SIZE)))
+    {
+        p_ret = &model_ram_dl[address - EVE_RAM_DL];
+    }
+    else if ((address >= EVE_RAM_REG) && (address < (EVE_RAM_REG + MODEL_RAM_REG_SIZE)))
+    {
+        p_ret = &model_ram_reg[address - EVE_RAM_REG];
+    }
+    else if ((address >= EVE_RAM_CMD) && (address < (EVE_RAM_CMD + EVE_CMDFIFO_SIZE)))
+    {
+        p_ret = &model_ram_cmd[address - EVE_RAM_CMD];
+    }
+    else if ((address >= MODEL_RAM_REG2) && (address < (MODEL_RAM_REG2 + MODEL_RAM_REG_SIZE)))
+    {
+        p_ret = &model_ram_reg2[address - MODEL_RAM_REG2];
+    }
+    else
+    {
+        p_ret = NULL;
+    }
+
+    return (p_ret);
+}
+
+static uint32_t model_reg(uint32_t address)
+{
+    uint32_t ret = 0U;
+    const uint8_t *p_mem = model_map(address);
+
+    if (p_mem != NULL)
+    {
+        ret = model_get32(p_mem);
+    }
+    return (ret);
+}
+
+static void model_set_reg(uint32_t address, uint32_t data)
+{
+    uint8_t *p_mem = model_map(address);
+
+    if (p_mem != NULL)
+    {
+        model_put32(p_mem, data);
+    }
+}
+
+static void model_store8(uint32_t address, uint8_t data)
+{
+    uint8_t *p_mem = model_map(address);
+
+    if (p_mem != NULL)
+    {
+        *p_mem = data;
+    }
+}
+
+static uint8_t model_load8(uint32_t address)
+{
+    uint8_t ret = 0U;
+    const uint8_t *p_mem = model_map(address);
+
+    if (p_mem != NULL)
+    {
+        ret = *p_mem;
+    }
+    return (ret);
+}
+
+/* INT_N is low while REG_INT_EN is set and any of the flags in REG_INT_FLAGS is enabled in REG_INT_MASK */
+static void model_int_update(void)
+{
+    uint8_t active = 0U;
+
+    if ((0U != (model_reg(REG_INT_EN) & 1U)) &&
+        (0U != (model_ram_reg[REG_INT_FLAGS - EVE_RAM_REG] & model_ram_reg[REG_INT_MASK - EVE_RAM_REG])))
+    {
+        active = 1U;
+    }
+
+    if ((0U == model.int_active) && (0U != active) && (model_int_hook != NULL))
+    {
+        model.int_active = active;
+        model_int_hook();
+    }
+    model.int_active = active;
+}
+
+static void model_interrupt(uint8_t flags)
+{
+    model_ram_reg[REG_INT_FLAGS - EVE_RAM_REG] |= flags;
+    model_int_update();
+}
+
+static uint32_t model_fifo_fill(void)
+{
+    return ((model_reg(REG_CMD_WRITE) - model_reg(REG_CMD_READ)) & MODEL_CMD_MASK);
+}
+
+static uint32_t model_cmdb_space(void)
+{
+    return ((0xffcUL - model_fifo_fill()) & MODEL_CMD_MASK);
+}
+
+static uint32_t model_crc32(uint32_t address, uint32_t length)
+{
+    uint32_t crc = 0xffffffffUL;
+
+    for (uint32_t index = 0U; index < length; index++)
+    {
+        crc ^= model_load8(address + index);
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            if (0U != (crc & 1U))
+            {
+                crc = (crc >> 1U) ^ 0xedb88320UL;
+            }
+            else
+            {
+                crc = crc >> 1U;
+            }
+        }
+    }
+    return (~crc);
+}
+
+static uint32_t model_bytes_per_pixel(uint32_t format)
+{
+    uint32_t ret = 2U;
+
+    if ((EVE_L8 == format) || (EVE_PALETTED8 == format)
+        || (EVE_PALETTED565 == format) || (EVE_PALETTED4444 == format))
+    {
+        ret = 1U;
+    }
+    else if (0x20U == format) /* ARGB8 for CMD_SNAPSHOT2 */
+    {
+        ret = 4U;
+    }
+    else
+    {
+        ret = 2U;
+    }
+    return (ret);
+}
+
+/* ################################################################## */
+/* co-processor */
+/* ################################################################## */
+
+static void model_fault(const char *p_message)
+{
+    model_copro.fault = 1U;
+    model_copro.stream = MODEL_STREAM_NONE;
+    model_set_reg(REG_CMD_READ, 0xfffUL);
+    model_stats.faults++;
+
+#if EVE_GEN > 2
+    uint32_t index = 0U;
+    static const char prefix[] = "ERROR: ";
+
+    (void) memset(&model_ram_reg2[EVE_RAM_ERR_REPORT - MODEL_RAM_REG2], 0, 128U);
+    for (uint32_t pos = 0U; ('\0' != prefix[pos]); pos++)
+    {
+        model_ram_reg2[(EVE_RAM_ERR_REPORT - MODEL_RAM_REG2) + index] = (uint8_t) prefix[pos];
+        index++;
+    }
+    for (uint32_t pos = 0U; ('\0' != p_message[pos]) && (index < 127U); pos++)
+    {
+        model_ram_reg2[(EVE_RAM_ERR_REPORT - MODEL_RAM_REG2) + index] = (uint8_t) p_message[pos];
+        index++;
+    }
+#else
+    (void) p_message;
+#endif
+}
+
+static uint32_t model_param(uint32_t read, uint32_t index)
+{
+    return (model_get32(&model_ram_cmd[(read + (index * 4U)) & MODEL_CMD_MASK]));
+}
+
+static void model_result(uint32_t read, uint32_t index, uint32_t data)
+{
+    model_put32(&model_ram_cmd[(read + (index * 4U)) & MODEL_CMD_MASK], data);
+}
+
+static void model_dl_write(uint32_t data)
+{
+    uint32_t cmd_dl = model_reg(REG_CMD_DL);
+
+    if (0U == model_copro.fault)
+    {
+        if ((cmd_dl + 4U) > EVE_RAM_DL_SIZE)
+        {
+            model_fault("display list overflow");
+        }
+        else
+        {
+            model_put32(&model_ram_dl[cmd_dl], data);
+            model_set_reg(REG_CMD_DL, cmd_dl + 4U);
+            model_stats.dl_words++;
+        }
+    }
+}
+
+/* approximation of the display-list a widget generates */
+static void model_dl_widget(uint32_t vertices)
+{
+    if (vertices > 0U)
+    {
+        model_dl_write(DL_BEGIN | EVE_BITMAPS);
+        for (uint32_t index = 0U; index < vertices; index++)
+        {
+            model_dl_write(DL_VERTEX2II);
+        }
+        model_dl_write(DL_END);
+    }
+}
+
+static void model_dl_bitmap(uint32_t ptr, uint32_t format, uint32_t width, uint32_t height)
+{
+    uint32_t stride = width * model_bytes_per_pixel(format);
+
+    model_dl_write(BITMAP_SOURCE(ptr));
+    model_dl_write(BITMAP_LAYOUT((uint8_t) format, (uint16_t) stride, (uint8_t) height));
+    model_dl_write(BITMAP_LAYOUT_H((uint16_t) (stride >> 10U), (uint16_t) (height >> 9U)));
+    model_dl_write(BITMAP_SIZE(EVE_NEAREST, EVE_BORDER, EVE_BORDER, (uint16_t) width, (uint16_t) height));
+    model_dl_write(BITMAP_SIZE_H((uint16_t) (width >> 9U), (uint16_t) (height >> 9U)));
+}
+
+#if EVE_GEN > 2
+/* returns the number of 32 bit arguments a format string for OPT_FORMAT needs */
+static uint32_t model_format_arguments(uint32_t offset, uint32_t length)
+{
+    uint32_t args = 0U;
+    uint32_t pos = 0U;
+
+    while (pos < length)
+    {
+        if ('%' == model_ram_cmd[(offset + pos) & MODEL_CMD_MASK])
+        {
+            pos++;
+            if ((pos < length) && ('%' == model_ram_cmd[(offset + pos) & MODEL_CMD_MASK]))
+            {
+                pos++;
+            }
+            else
+            {
+                while (pos < length)
+                {
+                    uint8_t chr = model_ram_cmd[(offset + pos) & MODEL_CMD_MASK];
+                    pos++;
+                    if ('*' == chr)
+                    {
+                        args++;
+                    }
+                    else if ((('0' <= chr) && ('9' >= chr)) || ('-' == chr) || ('+' == chr)
+                        || (' ' == chr) || ('#' == chr) || ('.' == chr) || ('l' == chr) || ('h' == chr))
+                    {
+                        /* flags, width, precision and length modifier */
+                    }
+                    else
+                    {
+                        args++; /* conversion */
+                        break;
+                    }
+                }
+            }
+        }
+        else
+        {
+            pos++;
+        }
+    }
+    return (args);
+}
+#endif
+
+/* ################################################################## */
+/* zlib */
+/* ################################################################## */
+
+static const uint16_t model_length_base[29U] =
+    {3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U, 13U, 15U, 17U, 19U, 23U, 27U, 31U,
+     35U, 43U, 51U, 59U, 67U, 83U, 99U, 115U, 131U, 163U, 195U, 227U, 258U};
+static const uint8_t model_length_extra[29U] =
+    {0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U, 1U, 1U, 1U, 2U, 2U, 2U, 2U,
+     3U, 3U, 3U, 3U, 4U, 4U, 4U, 4U, 5U, 5U, 5U, 5U, 0U};
+static const uint16_t model_dist_base[30U] =
+    {1U, 2U, 3U, 4U, 5U, 7U, 9U, 13U, 17U, 25U, 33U, 49U, 65U, 97U, 129U, 193U,
+     257U, 385U, 513U, 769U, 1025U, 1537U, 2049U, 3073U, 4097U, 6145U, 8193U, 12289U, 16385U, 24577U};
+static const uint8_t model_dist_extra[30U] =
+    {0U, 0U, 0U, 0U, 1U, 1U, 2U, 2U, 3U, 3U, 4U, 4U, 5U, 5U, 6U, 6U,
+     7U, 7U, 8U, 8U, 9U, 9U, 10U, 10U, 11U, 11U, 12U, 12U, 13U, 13U};
+
+static uint32_t model_inflate_bits(model_inflate_t *p_inf, uint32_t need)
+{
+    uint32_t ret = 0U;
+
+    while ((p_inf->count < need) && (0U == p_inf->more))
+    {
+        if (p_inf->pos < p_inf->length)
+        {
+            p_inf->bits |= ((uint32_t) p_inf->p_src[p_inf->pos]) << p_inf->count;
+            p_inf->pos++;
+            p_inf->count += 8U;
+        }
+        else
+        {
+            p_inf->more = 1U;
+        }
+    }
+
+    if (0U == p_inf->more)
+    {
+        ret = p_inf->bits & ((((uint32_t) 1U) << need) - 1U);
+        p_inf->bits = p_inf->bits >> need;
+        p_inf->count -= need;
+    }
+    return (ret);
+}
+
+static void model_inflate_build(model_huffman_t *p_huff, const uint8_t *p_lengths, uint32_t num)
+{
+    uint16_t offsets[16U];
+
+    (void) memset(p_huff->count, 0, sizeof(p_huff->count));
+    for (uint32_t index = 0U; index < num; index++)
+    {
+        p_huff->count[p_lengths[index]]++;
+    }
+    p_huff->count[0U] = 0U;
+
+    offsets[1U] = 0U;
+    for (uint32_t len = 1U; len < 15U; len++)
+    {
+        offsets[len + 1U] = offsets[len] + p_huff->count[len];
+    }
+
+    for (uint32_t index = 0U; index < num; index++)
+    {
+        if (0U != p_lengths[index])
+        {
+            p_huff->symbol[offsets[p_lengths[index]]] = (uint16_t) index;
+            offsets[p_lengths[index]]++;
+        }
+    }
+}
+
+/* returns the decoded symbol or -1 for invalid codes and missing input */
+static int32_t model_inflate_decode(model_inflate_t *p_inf, const model_huffman_t *p_huff)
+{
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    int32_t ret = -1;
+
+    for (uint32_t len = 1U; len < 16U; len++)
+    {
+        int32_t count;
+
+        code |= (int32_t) model_inflate_bits(p_inf, 1U);
+        if (0U != p_inf->more)
+        {
+            break;
+        }
+
+        count = (int32_t) p_huff->count[len];
+        if ((code - count) < first)
+        {
+            ret = (int32_t) p_huff->symbol[index + (code - first)];
+            break;
+        }
+        index += count;
+        first += count;
+        first = first * 2;
+        code = code * 2;
+    }
+    return (ret);
+}
+
+static void model_inflate_out(model_inflate_t *p_inf, uint8_t data)
+{
+    model_ram_g[(p_inf->dest + p_inf->out) & MODEL_RAM_G_MASK] = data;
+    p_inf->out++;
+}
+
+static uint8_t model_inflate_codes(model_inflate_t *p_inf, const model_huffman_t *p_lencode, const model_huffman_t *p_distcode)
+{
+    uint8_t ret = MODEL_SCAN_MORE;
+
+    while (MODEL_SCAN_MORE == ret)
+    {
+        int32_t symbol = model_inflate_decode(p_inf, p_lencode);
+
+        if (0U != p_inf->more)
+        {
+            break;
+        }
+
+        if ((symbol < 0) || (symbol > 285))
+        {
+            ret = MODEL_SCAN_ERROR;
+        }
+        else if (symbol < 256)
+        {
+            model_inflate_out(p_inf, (uint8_t) symbol);
+        }
+        else if (256 == symbol)
+        {
+            ret = MODEL_SCAN_DONE;
+        }
+        else
+        {
+            uint32_t length;
+            uint32_t distance;
+
+            symbol -= 257;
+            length = model_length_base[symbol] + model_inflate_bits(p_inf, model_length_extra[symbol]);
+            symbol = model_inflate_decode(p_inf, p_distcode);
+            if (0U != p_inf->more)
+            {
+                break;
+            }
+            if ((symbol < 0) || (symbol > 29))
+            {
+                ret = MODEL_SCAN_ERROR;
+            }
+            else
+            {
+                distance = model_dist_base[symbol] + model_inflate_bits(p_inf, model_dist_extra[symbol]);
+                if (0U != p_inf->more)
+                {
+                    break;
+                }
+                if (distance > p_inf->out)
+                {
+                    ret = MODEL_SCAN_ERROR;
+                }
+                else
+                {
+                    for (; length > 0U; length--)
+                    {
+                        model_inflate_out(p_inf, model_ram_g[(p_inf->dest + p_inf->out - distance) & MODEL_RAM_G_MASK]);
+                    }
+                }
+            }
+        }
+    }
+    return (ret);
+}
+
+static uint8_t model_inflate_stored(model_inflate_t *p_inf)
+{
+    uint8_t ret = MODEL_SCAN_MORE;
+    uint32_t length;
+
+    p_inf->bits = 0U;
+    p_inf->count = 0U;
+    if ((p_inf->pos + 4U) <= p_inf->length)
+    {
+        const uint8_t *p_src = &p_inf->p_src[p_inf->pos];
+
+        length = ((uint32_t) p_src[0U]) | (((uint32_t) p_src[1U]) << 8U);
+        if (length != ((~(((uint32_t) p_src[2U]) | (((uint32_t) p_src[3U]) << 8U))) & 0xffffUL))
+        {
+            ret = MODEL_SCAN_ERROR;
+        }
+        else if ((p_inf->pos + 4U + length) <= p_inf->length)
+        {
+            p_inf->pos += 4U;
+            for (uint32_t index = 0U; index < length; index++)
+            {
+                model_inflate_out(p_inf, p_inf->p_src[p_inf->pos]);
+                p_inf->pos++;
+            }
+            ret = MODEL_SCAN_DONE;
+        }
+        else
+        {
+            p_inf->more = 1U;
+        }
+    }
+    else
+    {
+        p_inf->more = 1U;
+    }
+    return (ret);
+}
+
+static uint8_t model_inflate_fixed(model_inflate_t *p_inf)
+{
+    model_huffman_t lencode;
+    model_huffman_t distcode;
+    uint8_t lengths[288U];
+
+    for (uint32_t index = 0U; index < 288U; index++)
+    {
+        if (index < 144U)
+        {
+            lengths[index] = 8U;
+        }
+        else if (index < 256U)
+        {
+            lengths[index] = 9U;
+        }
+        else if (index < 280U)
+        {
+            lengths[index] = 7U;
+        }
+        else
+        {
+            lengths[index] = 8U;
+        }
+    }
+    model_inflate_build(&lencode, lengths, 288U);
+    (void) memset(lengths, 5, 30U);
+    model_inflate_build(&distcode, lengths, 30U);
+
+    return (model_inflate_codes(p_inf, &lencode, &distcode));
+}
+
+static uint8_t model_inflate_dynamic(model_inflate_t *p_inf)
+{
+    static const uint8_t order[19U] = {16U, 17U, 18U, 0U, 8U, 7U, 9U, 6U, 10U, 5U, 11U, 4U, 12U, 3U, 13U, 2U, 14U, 1U, 15U};
+    model_huffman_t lencode;
+    model_huffman_t distcode;
+    uint8_t lengths[320U];
+    uint32_t nlen;
+    uint32_t ndist;
+    uint32_t ncode;
+    uint32_t index = 0U;
+    uint8_t ret = MODEL_SCAN_MORE;
+
+    nlen = model_inflate_bits(p_inf, 5U) + 257U;
+    ndist = model_inflate_bits(p_inf, 5U) + 1U;
+    ncode = model_inflate_bits(p_inf, 4U) + 4U;
+
+    if ((nlen > 286U) || (ndist > 30U))
+    {
+        ret = MODEL_SCAN_ERROR;
+    }
+    else
+    {
+        for (index = 0U; index < 19U; index++)
+        {
+            lengths[order[index]] = (index < ncode) ? (uint8_t) model_inflate_bits(p_inf, 3U) : 0U;
+        }
+        model_inflate_build(&lencode, lengths, 19U);
+
+        index = 0U;
+        while ((index < (nlen + ndist)) && (MODEL_SCAN_MORE == ret) && (0U == p_inf->more))
+        {
+            int32_t symbol = model_inflate_decode(p_inf, &lencode);
+
+            if (0U != p_inf->more)
+            {
+                break;
+            }
+            if (symbol < 0)
+            {
+                ret = MODEL_SCAN_ERROR;
+            }
+            else if (symbol < 16)
+            {
+                lengths[index] = (uint8_t) symbol;
+                index++;
+            }
+            else
+            {
+                uint8_t len = 0U;
+                uint32_t repeat;
+
+                if (16 == symbol)
+                {
+                    if (0U == index)
+                    {
+                        ret = MODEL_SCAN_ERROR;
+                    }
+                    else
+                    {
+                        len = lengths[index - 1U];
+                    }
+                    repeat = 3U + model_inflate_bits(p_inf, 2U);
+                }
+                else if (17 == symbol)
+                {
+                    repeat = 3U + model_inflate_bits(p_inf, 3U);
+                }
+                else
+                {
+                    repeat = 11U + model_inflate_bits(p_inf, 7U);
+                }
+
+                if ((index + repeat) > (nlen + ndist))
+                {
+                    ret = MODEL_SCAN_ERROR;
+                }
+                else
+                {
+                    for (; repeat > 0U; repeat--)
+                    {
+                        lengths[index] = len;
+                        index++;
+                    }
+                }
+            }
+        }
+
+        if ((MODEL_SCAN_MORE == ret) && (0U == p_inf->more))
+        {
+            if (0U == lengths[256U])
+            {
+                ret = MODEL_SCAN_ERROR;
+            }
+            else
+            {
+                model_inflate_build(&lencode, lengths, nlen);
+                model_inflate_build(&distcode, &lengths[nlen], ndist);
+                ret = model_inflate_codes(p_inf, &lencode, &distcode);
+            }
+        }
+    }
+    return (ret);
+}
+
+/* decompresses a complete zlib stream to RAM_G, returns MODEL_SCAN_MORE if the stream is incomplete */
+static uint8_t model_inflate(const uint8_t *p_src, uint32_t length, uint32_t dest, uint32_t *p_used)
+{
+    model_inflate_t inf;
+    uint8_t ret = MODEL_SCAN_MORE;
+
+    (void) memset(&inf, 0, sizeof(inf));
+    inf.p_src = p_src;
+    inf.length = length;
+    inf.dest = dest;
+
+    if (length >= 2U)
+    {
+        uint32_t header = (((uint32_t) p_src[0U]) << 8U) | p_src[1U];
+
+        if ((8U != (p_src[0U] & 0x0fU)) || (0U != (header % 31U)) || (0U != (p_src[1U] & 0x20U)))
+        {
+            ret = MODEL_SCAN_ERROR;
+        }
+        else
+        {
+            uint32_t last = 0U;
+
+            inf.pos = 2U;
+            while ((0U == last) && (MODEL_SCAN_ERROR != ret) && (0U == inf.more))
+            {
+                uint32_t type;
+
+                last = model_inflate_bits(&inf, 1U);
+                type = model_inflate_bits(&inf, 2U);
+                if (0U != inf.more)
+                {
+                    break;
+                }
+
+                if (0U == type)
+                {
+                    ret = model_inflate_stored(&inf);
+                }
+                else if (1U == type)
+                {
+                    ret = model_inflate_fixed(&inf);
+                }
+                else if (2U == type)
+                {
+                    ret = model_inflate_dynamic(&inf);
+                }
+                else
+                {
+                    ret = MODEL_SCAN_ERROR;
+                }
+            }
+
+            if ((MODEL_SCAN_DONE == ret) && (0U == inf.more))
+            {
+                if ((inf.pos + 4U) > length)
+                {
+                    ret = MODEL_SCAN_MORE;
+                }
+                else
+                {
+                    uint32_t adler_a = 1U;
+                    uint32_t adler_b = 0U;
+
+                    for (uint32_t index = 0U; index < inf.out; index++)
+                    {
+                        adler_a = (adler_a + model_ram_g[(dest + index) & MODEL_RAM_G_MASK]) % 65521UL;
+                        adler_b = (adler_b + adler_a) % 65521UL;
+                    }
+
+                    if (((adler_b << 16U) | adler_a) != model_get32_be(&p_src[inf.pos]))
+                    {
+                        ret = MODEL_SCAN_ERROR;
+                    }
+                    else
+                    {
+                        *p_used = inf.pos + 4U;
+                        model_copro.result_ptr = dest + inf.out;
+                    }
+                }
+            }
+            else if (MODEL_SCAN_ERROR != ret)
+            {
+                ret = MODEL_SCAN_MORE;
+            }
+            else
+            {
+                /* error */
+            }
+        }
+    }
+    return (ret);
+}
+
+/* ################################################################## */
+/* images and video */
+/* ################################################################## */
+
+static uint8_t model_scan_jpeg(const uint8_t *p_src, uint32_t length, uint32_t *p_used, model_image_t *p_image)
+{
+    uint8_t ret = MODEL_SCAN_MORE;
+    uint32_t pos = 2U;
+
+    while ((MODEL_SCAN_MORE == ret) && ((pos + 2U) <= length))
+    {
+        uint8_t marker = p_src[pos + 1U];
+
+        if (0xffU != p_src[pos])
+        {
+            ret = MODEL_SCAN_ERROR;
+        }
+        else if (0xffU == marker)
+        {
+            pos++; /* fill byte */
+        }
+        else if (0xd9U == marker)
+        {
+            *p_used = pos + 2U;
+            ret = MODEL_SCAN_DONE;
+        }
+        else if (((marker >= 0xd0U) && (marker <= 0xd7U)) || (0x01U == marker))
+        {
+            pos += 2U;
+        }
+        else
+        {
+            uint32_t segment;
+
+            if ((pos + 4U) > length)
+            {
+                break;
+            }
+            segment = model_get16_be(&p_src[pos + 2U]);
+
+            if (0xc2U == marker)
+            {
+                ret = MODEL_SCAN_ERROR; /* progressive JPEG is not supported */
+            }
+            else if (((0xc0U == marker) || (0xc1U == marker)) && ((pos + 9U) <= length))
+            {
+                p_image->height = model_get16_be(&p_src[pos + 5U]);
+                p_image->width = model_get16_be(&p_src[pos + 7U]);
+            }
+            else
+            {
+                /* nothing to extract */
+            }
+
+            pos += 2U + segment;
+            if ((0xdaU == marker) && (MODEL_SCAN_MORE == ret))
+            {
+                /* skip the entropy coded data up to the next marker */
+                while (((pos + 1U) < length) && ((0xffU != p_src[pos]) || (0x00U == p_src[pos + 1U])
+                    || ((p_src[pos + 1U] >= 0xd0U) && (p_src[pos + 1U] <= 0xd7U))))
+                {
+                    pos++;
+                }
+            }
+        }
+    }
+    return (ret);
+}
+
+static uint8_t model_scan_png(const uint8_t *p_src, uint32_t length, uint32_t *p_used, model_image_t *p_image)
+{
+    uint8_t ret = MODEL_SCAN_MORE;
+    uint32_t pos = 8U;
+
+    while ((MODEL_SCAN_MORE == ret) && ((pos + 8U) <= length))
+    {
+        uint32_t chunk = model_get32_be(&p_src[pos]);
+
+        if (chunk > 0x7fffffffUL)
+        {
+            ret = MODEL_SCAN_ERROR;
+        }
+        else if (0 == memcmp(&p_src[pos + 4U], "IHDR", 4U))
+        {
+            if ((pos + 18U) > length)
+            {
+                break;
+            }
+            p_image->width = model_get32_be(&p_src[pos + 8U]);
+            p_image->height = model_get32_be(&p_src[pos + 12U]);
+
+            switch (p_src[pos + 17U]) /* colour type */
+            {
+                case 0U:
+                    p_image->format = EVE_L8;
+                    break;
+                case 2U:
+                    p_image->format = EVE_RGB565;
+                    break;
+                case 3U:
+                    p_image->format = (uint8_t) EVE_PALETTED565;
+                    break;
+                default:
+                    p_image->format = EVE_ARGB4;
+                    break;
+            }
+        }
+        else if (0 == memcmp(&p_src[pos + 4U], "IEND", 4U))
+        {
+            if ((pos + 12U) <= length)
+            {
+                *p_used = pos + 12U;
+                ret = MODEL_SCAN_DONE;
+            }
+            break;
+        }
+        else
+        {
+            /* chunk not of interest */
+        }
+        pos += 12U + chunk;
+    }
+    return (ret);
+}
+
+/* looks for the end of a JPEG or PNG file, returns MODEL_SCAN_MORE if the image is incomplete */
+static uint8_t model_scan_image(const uint8_t *p_src, uint32_t length, uint32_t *p_used, model_image_t *p_image)
+{
+    static const uint8_t png_signature[8U] = {0x89U, 0x50U, 0x4eU, 0x47U, 0x0dU, 0x0aU, 0x1aU, 0x0aU};
+    uint8_t ret = MODEL_SCAN_MORE;
+
+    if ((length >= 2U) && (0xffU == p_src[0U]) && (0xd8U == p_src[1U]))
+    {
+        p_image->format = EVE_RGB565;
+        p_image->png = 0U;
+        ret = model_scan_jpeg(p_src, length, p_used, p_image);
+    }
+    else if ((length >= 8U) && (0 == memcmp(p_src, png_signature, 8U)))
+    {
+        p_image->png = 1U;
+        ret = model_scan_png(p_src, length, p_used, p_image);
+    }
+    else if (length >= 8U)
+    {
+        ret = MODEL_SCAN_ERROR;
+    }
+    else
+    {
+        ret = MODEL_SCAN_MORE;
+    }
+    return (ret);
+}
+
+static uint8_t model_scan_video(const uint8_t *p_src, uint32_t length, uint32_t *p_used)
+{
+    uint8_t ret = MODEL_SCAN_MORE;
+
+    if (length >= 8U)
+    {
+        if (0 != memcmp(p_src, "RIFF", 4U))
+        {
+            ret = MODEL_SCAN_ERROR;
+        }
+        else
+        {
+            uint32_t total = model_get32(&p_src[4U]) + 8U;
+
+            if (total <= length)
+            {
+                *p_used = total;
+                ret = MODEL_SCAN_DONE;
+            }
+        }
+    }
+    return (ret);
+}
+
+static void model_image_loaded(const model_image_t *p_image)
+{
+    uint32_t bpp = model_bytes_per_pixel(p_image->format);
+
+    model_copro.bitmap_width = p_image->width;
+    model_copro.bitmap_height = p_image->height;
+    model_copro.bitmap_format = p_image->format;
+    model_copro.result_ptr = model_copro.bitmap_ptr + (p_image->width * p_image->height * bpp);
+
+    if (0U != p_image->png)
+    {
+        /* the decoder uses the top of RAM_G as scratch, whatever was there is gone */
+        (void) memset(&model_ram_g[EVE_RAM_G_SIZE - MODEL_PNG_SCRATCH], 0xa5, MODEL_PNG_SCRATCH);
+    }
+
+    if (0U == (model_copro.stream_options & EVE_OPT_NODL))
+    {
+        model_dl_bitmap(model_copro.bitmap_ptr, p_image->format, p_image->width, p_image->height);
+    }
+}
+
+/* ################################################################## */
+/* co-processor command execution */
+/* ################################################################## */
+
+/* looks for the end of the data in model_stream_buffer after "added" bytes were put there,
+   returns 1 if no further progress is possible right now and in p_consumed how many of the added bytes belong to the data,
+   the data is padded to a multiple of "align" + 1 bytes */
+static uint8_t model_stream_scan(uint32_t added, uint32_t align, uint32_t *p_consumed)
+{
+    uint8_t stop = 0U;
+    uint32_t used = 0U;
+    uint8_t scan;
+    model_image_t image = {0U, 0U, EVE_RGB565, 0U};
+
+    *p_consumed = added;
+
+    if (MODEL_STREAM_INFLATE == model_copro.stream)
+    {
+        scan = model_inflate(model_stream_buffer, model_copro.stream_length, model_copro.stream_address, &used);
+    }
+    else if (MODEL_STREAM_IMAGE == model_copro.stream)
+    {
+        if (0U != (model_copro.stream_options & EVE_OPT_MONO))
+        {
+            image.format = EVE_L8;
+        }
+        scan = model_scan_image(model_stream_buffer, model_copro.stream_length, &used, &image);
+    }
+    else
+    {
+        scan = model_scan_video(model_stream_buffer, model_copro.stream_length, &used);
+    }
+
+    if (MODEL_SCAN_ERROR == scan)
+    {
+        model_fault("corrupted data");
+        stop = 1U;
+    }
+    else if (MODEL_SCAN_DONE == scan)
+    {
+        uint32_t padded = (used + align) & ~align;
+        uint32_t excess = model_copro.stream_length - padded;
+
+        /* the bytes after the end of the data belong to the next commands */
+        *p_consumed = (excess < added) ? (added - excess) : 0U;
+        if (MODEL_STREAM_IMAGE == model_copro.stream)
+        {
+            model_image_loaded(&image);
+        }
+        model_copro.stream = MODEL_STREAM_NONE;
+    }
+    else
+    {
+        /* more data is needed */
+    }
+    return (stop);
+}
+
+/* consumes data following a command, returns 1 if no further progress is possible right now */
+static uint8_t model_stream(uint32_t read, uint32_t available)
+{
+    uint8_t stop = 0U;
+
+    if ((MODEL_STREAM_MEMORY == model_copro.stream)
+        || (MODEL_STREAM_FLASH == model_copro.stream)
+        || (MODEL_STREAM_DISCARD == model_copro.stream))
+    {
+        uint32_t count = (available < model_copro.stream_left) ? available : model_copro.stream_left;
+
+        for (uint32_t index = 0U; index < count; index++)
+        {
+            if (model_copro.stream_payload > 0U)
+            {
+                uint8_t data = model_ram_cmd[(read + index) & MODEL_CMD_MASK];
+
+                if (MODEL_STREAM_MEMORY == model_copro.stream)
+                {
+                    model_store8(model_copro.stream_address, data);
+                }
+                else if (MODEL_STREAM_FLASH == model_copro.stream)
+                {
+                    model_flash[model_copro.stream_address % EVE_MODEL_FLASH_SIZE] = data;
+                }
+                else
+                {
+                    /* discard */
+                }
+                model_copro.stream_address++;
+                model_copro.stream_payload--;
+            }
+        }
+
+        model_copro.stream_left -= count;
+        model_set_reg(REG_CMD_READ, (read + count) & MODEL_CMD_MASK);
+        if (0U == model_copro.stream_left)
+        {
+            model_copro.stream = MODEL_STREAM_NONE;
+        }
+    }
+    else
+    {
+        uint32_t consumed = 0U;
+
+        if ((model_copro.stream_length + available) > MODEL_STREAM_SIZE)
+        {
+            model_fault("stream too long");
+            stop = 1U;
+        }
+        else
+        {
+            for (uint32_t index = 0U; index < available; index++)
+            {
+                model_stream_buffer[model_copro.stream_length] = model_ram_cmd[(read + index) & MODEL_CMD_MASK];
+                model_copro.stream_length++;
+            }
+
+            stop = model_stream_scan(available, 3U, &consumed);
+            if (0U == stop)
+            {
+                model_set_reg(REG_CMD_READ, (read + consumed) & MODEL_CMD_MASK);
+            }
+        }
+    }
+    return (stop);
+}
+
+static void model_start_stream(uint8_t stream, uint32_t address, uint32_t length, uint32_t options)
+{
+    model_copro.stream = stream;
+    model_copro.stream_address = address;
+    model_copro.stream_payload = length;
+    model_copro.stream_left = (length + 3U) & ~((uint32_t) 3U);
+    model_copro.stream_length = 0U;
+    model_copro.stream_options = options;
+
+    if ((0U == model_copro.stream_left)
+        && ((MODEL_STREAM_MEMORY == stream) || (MODEL_STREAM_FLASH == stream) || (MODEL_STREAM_DISCARD == stream)))
+    {
+        model_copro.stream = MODEL_STREAM_NONE;
+    }
+}
+
+/* consumes data from the media FIFO, returns 1 if no further progress is possible right now */
+static uint8_t model_media(void)
+{
+    uint8_t stop = 1U;
+    uint32_t size = model_copro.media_size;
+    uint32_t read = 0U;
+    uint32_t available = 0U;
+
+    if (0U == size)
+    {
+        model_fault("no media FIFO");
+    }
+    else
+    {
+        read = model_reg(REG_MEDIAFIFO_READ) % size;
+        available = ((model_reg(REG_MEDIAFIFO_WRITE) % size) + size - read) % size;
+    }
+
+    if (0U != available)
+    {
+        uint32_t consumed = 0U;
+
+        /* video data is not kept, only the header is needed to find the end */
+        if ((MODEL_STREAM_VIDEO != model_copro.stream) && ((model_copro.stream_length + available) > MODEL_STREAM_SIZE))
+        {
+            model_fault("stream too long");
+        }
+        else
+        {
+            for (uint32_t index = 0U; index < available; index++)
+            {
+                if (model_copro.stream_length < MODEL_STREAM_SIZE)
+                {
+                    model_stream_buffer[model_copro.stream_length] =
+                        model_ram_g[(model_copro.media_base + ((read + index) % size)) % EVE_RAM_G_SIZE];
+                }
+                model_copro.stream_length++;
+            }
+
+            if (0U == model_stream_scan(available, 0U, &consumed))
+            {
+                model_set_reg(REG_MEDIAFIFO_READ, (read + consumed) % size);
+                if (MODEL_STREAM_NONE == model_copro.stream)
+                {
+                    /* the command is done, the co-processor moves on to the next one */
+                    model_copro.media = 0U;
+                    model_set_reg(REG_CMD_READ, model_copro.media_next);
+                    stop = 0U;
+                }
+            }
+        }
+    }
+    return (stop);
+}
+
+#if EVE_GEN > 2
+/* executes data stored in the external flash instead of being sent thru the FIFO */
+static void model_from_flash(uint8_t stream, uint32_t address, uint32_t options)
+{
+    uint32_t used = 0U;
+    uint8_t scan;
+    model_image_t image = {0U, 0U, EVE_RGB565, 0U};
+    uint32_t source = model_copro.flash_source % EVE_MODEL_FLASH_SIZE;
+
+    model_copro.stream_options = options;
+    if (MODEL_STREAM_INFLATE == stream)
+    {
+        scan = model_inflate(&model_flash[source], EVE_MODEL_FLASH_SIZE - source, address, &used);
+    }
+    else
+    {
+        model_copro.bitmap_ptr = address;
+        scan = model_scan_image(&model_flash[source], EVE_MODEL_FLASH_SIZE - source, &used, &image);
+        if (MODEL_SCAN_DONE == scan)
+        {
+            model_image_loaded(&image);
+        }
+    }
+
+    if (MODEL_SCAN_DONE != scan)
+    {
+        model_fault("corrupted data in flash");
+    }
+}
+#endif
+
+static void model_execute(uint32_t command, uint32_t read)
+{
+    uint32_t code = command & 0xffU;
+
+    switch (code)
+    {
+        case (CMD_DLSTART & 0xffU):
+            model_set_reg(REG_CMD_DL, 0U);
+            break;
+
+        case (CMD_SWAP & 0xffU):
+            model_ram_reg[REG_DLSWAP - EVE_RAM_REG] = EVE_DLSWAP_FRAME;
+            model.swap_pending = 1U;
+            break;
+
+        case (CMD_INTERRUPT & 0xffU):
+            model_interrupt(EVE_INT_CMDFLAG);
+            break;
+
+        case (CMD_TEXT & 0xffU):
+            model_dl_widget(model_copro.string_length);
+            break;
+
+        case (CMD_BUTTON & 0xffU):
+        case (CMD_TOGGLE & 0xffU):
+            model_dl_widget(model_commands[code].dl_words + model_copro.string_length);
+            break;
+
+        case (CMD_KEYS & 0xffU):
+            model_dl_widget(12U * model_copro.string_length);
+            break;
+
+        case (CMD_CALIBRATE & 0xffU):
+            model_dl_widget(model_commands[code].dl_words);
+            model_result(read, 1U, 1U);
+            break;
+
+        case (CMD_MEMCRC & 0xffU):
+            model_result(read, 3U, model_crc32(model_param(read, 1U), model_param(read, 2U)));
+            break;
+
+        case (CMD_REGREAD & 0xffU):
+            model_result(read, 2U, model_reg(model_param(read, 1U)));
+            break;
+
+        case (CMD_MEMWRITE & 0xffU):
+            model_start_stream(MODEL_STREAM_MEMORY, model_param(read, 1U), model_param(read, 2U), 0U);
+            break;
+
+        case (CMD_MEMSET & 0xffU):
+        case (CMD_MEMZERO & 0xffU):
+        {
+            uint32_t ptr = model_param(read, 1U);
+            uint32_t value = (code == (CMD_MEMSET & 0xffU)) ? model_param(read, 2U) : 0U;
+            uint32_t num = (code == (CMD_MEMSET & 0xffU)) ? model_param(read, 3U) : model_param(read, 2U);
+
+            for (uint32_t index = 0U; index < num; index++)
+            {
+                model_store8(ptr + index, (uint8_t) value);
+            }
+            break;
+        }
+
+        case (CMD_MEMCPY & 0xffU):
+        {
+            uint32_t dest = model_param(read, 1U);
+            uint32_t src = model_param(read, 2U);
+            uint32_t num = model_param(read, 3U);
+
+            if ((dest < EVE_RAM_G_SIZE) && (src < EVE_RAM_G_SIZE))
+            {
+                (void) memmove(&model_ram_g[dest], &model_ram_g[src],
+                    ((num + dest) > EVE_RAM_G_SIZE) ? (EVE_RAM_G_SIZE - dest) :
+                    (((num + src) > EVE_RAM_G_SIZE) ? (EVE_RAM_G_SIZE - src) : num));
+            }
+            else /* from or to RAM_DL, like for a copy of a display list that is used with CMD_APPEND */
+            {
+                for (uint32_t index = 0U; index < num; index++)
+                {
+                    model_store8(dest + index, model_load8(src + index));
+                }
+            }
+            break;
+        }
+
+        case (CMD_APPEND & 0xffU):
+        {
+            uint32_t ptr = model_param(read, 1U);
+            uint32_t num = model_param(read, 2U);
+
+            for (uint32_t index = 0U; index < num; index += 4U)
+            {
+                model_dl_write(model_get32(&model_ram_g[(ptr + index) & (MODEL_RAM_G_MASK & ~((uint32_t) 3U))]));
+            }
+            break;
+        }
+
+        case (CMD_SNAPSHOT & 0xffU):
+        {
+            uint32_t size = model_reg(REG_HSIZE) * model_reg(REG_VSIZE) * 2U;
+
+            for (uint32_t index = 0U; index < size; index++)
+            {
+                model_store8(model_param(read, 1U) + index, 0U);
+            }
+            break;
+        }
+
+        case (CMD_SNAPSHOT2 & 0xffU):
+        {
+            uint32_t size = (model_param(read, 4U) & 0xffffUL) * (model_param(read, 4U) >> 16U);
+
+            size = size * model_bytes_per_pixel(model_param(read, 1U));
+            for (uint32_t index = 0U; index < size; index++)
+            {
+                model_store8(model_param(read, 2U) + index, 0U);
+            }
+            break;
+        }
+
+        case (CMD_INFLATE & 0xffU):
+            model_start_stream(MODEL_STREAM_INFLATE, model_param(read, 1U), 0U, 0U);
+            break;
+
+#if EVE_GEN > 2
+        case (CMD_INFLATE2 & 0xffU):
+            if (0U != (model_param(read, 2U) & EVE_OPT_FLASH))
+            {
+                model_from_flash(MODEL_STREAM_INFLATE, model_param(read, 1U), model_param(read, 2U));
+            }
+            else
+            {
+                model_start_stream(MODEL_STREAM_INFLATE, model_param(read, 1U), 0U, model_param(read, 2U));
+                model_copro.media = (0U != (model_param(read, 2U) & EVE_OPT_MEDIAFIFO)) ? 1U : 0U;
+            }
+            break;
+#endif
+
+        case (CMD_GETPTR & 0xffU):
+            model_result(read, 1U, model_copro.result_ptr);
+            break;
+
+        case (CMD_LOADIMAGE & 0xffU):
+            model_copro.bitmap_ptr = model_param(read, 1U);
+#if EVE_GEN > 2
+            if (0U != (model_param(read, 2U) & EVE_OPT_FLASH))
+            {
+                model_from_flash(MODEL_STREAM_IMAGE, model_param(read, 1U), model_param(read, 2U));
+            }
+            else
+#endif
+            {
+                model_start_stream(MODEL_STREAM_IMAGE, model_param(read, 1U), 0U, model_param(read, 2U));
+                model_copro.media = (0U != (model_param(read, 2U) & EVE_OPT_MEDIAFIFO)) ? 1U : 0U;
+            }
+            break;
+
+        case (CMD_GETPROPS & 0xffU):
+            model_result(read, 1U, model_copro.bitmap_ptr);
+            model_result(read, 2U, model_copro.bitmap_width);
+            model_result(read, 3U, model_copro.bitmap_height);
+            break;
+
+        case (CMD_SETMATRIX & 0xffU):
+            model_dl_write(DL_BITMAP_TRANSFORM_A | 256UL);
+            model_dl_write(DL_BITMAP_TRANSFORM_B);
+            model_dl_write(DL_BITMAP_TRANSFORM_C);
+            model_dl_write(DL_BITMAP_TRANSFORM_D);
+            model_dl_write(DL_BITMAP_TRANSFORM_E | 256UL);
+            model_dl_write(DL_BITMAP_TRANSFORM_F);
+            break;
+
+        case (CMD_GETMATRIX & 0xffU):
+            model_result(read, 1U, 0x10000UL);
+            model_result(read, 2U, 0U);
+            model_result(read, 3U, 0U);
+            model_result(read, 4U, 0U);
+            model_result(read, 5U, 0x10000UL);
+            model_result(read, 6U, 0U);
+            break;
+
+        case (CMD_MEDIAFIFO & 0xffU):
+            model_copro.media_base = model_param(read, 1U);
+            model_copro.media_size = model_param(read, 2U);
+            model_set_reg(REG_MEDIAFIFO_READ, 0U);
+            model_set_reg(REG_MEDIAFIFO_WRITE, 0U);
+            break;
+
+        case (CMD_PLAYVIDEO & 0xffU):
+            if (0U == (model_param(read, 1U) & MODEL_OPT_FLASH))
+            {
+                model_start_stream(MODEL_STREAM_VIDEO, 0U, 0U, model_param(read, 1U));
+                model_copro.media = (0U != (model_param(read, 1U) & EVE_OPT_MEDIAFIFO)) ? 1U : 0U;
+            }
+            break;
+
+        case (CMD_VIDEOFRAME & 0xffU):
+            model_store8(model_param(read, 2U), 0U); /* no more frames */
+            break;
+
+        case (CMD_SETBITMAP & 0xffU):
+            model_dl_bitmap(model_param(read, 1U), model_param(read, 2U) & 0xffffUL,
+                model_param(read, 2U) >> 16U, model_param(read, 3U) & 0xffffUL);
+            break;
+
+#if EVE_GEN > 2
+        case (CMD_BITMAP_TRANSFORM & 0xffU):
+            model_result(read, 13U, 0xffffffffUL);
+            break;
+
+        case (CMD_FLASHERASE & 0xffU):
+            (void) memset(model_flash, 0xff, EVE_MODEL_FLASH_SIZE);
+            break;
+
+        case (CMD_FLASHWRITE & 0xffU):
+            model_start_stream(MODEL_STREAM_FLASH, model_param(read, 1U), model_param(read, 2U), 0U);
+            break;
+
+        case (CMD_FLASHREAD & 0xffU):
+        {
+            uint32_t dest = model_param(read, 1U);
+            uint32_t src = model_param(read, 2U);
+
+            for (uint32_t index = 0U; index < model_param(read, 3U); index++)
+            {
+                model_store8(dest + index, model_flash[(src + index) % EVE_MODEL_FLASH_SIZE]);
+            }
+            break;
+        }
+
+        case (CMD_FLASHUPDATE & 0xffU):
+        case (0x70U): /* CMD_FLASHPROGRAM */
+        {
+            uint32_t dest = model_param(read, 1U);
+            uint32_t src = model_param(read, 2U);
+
+            for (uint32_t index = 0U; index < model_param(read, 3U); index++)
+            {
+                model_flash[(dest + index) % EVE_MODEL_FLASH_SIZE] = model_load8(src + index);
+            }
+            break;
+        }
+
+        case (CMD_FLASHDETACH & 0xffU):
+            model_set_reg(REG_FLASH_STATUS, EVE_FLASH_STATUS_DETACHED);
+            break;
+
+        case (CMD_FLASHATTACH & 0xffU):
+            model_set_reg(REG_FLASH_STATUS, EVE_FLASH_STATUS_BASIC);
+            break;
+
+        case (CMD_FLASHFAST & 0xffU):
+            model_set_reg(REG_FLASH_STATUS, EVE_FLASH_STATUS_FULL);
+            model_result(read, 1U, 0U);
+            break;
+
+        case (CMD_FLASHSPITX & 0xffU):
+            model_start_stream(MODEL_STREAM_DISCARD, 0U, model_param(read, 1U), 0U);
+            break;
+
+        case (CMD_FLASHSPIRX & 0xffU):
+            for (uint32_t index = 0U; index < model_param(read, 2U); index++)
+            {
+                model_store8(model_param(read, 1U) + index, 0xffU);
+            }
+            break;
+
+        case (CMD_FLASHSOURCE & 0xffU):
+            model_copro.flash_source = model_param(read, 1U);
+            break;
+
+        case (CMD_APPENDF & 0xffU):
+        {
+            uint32_t ptr = model_param(read, 1U);
+
+            for (uint32_t index = 0U; index < model_param(read, 2U); index += 4U)
+            {
+                model_dl_write(model_get32(&model_flash[(ptr + index) % (EVE_MODEL_FLASH_SIZE - 3U)]));
+            }
+            break;
+        }
+#endif
+
+#if EVE_GEN > 3
+        case (CMD_CALIBRATESUB & 0xffU):
+            model_dl_widget(model_commands[code].dl_words);
+            model_result(read, 3U, 1U);
+            break;
+
+        case (CMD_GETIMAGE & 0xffU):
+            model_result(read, 1U, model_copro.bitmap_ptr);
+            model_result(read, 2U, model_copro.bitmap_format);
+            model_result(read, 3U, model_copro.bitmap_width);
+            model_result(read, 4U, model_copro.bitmap_height);
+            model_result(read, 5U, 0U);
+            break;
+
+        case (CMD_PCLKFREQ & 0xffU):
+            model_result(read, 3U, model_param(read, 1U));
+            break;
+
+        case (CMD_FONTCACHEQUERY & 0xffU):
+            model_result(read, 1U, 0U);
+            model_result(read, 2U, 0U);
+            break;
+#endif
+
+        default:
+            model_dl_widget(model_commands[code].dl_words);
+            break;
+    }
+}
+
+/* executes the next command in the FIFO, returns 1 if no further progress is possible right now */
+static uint8_t model_command(uint32_t read, uint32_t available)
+{
+    uint8_t stop = 0U;
+    uint32_t command = model_param(read, 0U);
+
+    if (0xffffff00UL != (command & 0xffffff00UL))
+    {
+        model_dl_write(command);
+        if (0U == model_copro.fault)
+        {
+            model_set_reg(REG_CMD_READ, (read + 4U) & MODEL_CMD_MASK);
+            model_stats.commands++;
+        }
+    }
+    else
+    {
+        uint32_t code = command & 0xffU;
+
+        if ((code >= (sizeof(model_commands) / sizeof(model_commands[0U])))
+            || (0U == model_commands[code].gen)
+            || (model_commands[code].gen > EVE_GEN))
+        {
+            model_fault("illegal command");
+        }
+        else
+        {
+            uint32_t length = 4U + (4U * model_commands[code].params);
+
+            model_copro.string_length = 0U;
+            if ((length <= available) && (0U != (model_commands[code].flags & MODEL_CMD_STRING)))
+            {
+                uint32_t pos = 0U;
+
+                while (((length + pos) < available) && (0U != model_ram_cmd[(read + length + pos) & MODEL_CMD_MASK]))
+                {
+                    pos++;
+                }
+
+                if ((length + pos) >= available)
+                {
+                    length = available + 4U; /* the end of the string is not in the FIFO yet */
+                    if (available >= 0xffcUL)
+                    {
+                        model_fault("string too long");
+                    }
+                }
+                else
+                {
+                    uint32_t options = 0U;
+
+                    model_copro.string_length = pos;
+                    if (code == (CMD_TEXT & 0xffU))
+                    {
+                        options = model_param(read, 2U) >> 16U;
+                    }
+                    else if (code == (CMD_BUTTON & 0xffU))
+                    {
+                        options = model_param(read, 3U) >> 16U;
+                    }
+                    else if (code == (CMD_TOGGLE & 0xffU))
+                    {
+                        options = model_param(read, 3U) & 0xffffUL;
+                    }
+                    else
+                    {
+                        options = 0U;
+                    }
+
+                    length += (pos + 4U) & ~((uint32_t) 3U);
+#if EVE_GEN > 2
+                    if (0U != (options & EVE_OPT_FORMAT))
+                    {
+                        length += 4U * model_format_arguments(read + 4U + (4U * model_commands[code].params), pos);
+                    }
+#else
+                    (void) options;
+#endif
+                }
+            }
+
+            if ((0U != model_copro.fault) || (length > available))
+            {
+                stop = 1U;
+            }
+            else if ((code == (CMD_DLSTART & 0xffU)) && (0U != model.swap_pending))
+            {
+                stop = 1U; /* the co-processor waits for the swap to be executed before writing to RAM_DL again */
+            }
+            else
+            {
+                model_execute(command, read);
+                if (0U != model_copro.media)
+                {
+                    /* REG_CMD_READ stays on the command until all of its data came thru the media FIFO */
+                    model_copro.media_next = (read + length) & MODEL_CMD_MASK;
+                    model_stats.commands++;
+                }
+                else if (0U == model_copro.fault)
+                {
+                    model_set_reg(REG_CMD_READ, (read + length) & MODEL_CMD_MASK);
+                    model_stats.commands++;
+                }
+            }
+        }
+    }
+
+    if (0U != model_copro.fault)
+    {
+        stop = 1U;
+    }
+    return (stop);
+}
+
+static void model_copro_run(void)
+{
+    uint8_t stop = 0U;
+    uint8_t progress = 0U;
+
+    if ((0U == model_copro.running) && (0U != model.active))
+    {
+        model_copro.running = 1U;
+        while (0U == stop)
+        {
+            uint32_t read = model_reg(REG_CMD_READ) & MODEL_CMD_MASK;
+            uint32_t available = model_fifo_fill();
+
+            if ((0U != model_copro.fault) || (0U != (model_ram_reg[REG_CPURESET - EVE_RAM_REG] & 1U)) || (0U == available))
+            {
+                stop = 1U;
+            }
+            else if (0U != model_copro.media)
+            {
+                stop = model_media();
+                progress = 1U;
+            }
+            else if (MODEL_STREAM_NONE != model_copro.stream)
+            {
+                stop = model_stream(read, available);
+                progress = 1U;
+            }
+            else
+            {
+                stop = model_command(read, available);
+                progress = (read != (model_reg(REG_CMD_READ) & MODEL_CMD_MASK)) ? 1U : progress;
+            }
+        }
+
+        if ((0U != progress) && (0U == model_copro.fault) && (0U == model_fifo_fill()))
+        {
+            model_interrupt(EVE_INT_CMDEMPTY);
+        }
+        model_copro.running = 0U;
+    }
+}
+
+static void model_copro_reset(void)
+{
+    model_copro.fault = 0U;
+    model_copro.stream = MODEL_STREAM_NONE;
+    model_copro.media = 0U;
+    model_copro.result_ptr = 0U;
+    model_copro.flash_source = 0U;
+}
+
+/* ################################################################## */
+/* display and time */
+/* ################################################################## */
+
+static void model_swap(void)
+{
+    model.swap_pending = 0U;
+    model_ram_reg[REG_DLSWAP - EVE_RAM_REG] = EVE_DLSWAP_DONE;
+    model_stats.swaps++;
+    model_interrupt(EVE_INT_SWAP);
+}
+
+/* returns the duration of a frame in ns or 0 if the display is not running */
+static uint64_t model_frame_time(void)
+{
+    uint64_t ret = 0U;
+    uint32_t pclk = model_reg(REG_PCLK) & 0xffUL;
+    uint64_t cycles = ((uint64_t) (model_reg(REG_HCYCLE) & 0xfffUL)) * (model_reg(REG_VCYCLE) & 0xfffUL);
+
+    if ((0U != pclk) && (0U != cycles))
+    {
+#if EVE_GEN > 3
+        if (1U == pclk)
+        {
+            ret = MODEL_FRAME_DEFAULT; /* extsync mode, the pixel clock is set by REG_PCLK_FREQ */
+        }
+        else
+#endif
+        {
+            uint64_t frequency = model_reg(REG_FREQUENCY);
+
+            ret = (0U != frequency) ? ((cycles * pclk * 1000000000ULL) / frequency) : MODEL_FRAME_DEFAULT;
+        }
+    }
+    return (ret);
+}
+
+static void model_advance_ns(uint64_t nsec)
+{
+    uint64_t frame = model_frame_time();
+
+    model.time_ns += nsec;
+
+    if (0U != model.active)
+    {
+        uint64_t frequency = model_reg(REG_FREQUENCY);
+
+        model.clock_ns += nsec;
+        if (model.clock_ns >= 1000U)
+        {
+            model_set_reg(REG_CLOCK, model_reg(REG_CLOCK) + (uint32_t) (((model.clock_ns / 1000U) * frequency) / 1000000U));
+            model.clock_ns = model.clock_ns % 1000U;
+        }
+
+        if (0U == frame)
+        {
+            model.frame_ns = 0U;
+            if (0U != model.swap_pending)
+            {
+                model_swap(); /* no display running, no need to wait for the next frame */
+            }
+        }
+        else
+        {
+            model.frame_ns += nsec;
+            while (model.frame_ns >= frame)
+            {
+                model.frame_ns -= frame;
+                model_set_reg(REG_FRAMES, model_reg(REG_FRAMES) + 1U);
+                if (0U != model.swap_pending)
+                {
+                    model_swap();
+                }
+            }
+        }
+
+        if (0U == model_spi.selected)
+        {
+            model_copro_run();
+        }
+    }
+}
+
+/* ################################################################## */
+/* SPI */
+/* ################################################################## */
+
+static void model_reset_registers(void)
+{
+#if EVE_GEN > 3
+    static const uint8_t chipid[4U] = {0x08U, 0x17U, 0x01U, 0x00U};
+#elif EVE_GEN > 2
+    static const uint8_t chipid[4U] = {0x08U, 0x15U, 0x01U, 0x00U};
+#else
+    static const uint8_t chipid[4U] = {0x08U, 0x13U, 0x01U, 0x00U};
+#endif
+
+    (void) memcpy(&model_ram_g[EVE_ROM_CHIPID], chipid, sizeof(chipid)); /* the chip-id is in RAM_G after a reset */
+    (void) memset(model_ram_dl, 0, EVE_RAM_DL_SIZE);
+    (void) memset(model_ram_reg, 0, MODEL_RAM_REG_SIZE);
+    (void) memset(model_ram_reg2, 0, MODEL_RAM_REG_SIZE);
+    (void) memset(model_ram_cmd, 0, EVE_CMDFIFO_SIZE);
+    model.spi_width = 0U; /* single SPI */
+
+    model_set_reg(REG_FREQUENCY, 60000000UL);
+    model_set_reg(REG_PWM_DUTY, 128U);
+    model_set_reg(REG_PWM_HZ, 250U);
+    model_set_reg(REG_TOUCH_RAW_XY, 0xffffffffUL);
+    model_set_reg(REG_TOUCH_SCREEN_XY, 0x80008000UL);
+    model_set_reg(REG_TOUCH_TAG_XY, 0x80008000UL);
+    model_set_reg(REG_TOUCH_DIRECT_XY, 0x80008000UL);
+    model_set_reg(REG_TOUCH_TRANSFORM_A, 0x10000UL);
+    model_set_reg(REG_TOUCH_TRANSFORM_E, 0x10000UL);
+    model_set_reg(REG_CTOUCH_TOUCH1_XY, 0x80008000UL);
+    model_set_reg(REG_CTOUCH_TOUCH4_Y, 0x8000UL);
+    model_set_reg(REG_CTOUCH_TOUCH4_X, 0x8000UL);
+    model_set_reg(REG_CTOUCH_TOUCH2_XY, 0x80008000UL);
+    model_set_reg(REG_CTOUCH_TOUCH3_XY, 0x80008000UL);
+    model_set_reg(REG_INT_MASK, 0xffU);
+    model.int_active = 0U;
+#if EVE_GEN > 2
+    model_set_reg(REG_FLASH_STATUS, EVE_FLASH_STATUS_BASIC);
+    model_set_reg(REG_FLASH_SIZE, EVE_MODEL_FLASH_SIZE / (1024UL * 1024UL));
+#endif
+
+    model.swap_pending = 0U;
+    model.frame_ns = 0U;
+    model_copro_reset();
+}
+
+static void model_host_command(uint8_t command)
+{
+    if (EVE_ACTIVE == command)
+    {
+        if (0U == model.active)
+        {
+            model.active = 1U;
+            model_ram_reg[REG_ID - EVE_RAM_REG] = 0x7cU;
+        }
+    }
+    else if ((EVE_STANDBY == command) || (EVE_SLEEP == command) || (EVE_PWRDOWN == command))
+    {
+        model.active = 0U;
+    }
+    else if (EVE_RST_PULSE == command)
+    {
+        model_reset_registers();
+        model_ram_reg[REG_ID - EVE_RAM_REG] = (0U != model.active) ? 0x7cU : 0U;
+    }
+    else
+    {
+        /* clock selection and pin configuration have no effect on the model */
+    }
+}
+
+static uint8_t model_read8(uint32_t address)
+{
+    uint8_t ret = 0U;
+
+    if ((address >= REG_CMDB_SPACE) && (address < (REG_CMDB_SPACE + 4U)))
+    {
+        ret = (uint8_t) (model_cmdb_space() >> (8U * (address - REG_CMDB_SPACE)));
+    }
+    else if (REG_INT_FLAGS == address)
+    {
+        ret = model_ram_reg[REG_INT_FLAGS - EVE_RAM_REG];
+        model_ram_reg[REG_INT_FLAGS - EVE_RAM_REG] = 0U; /* read to clear */
+        model_int_update();
+    }
+    else
+    {
+        ret = model_load8(address);
+    }
+    return (ret);
+}
+
+static void model_write8(uint32_t address, uint8_t data)
+{
+    if (REG_CMDB_WRITE == address)
+    {
+        uint32_t write = model_reg(REG_CMD_WRITE) & MODEL_CMD_MASK;
+
+        if ((0U == model_spi.fifo_bytes) && (model_fifo_fill() >= 0xffcUL))
+        {
+            if (0U == model.lazy)
+            {
+                model_copro_run();
+            }
+            if (model_fifo_fill() >= 0xffcUL)
+            {
+                model_stats.fifo_overflows++;
+            }
+        }
+
+        model_ram_cmd[(write + model_spi.fifo_bytes) & MODEL_CMD_MASK] = data;
+        model_stats.fifo_bytes++;
+        model_spi.fifo_bytes++;
+        if (4U == model_spi.fifo_bytes)
+        {
+            model_spi.fifo_bytes = 0U;
+            model_set_reg(REG_CMD_WRITE, (write + 4U) & MODEL_CMD_MASK);
+        }
+    }
+    else if ((address < EVE_RAM_G_SIZE)
+        || ((address >= EVE_RAM_DL) && (address < (EVE_RAM_DL + EVE_RAM_DL_SIZE)))
+        || ((address >= EVE_RAM_CMD) && (address < (EVE_RAM_CMD + EVE_CMDFIFO_SIZE))))
+    {
+        model_store8(address, data);
+    }
+    else if (((address >= EVE_RAM_REG) && (address < (EVE_RAM_REG + MODEL_RAM_REG_SIZE)))
+        || ((address >= MODEL_RAM_REG2) && (address < (MODEL_RAM_REG2 + MODEL_RAM_REG_SIZE))))
+    {
+        if ((address < (REG_ID + 4U)) || ((address >= REG_CMDB_SPACE) && (address < (REG_CMDB_SPACE + 4U))))
+        {
+            model_stats.protocol_errors++; /* read-only */
+        }
+        else if (REG_CPURESET == address)
+        {
+            uint8_t previous = model_ram_reg[REG_CPURESET - EVE_RAM_REG];
+
+            model_ram_reg[REG_CPURESET - EVE_RAM_REG] = data;
+            if ((0U != (previous & 1U)) && (0U == (data & 1U)))
+            {
+                model_copro_reset(); /* co-processor released from reset */
+            }
+        }
+        else if (REG_DLSWAP == address)
+        {
+            model_ram_reg[REG_DLSWAP - EVE_RAM_REG] = data;
+            if (EVE_DLSWAP_DONE != (data & 3U))
+            {
+                model.swap_pending = 1U;
+                if (0U == model_frame_time())
+                {
+                    model_swap();
+                }
+            }
+        }
+        else if ((REG_INT_EN == address) || (REG_INT_MASK == address))
+        {
+            model_store8(address, data);
+            model_int_update();
+        }
+        else
+        {
+            model_store8(address, data);
+        }
+    }
+    else
+    {
+        model_stats.protocol_errors++;
+    }
+}
+
+/* ################################################################## */
+/* API */
+/* ################################################################## */
+
+/**
+ * @brief Puts the model in the state of a chip with the power just applied, clears the statistics.
+ * @note - The external flash is erased.
+ */
+void EVE_model_reset(void)
+{
+    (void) memset(&model, 0, sizeof(model));
+    (void) memset(&model_spi, 0, sizeof(model_spi));
+    (void) memset(&model_copro, 0, sizeof(model_copro));
+    (void) memset(&model_stats, 0, sizeof(model_stats));
+    (void) memset(model_ram_g, 0, EVE_RAM_G_SIZE);
+    (void) memset(model_flash, 0xff, EVE_MODEL_FLASH_SIZE);
+    model_reset_registers();
+    model.initialized = 1U;
+}
+
+static void model_init(void)
+{
+    if (0U == model.initialized)
+    {
+        EVE_model_reset();
+    }
+}
+
+/**
+ * @brief Sets the level of the PD pin, a falling edge turns off EVE.
+ */
+void EVE_model_pdn(uint8_t level)
+{
+    model_init();
+    if (0U == level)
+    {
+        model.powered = 0U;
+        model.active = 0U;
+    }
+    else if (0U == model.powered)
+    {
+        model.powered = 1U;
+        model_reset_registers();
+    }
+    else
+    {
+        /* no change */
+    }
+}
+
+void EVE_model_cs_set(void)
+{
+    model_init();
+    if (0U != model_spi.selected)
+    {
+        model_stats.protocol_errors++;
+    }
+    model_spi.selected = 1U;
+    model_spi.state = MODEL_SPI_HEADER;
+    model_spi.count = 0U;
+    model_spi.fifo_bytes = 0U;
+}
+
+void EVE_model_cs_clear(void)
+{
+    if (0U == model_spi.selected)
+    {
+        model_stats.protocol_errors++;
+    }
+    else
+    {
+        model_stats.cs_cycles++;
+        model_spi.selected = 0U;
+
+        if ((MODEL_SPI_DUMMY == model_spi.state) && (3U == model_spi.count)
+            && (0U == model_spi.header[0U]) && (0U == model_spi.header[1U]) && (0U == model_spi.header[2U]))
+        {
+            if (0U != model.powered)
+            {
+                model_host_command(EVE_ACTIVE);
+            }
+        }
+        else if (MODEL_SPI_HOSTCMD == model_spi.state)
+        {
+            if (0U != model.powered)
+            {
+                model_host_command(model_spi.header[0U]);
+            }
+        }
+        else if ((model_spi.count < 3U) || (0U != model_spi.fifo_bytes))
+        {
+            model_stats.protocol_errors++; /* incomplete header or incomplete 32 bit word for the FIFO */
+        }
+        else
+        {
+            /* regular end of a memory transfer */
+            model.spi_width = model_ram_reg[REG_SPI_WIDTH - EVE_RAM_REG] & 3U;
+        }
+
+        model_copro_run();
+    }
+}
+
+/**
+ * @brief Transfers one byte in both directions.
+ * @return the byte EVE is sending at the same time
+ */
+uint8_t EVE_model_transfer(uint8_t mosi)
+{
+    uint8_t ret = 0U;
+    uint8_t data = mosi;
+    uint8_t miso_error = 0U;
+
+    model_stats.spi_bytes++;
+
+    if ((0U != model_spi_limit) && (model_host_clock > model_spi_limit))
+    {
+        model_spi_noise++;
+        if (0U == (model_spi_noise & 7U)) /* every 8th byte has a bit flipped, in both directions */
+        {
+            data ^= 0x01U;
+            miso_error = 0x80U;
+            model_stats.bit_errors++;
+        }
+    }
+
+    if (0U == model_spi.selected)
+    {
+        model_stats.protocol_errors++;
+    }
+    else if (model_host_lines != (uint8_t) (1U << model.spi_width))
+    {
+        model_stats.protocol_errors++; /* the bits end up on the wrong lines */
+        ret = 0xffU;
+    }
+    else if (MODEL_SPI_HEADER == model_spi.state)
+    {
+        model_spi.header[model_spi.count] = data;
+        model_spi.count++;
+        if (3U == model_spi.count)
+        {
+            model_spi.address = (((uint32_t) model_spi.header[0U] & 0x3fUL) << 16U)
+                | (((uint32_t) model_spi.header[1U]) << 8U) | model_spi.header[2U];
+
+            if (0x80U == (model_spi.header[0U] & 0xc0U))
+            {
+                model_spi.state = MODEL_SPI_WRITE;
+            }
+            else if (0x00U == (model_spi.header[0U] & 0xc0U))
+            {
+                model_spi.state = MODEL_SPI_DUMMY;
+            }
+            else
+            {
+                model_spi.state = MODEL_SPI_HOSTCMD;
+            }
+        }
+    }
+    else
+    {
+        model_spi.count++;
+        if ((0U == model.active) && (MODEL_SPI_HOSTCMD != model_spi.state))
+        {
+            /* nobody home */
+        }
+        else if (MODEL_SPI_WRITE == model_spi.state)
+        {
+            model_write8(model_spi.address, data);
+            if (REG_CMDB_WRITE != model_spi.address)
+            {
+                model_spi.address++;
+            }
+        }
+        else if (MODEL_SPI_DUMMY == model_spi.state)
+        {
+            model_spi.state = MODEL_SPI_READ;
+        }
+        else if (MODEL_SPI_READ == model_spi.state)
+        {
+            ret = model_read8(model_spi.address);
+            model_spi.address++;
+        }
+        else
+        {
+            /* the third byte of host commands is ignored */
+        }
+    }
+
+    model_advance_ns((8000000000ULL / model_host_clock) / model_host_lines);
+    return (ret ^ miso_error);
+}
+
+/**
+ * @brief Connects chip-select and the SPI to one of EVE_MODEL_INSTANCES instances of the model,
+ * like the host would do with one chip-select for each EVE.
+ * @note - Only the selected instance runs, the one that is selected catches up with the time
+ * that passed for the last selected one.
+ * @note - The statistics and the hook for INT_N are kept for each instance.
+ */
+void EVE_model_select(uint8_t instance)
+{
+#if EVE_MODEL_INSTANCES > 1
+    if ((instance < EVE_MODEL_INSTANCES) && (instance != model_instance))
+    {
+        uint64_t time_ns = model.time_ns;
+
+        model_instances[model_instance].chip = model;
+        model_instances[model_instance].spi = model_spi;
+        model_instances[model_instance].copro = model_copro;
+        model_instances[model_instance].stats = model_stats;
+        model_instances[model_instance].int_hook = model_int_hook;
+
+        model_instance = instance;
+        model = model_instances[instance].chip;
+        model_spi = model_instances[instance].spi;
+        model_copro = model_instances[instance].copro;
+        model_stats = model_instances[instance].stats;
+        model_int_hook = model_instances[instance].int_hook;
+
+        model_ram_g = model_ram_g_banks[instance];
+        model_ram_dl = model_ram_dl_banks[instance];
+        model_ram_reg = model_ram_reg_banks[instance];
+        model_ram_reg2 = model_ram_reg2_banks[instance];
+        model_ram_cmd = model_ram_cmd_banks[instance];
+        model_flash = model_flash_banks[instance];
+        model_stream_buffer = model_stream_banks[instance];
+
+        model_init();
+        if (time_ns > model.time_ns)
+        {
+            model_advance_ns(time_ns - model.time_ns);
+        }
+    }
+#else
+    (void) instance;
+#endif
+}
+
+/**
+ * @brief Sets the number of data lines the host is using for the SPI, 1, 2 or 4.
+ * @note - Every byte that is transferred while this does not match REG_SPI_WIDTH of the model
+ * is counted as a protocol error and ignored, the model returns 0xff then.
+ * @note - A byte takes 8 / lines clock cycles.
+ */
+void EVE_model_spi_width(uint8_t lines)
+{
+    model_host_lines = lines;
+}
+
+/**
+ * @brief Sets the SPI clock of the host in Hz, the time in the model advances by the time
+ * it takes to transfer a byte at this clock.
+ */
+void EVE_model_spi_clock(uint32_t hz)
+{
+    if (0U != hz)
+    {
+        model_host_clock = hz;
+    }
+}
+
+/**
+ * @brief Sets the fastest SPI clock in Hz that the connection to the host works with, 0 for no limit.
+ * @note - Above the limit every 8th byte is damaged, bit 0 of what the host sends and bit 7 of what
+ * the model sends back is flipped, this is counted in bit_errors.
+ * @note - The limit is not changed by a reset.
+ */
+void EVE_model_spi_limit(uint32_t hz)
+{
+    model_spi_limit = hz;
+}
+
+/**
+ * @brief Lets the time in the model pass.
+ */
+void EVE_model_advance_us(uint32_t usec)
+{
+    model_init();
+    model_advance_ns(((uint64_t) usec) * 1000U);
+}
+
+/**
+ * @brief Selects when the co-processor executes commands.
+ * @note - lazy = 0 is the default, the co-processor runs between transactions and
+ * @note - also frees space when the FIFO is full during a transaction.
+ * @note - lazy = 1: the co-processor only runs between transactions, this is the worst case
+ * @note - of a co-processor that is busy with something else, overruns are counted in fifo_overflows.
+ */
+void EVE_model_set_lazy(uint8_t lazy)
+{
+    model_init();
+    model.lazy = lazy;
+}
+
+void EVE_model_get_stats(EVE_model_stats_t *p_stats)
+{
+    if (p_stats != NULL)
+    {
+        *p_stats = model_stats;
+    }
+}
+
+void EVE_model_clear_stats(void)
+{
+    (void) memset(&model_stats, 0, sizeof(model_stats));
+}
+
+/**
+ * @brief Reads from the memory of the model without any SPI traffic and without side-effects.
+ * @note - Addresses starting with EVE_RAM_FLASH read from the external flash.
+ */
+uint32_t EVE_model_peek32(uint32_t address)
+{
+    uint32_t ret;
+
+    model_init();
+    if ((address >= MODEL_RAM_FLASH) && ((address - MODEL_RAM_FLASH) <= (EVE_MODEL_FLASH_SIZE - 4U)))
+    {
+        ret = model_get32(&model_flash[address - MODEL_RAM_FLASH]);
+    }
+    else if (REG_CMDB_SPACE == address)
+    {
+        ret = model_cmdb_space();
+    }
+    else
+    {
+        ret = model_reg(address);
+    }
+    return (ret);
+}
+
+/**
+ * @brief Writes to the memory of the model without any SPI traffic and without side-effects,
+ * for example to simulate a touch.
+ */
+void EVE_model_poke32(uint32_t address, uint32_t data)
+{
+    model_init();
+    model_set_reg(address, data);
+}
+
+/**
+ * @brief Sets the function that is called for a falling edge on INT_N, like an external interrupt of the host would.
+ * @note - The hook is called from within the SPI transfer or EVE_model_advance_us() that caused the edge.
+ */
+void EVE_model_set_int_hook(void (*p_hook)(void))
+{
+    model_init();
+    model_int_hook = p_hook;
+}
+
+/**
+ * @brief Simulates a touch at the screen coordinates in xy, 0x80008000 for no touch, on an object with the tag value tag.
+ * @note - This sets REG_TOUCH_SCREEN_XY, REG_TOUCH_TAG_XY and REG_TOUCH_TAG and raises INT_TOUCH
+ * and INT_TAG if the tag changed.
+ */
+void EVE_model_touch(uint32_t xy, uint8_t tag)
+{
+    uint8_t flags = 0U;
+
+    model_init();
+    if (0x80008000UL != xy)
+    {
+        flags |= EVE_INT_TOUCH;
+    }
+    if (model_reg(REG_TOUCH_TAG) != tag)
+    {
+        flags |= EVE_INT_TAG;
+    }
+    model_set_reg(REG_TOUCH_SCREEN_XY, xy);
+    model_set_reg(REG_TOUCH_TAG_XY, xy);
+    model_set_reg(REG_TOUCH_TAG, tag);
+    model_interrupt(flags);
+}
+
+/**
+ * @brief Simulates one of the five touch points of a capacitive touch controller in extended mode,
+ * point 0 is the same as EVE_model_touch().
+ * @note - This sets REG_CTOUCH_TOUCHn_XY, REG_TOUCH_TAGn_XY and REG_TOUCH_TAGn and raises INT_TOUCH for a touch.
+ */
+void EVE_model_touch_point(uint8_t point, uint32_t xy, uint8_t tag)
+{
+    static const uint32_t xy_regs[4U] = {REG_CTOUCH_TOUCH1_XY, REG_CTOUCH_TOUCH2_XY, REG_CTOUCH_TOUCH3_XY, 0U};
+
+    if (0U == point)
+    {
+        EVE_model_touch(xy, tag);
+    }
+    else if (point < 5U)
+    {
+        model_init();
+        if (4U == point)
+        {
+            model_set_reg(REG_CTOUCH_TOUCH4_X, xy >> 16U);
+            model_set_reg(REG_CTOUCH_TOUCH4_Y, xy & 0xffffUL);
+        }
+        else
+        {
+            model_set_reg(xy_regs[point - 1U], xy);
+        }
+        model_set_reg(REG_TOUCH_TAG1_XY + ((point - 1U) * 8U), xy);
+        model_set_reg(REG_TOUCH_TAG1 + ((point - 1U) * 8U), tag);
+        model_interrupt((0x80008000UL != xy) ? EVE_INT_TOUCH : 0U);
+    }
+    else
+    {
+    }
+}
+
+/**
+ * @brief Writes data to the external flash, for example to put a flash image in place before EVE_init().
+ */
+void EVE_model_flash_load(uint32_t offset, const uint8_t *p_data, uint32_t length)
+{
+    model_init();
+    if ((p_data != NULL) && (offset < EVE_MODEL_FLASH_SIZE))
+    {
+        uint32_t count = (uint32_t) (((EVE_MODEL_FLASH_SIZE - offset) < length) ? (EVE_MODEL_FLASH_SIZE - offset) : length);
+
+        (void) memcpy(&model_flash[offset], p_data, count);
+    }
+}
+
+#endif /* SOFTWARE_TEST */
@@ -0,0 +1,452 @@
+/*
+@file    EVE_static_dl.h
+@brief   C++17 compile-time builder for static display lists
+@version 5.0
+@date    2024-01-20
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2024 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+/* The display-list commands from EVE.h as constexpr functions so that a static display list
+  is encoded by the compiler into a constant array instead of by the controller at runtime.
+
+  constexpr auto background = EVE_static_dl::make_list(
+      EVE_static_dl::CLEAR_COLOR_RGB(0xc0U, 0xc0U, 0xc0U),
+      EVE_static_dl::CLEAR(1U, 1U, 1U),
+      EVE_static_dl::VERTEX_FORMAT(0U),
+      EVE_static_dl::BEGIN(EVE_RECTS),
+      EVE_static_dl::VERTEX2F(0, 0),
+      EVE_static_dl::VERTEX2F(EVE_HSIZE, 40),
+      EVE_static_dl::END());
+
+  static_assert(background.words[4U] == 0x40000000UL);
+
+  The list is written to RAM_G once with EVE_static_dl::write() and then added to every
+  display list with EVE_static_dl::append() / EVE_static_dl::append_burst(), which is a single CMD_APPEND.
+  Lists can be combined with EVE_static_dl::concat().
+  Only display-list commands can be used, co-processor commands like CMD_TEXT need the co-processor
+  to be executed.
+
+  The encoders follow the programming guide and are checked against it at the end of this file,
+  unlike the functions in EVE.h these take the full width of every field, BITMAP_LAYOUT() takes a 9 bit height
+  and BITMAP_TRANSFORM_C() / BITMAP_TRANSFORM_F() take 24 bits.
+  This needs to be compiled with -std=c++17 or newer, for older standards this file is empty.
+*/
+
+#ifndef EVE_STATIC_DL_H
+#define EVE_STATIC_DL_H
+
+#include "EVE.h"
+
+#if defined (__cplusplus) && (__cplusplus >= 201703L)
+
+#include <cstddef>
+
+namespace EVE_static_dl
+{
+
+/* a display list of N 32 bit words */
+template <std::size_t N>
+struct list_t
+{
+    uint32_t words[N];
+
+    static constexpr std::size_t size = N; /* number of words */
+    static constexpr uint32_t bytes = static_cast<uint32_t>(N * 4U);
+
+    constexpr uint32_t operator[](std::size_t index) const
+    {
+        return (words[index]);
+    }
+};
+
+/**
+ * @brief Build a display list from the words returned by the encoders below.
+ */
+template <typename... T>
+constexpr list_t<sizeof...(T)> make_list(T... words)
+{
+    return (list_t<sizeof...(T)> {{static_cast<uint32_t>(words)...}});
+}
+
+/**
+ * @brief Build a display list from two lists, the words of "first" followed by the words of "second".
+ */
+template <std::size_t A, std::size_t B>
+constexpr list_t<A + B> concat(const list_t<A> &first, const list_t<B> &second)
+{
+    list_t<A + B> result {};
+
+    for (std::size_t index = 0U; index < A; index++)
+    {
+        result.words[index] = first.words[index];
+    }
+    for (std::size_t index = 0U; index < B; index++)
+    {
+        result.words[A + index] = second.words[index];
+    }
+    return (result);
+}
+
+/* ##################################################################
+    encoders
+##################################################################### */
+
+constexpr uint32_t ALPHA_FUNC(uint8_t func, uint8_t ref)
+{
+    return (DL_ALPHA_FUNC | ((func & 7UL) << 8U) | ref);
+}
+
+constexpr uint32_t BEGIN(uint8_t prim)
+{
+    return (DL_BEGIN | (prim & 15UL));
+}
+
+constexpr uint32_t BITMAP_HANDLE(uint8_t handle)
+{
+    return (DL_BITMAP_HANDLE | (handle & 0x1FUL));
+}
+
+constexpr uint32_t BITMAP_LAYOUT(uint8_t format, uint16_t linestride, uint16_t height)
+{
+    return (DL_BITMAP_LAYOUT | ((format & 0x1FUL) << 19U) | ((linestride & 0x3FFUL) << 9U) | (height & 0x1FFUL));
+}
+
+constexpr uint32_t BITMAP_LAYOUT_H(uint16_t linestride, uint16_t height)
+{
+    return (DL_BITMAP_LAYOUT_H | (((linestride >> 10U) & 3UL) << 2U) | ((height >> 9U) & 3UL));
+}
+
+constexpr uint32_t BITMAP_SIZE(uint8_t filter, uint8_t wrapx, uint8_t wrapy, uint16_t width, uint16_t height)
+{
+    return (DL_BITMAP_SIZE | ((filter & 1UL) << 20U) | ((wrapx & 1UL) << 19U) | ((wrapy & 1UL) << 18U)
+        | ((width & 0x1FFUL) << 9U) | (height & 0x1FFUL));
+}
+
+constexpr uint32_t BITMAP_SIZE_H(uint16_t width, uint16_t height)
+{
+    return (DL_BITMAP_SIZE_H | (((width >> 9U) & 3UL) << 2U) | ((height >> 9U) & 3UL));
+}
+
+constexpr uint32_t BITMAP_SOURCE(uint32_t addr)
+{
+    return (DL_BITMAP_SOURCE | (addr & 0x3FFFFFUL));
+}
+
+constexpr uint32_t BITMAP_TRANSFORM_A(uint32_t val)
+{
+    return (DL_BITMAP_TRANSFORM_A | (val & 0x1FFFFUL));
+}
+
+constexpr uint32_t BITMAP_TRANSFORM_B(uint32_t val)
+{
+    return (DL_BITMAP_TRANSFORM_B | (val & 0x1FFFFUL));
+}
+
+constexpr uint32_t BITMAP_TRANSFORM_C(uint32_t val)
+{
+    return (DL_BITMAP_TRANSFORM_C | (val & 0xFFFFFFUL));
+}
+
+constexpr uint32_t BITMAP_TRANSFORM_D(uint32_t val)
+{
+    return (DL_BITMAP_TRANSFORM_D | (val & 0x1FFFFUL));
+}
+
+constexpr uint32_t BITMAP_TRANSFORM_E(uint32_t val)
+{
+    return (DL_BITMAP_TRANSFORM_E | (val & 0x1FFFFUL));
+}
+
+constexpr uint32_t BITMAP_TRANSFORM_F(uint32_t val)
+{
+    return (DL_BITMAP_TRANSFORM_F | (val & 0xFFFFFFUL));
+}
+
+constexpr uint32_t BLEND_FUNC(uint8_t src, uint8_t dst)
+{
+    return (DL_BLEND_FUNC | ((src & 7UL) << 3U) | (dst & 7UL));
+}
+
+constexpr uint32_t CALL(uint16_t dest)
+{
+    return (DL_CALL | (dest & 0x7FFUL));
+}
+
+constexpr uint32_t CELL(uint8_t cell)
+{
+    return (DL_CELL | (cell & 0x7FUL));
+}
+
+constexpr uint32_t CLEAR(uint8_t color, uint8_t stencil, uint8_t tag)
+{
+    return (DL_CLEAR | ((color & 1UL) << 2U) | ((stencil & 1UL) << 1U) | (tag & 1UL));
+}
+
+constexpr uint32_t CLEAR_COLOR_A(uint8_t alpha)
+{
+    return (DL_CLEAR_COLOR_A | alpha);
+}
+
+constexpr uint32_t CLEAR_COLOR_RGB(uint8_t red, uint8_t green, uint8_t blue)
+{
+    return (DL_CLEAR_COLOR_RGB | (static_cast<uint32_t>(red) << 16U) | (static_cast<uint32_t>(green) << 8U) | blue);
+}
+
+constexpr uint32_t CLEAR_STENCIL(uint8_t val)
+{
+    return (DL_CLEAR_STENCIL | val);
+}
+
+constexpr uint32_t CLEAR_TAG(uint8_t val)
+{
+    return (DL_CLEAR_TAG | val);
+}
+
+constexpr uint32_t COLOR_A(uint8_t alpha)
+{
+    return (DL_COLOR_A | alpha);
+}
+
+constexpr uint32_t COLOR_MASK(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+    return (DL_COLOR_MASK | ((red & 1UL) << 3U) | ((green & 1UL) << 2U) | ((blue & 1UL) << 1U) | (alpha & 1UL));
+}
+
+constexpr uint32_t COLOR_RGB(uint8_t red, uint8_t green, uint8_t blue)
+{
+    return (DL_COLOR_RGB | (static_cast<uint32_t>(red) << 16U) | (static_cast<uint32_t>(green) << 8U) | blue);
+}
+
+constexpr uint32_t DISPLAY()
+{
+    return (DL_DISPLAY);
+}
+
+constexpr uint32_t END()
+{
+    return (DL_END);
+}
+
+constexpr uint32_t JUMP(uint16_t dest)
+{
+    return (DL_JUMP | (dest & 0x7FFUL));
+}
+
+constexpr uint32_t LINE_WIDTH(uint16_t width)
+{
+    return (DL_LINE_WIDTH | (width & 0xFFFUL));
+}
+
+constexpr uint32_t MACRO(uint8_t macro)
+{
+    return (DL_MACRO | (macro & 1UL));
+}
+
+constexpr uint32_t NOP()
+{
+    return (DL_NOP);
+}
+
+constexpr uint32_t PALETTE_SOURCE(uint32_t addr)
+{
+    return (DL_PALETTE_SOURCE | (addr & 0x3FFFFFUL));
+}
+
+constexpr uint32_t POINT_SIZE(uint16_t size)
+{
+    return (DL_POINT_SIZE | (size & 0x1FFFUL));
+}
+
+constexpr uint32_t RESTORE_CONTEXT()
+{
+    return (DL_RESTORE_CONTEXT);
+}
+
+constexpr uint32_t RETURN()
+{
+    return (DL_RETURN);
+}
+
+constexpr uint32_t SAVE_CONTEXT()
+{
+    return (DL_SAVE_CONTEXT);
+}
+
+constexpr uint32_t SCISSOR_SIZE(uint16_t width, uint16_t height)
+{
+    return (DL_SCISSOR_SIZE | ((width & 0xFFFUL) << 12U) | (height & 0xFFFUL));
+}
+
+constexpr uint32_t SCISSOR_XY(uint16_t xc0, uint16_t yc0)
+{
+    return (DL_SCISSOR_XY | ((xc0 & 0x7FFUL) << 11U) | (yc0 & 0x7FFUL));
+}
+
+constexpr uint32_t STENCIL_FUNC(uint8_t func, uint8_t ref, uint8_t mask)
+{
+    return (DL_STENCIL_FUNC | ((func & 7UL) << 16U) | (static_cast<uint32_t>(ref) << 8U) | mask);
+}
+
+constexpr uint32_t STENCIL_MASK(uint8_t mask)
+{
+    return (DL_STENCIL_MASK | mask);
+}
+
+constexpr uint32_t STENCIL_OP(uint8_t sfail, uint8_t spass)
+{
+    return (DL_STENCIL_OP | ((sfail & 7UL) << 3U) | (spass & 7UL));
+}
+
+constexpr uint32_t TAG(uint8_t tagval)
+{
+    return (DL_TAG | tagval);
+}
+
+constexpr uint32_t TAG_MASK(uint8_t mask)
+{
+    return (DL_TAG_MASK | (mask & 1UL));
+}
+
+constexpr uint32_t VERTEX2F(int16_t xc0, int16_t yc0)
+{
+    return (DL_VERTEX2F | ((static_cast<uint16_t>(xc0) & 0x7FFFUL) << 15U) | (static_cast<uint16_t>(yc0) & 0x7FFFUL));
+}
+
+constexpr uint32_t VERTEX2II(uint16_t xc0, uint16_t yc0, uint8_t handle, uint8_t cell)
+{
+    return (DL_VERTEX2II | ((xc0 & 0x1FFUL) << 21U) | ((yc0 & 0x1FFUL) << 12U) | ((handle & 0x1FUL) << 7U) | (cell & 0x7FUL));
+}
+
+constexpr uint32_t VERTEX_FORMAT(uint8_t frac)
+{
+    return (DL_VERTEX_FORMAT | (frac & 7UL));
+}
+
+constexpr uint32_t VERTEX_TRANSLATE_X(int32_t xco)
+{
+    return (DL_VERTEX_TRANSLATE_X | (static_cast<uint32_t>(xco) & 0x1FFFFUL));
+}
+
+constexpr uint32_t VERTEX_TRANSLATE_Y(int32_t yco)
+{
+    return (DL_VERTEX_TRANSLATE_Y | (static_cast<uint32_t>(yco) & 0x1FFFFUL));
+}
+
+/* EVE3: BT815 / BT816 */
+#if EVE_GEN > 2
+
+constexpr uint32_t BITMAP_EXT_FORMAT(uint16_t format)
+{
+    return (DL_BITMAP_EXT_FORMAT | format);
+}
+
+constexpr uint32_t BITMAP_SWIZZLE(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+    return (DL_BITMAP_SWIZZLE | ((red & 7UL) << 9U) | ((green & 7UL) << 6U) | ((blue & 7UL) << 3U) | (alpha & 7UL));
+}
+
+constexpr uint32_t BITMAP_TRANSFORM_A(uint8_t prc, uint32_t val)
+{
+    return (DL_BITMAP_TRANSFORM_A | ((prc & 1UL) << 17U) | (val & 0x1FFFFUL));
+}
+
+constexpr uint32_t BITMAP_TRANSFORM_B(uint8_t prc, uint32_t val)
+{
+    return (DL_BITMAP_TRANSFORM_B | ((prc & 1UL) << 17U) | (val & 0x1FFFFUL));
+}
+
+constexpr uint32_t BITMAP_TRANSFORM_D(uint8_t prc, uint32_t val)
+{
+    return (DL_BITMAP_TRANSFORM_D | ((prc & 1UL) << 17U) | (val & 0x1FFFFUL));
+}
+
+constexpr uint32_t BITMAP_TRANSFORM_E(uint8_t prc, uint32_t val)
+{
+    return (DL_BITMAP_TRANSFORM_E | ((prc & 1UL) << 17U) | (val & 0x1FFFFUL));
+}
+
+#endif /* EVE_GEN > 2 */
+
+/* ##################################################################
+    transfer to EVE
+##################################################################### */
+
+/**
+ * @brief Write the list to memory of EVE, usually to RAM_G for CMD_APPEND, in a single SPI transfer.
+ * @note - Meant to be called once outside display-list building.
+ * @note - The words are sent as they are in memory, this needs a little-endian host like every target of this library.
+ * @note - With AVR the list has to be declared PROGMEM as this reads it with fetch_flash_byte().
+ */
+template <std::size_t N>
+inline void write(uint32_t address, const list_t<N> &list)
+{
+    EVE_memWrite_flash_buffer(address, reinterpret_cast<const uint8_t *>(list.words), list_t<N>::bytes);
+}
+
+/**
+ * @brief Add the list that was written to RAM_G at "address" to the display list with CMD_APPEND.
+ */
+template <std::size_t N>
+inline void append(uint32_t address, const list_t<N> &list)
+{
+    (void) list;
+    EVE_cmd_append(address, list_t<N>::bytes);
+}
+
+/**
+ * @brief Add the list that was written to RAM_G at "address" to the display list with CMD_APPEND.
+ */
+template <std::size_t N>
+inline void append_burst(uint32_t address, const list_t<N> &list)
+{
+    (void) list;
+    EVE_cmd_append_burst(address, list_t<N>::bytes);
+}
+
+/* ##################################################################
+    checks against the encodings in the programming guide
+##################################################################### */
+
+static_assert(VERTEX2F(1, 2) == 0x40008002UL, "VERTEX2F");
+static_assert(VERTEX2F(-1, -1) == 0x7FFFFFFFUL, "VERTEX2F negative");
+static_assert(VERTEX2II(511U, 511U, 31U, 127U) == 0xBFFFFFFFUL, "VERTEX2II");
+static_assert(BITMAP_SIZE(1U, 1U, 1U, 511U, 2U) == 0x081FFE02UL, "BITMAP_SIZE");
+static_assert(BITMAP_LAYOUT(EVE_RGB565, 200U, 300U) == 0x0739912CUL, "BITMAP_LAYOUT");
+static_assert(COLOR_RGB(0x12U, 0x34U, 0x56U) == 0x04123456UL, "COLOR_RGB");
+static_assert(CLEAR(1U, 1U, 1U) == 0x26000007UL, "CLEAR");
+static_assert(concat(make_list(DISPLAY()), make_list(END(), NOP())).words[2U] == DL_NOP, "concat");
+
+} /* namespace EVE_static_dl */
+
+#endif /* C++17 */
+
+#endif /* EVE_STATIC_DL_H */
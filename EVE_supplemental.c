@@ -32,6 +32,27 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 5.0
 - added EVE_polar_cartesian()
+- added retained display-list segments: EVE_segment_init(), EVE_segment_update(), EVE_segment_invalidate(),
+    EVE_segment_append(), EVE_segment_append_burst() and EVE_segment_release_all()
+- added a heap for RAM_G: EVE_ram_init(), EVE_ram_alloc(), EVE_ram_free(), EVE_ram_address(), EVE_ram_compact()
+    and EVE_ram_get_stats()
+- changed the retained segments to take their space from the RAM_G heap, removed EVE_segment_release_all()
+- added a least-recently-used cache for assets from the external flash of BT81x: EVE_asset_init(), EVE_asset_load()
+    and EVE_asset_address()
+- added text fields that are formatted on the host and only sent as CMD_TEXT when they changed: EVE_text_init(),
+    EVE_text_set(), EVE_text_set_int(), EVE_text_update(), EVE_text_burst(), EVE_text_calibrate() and EVE_text_get_stats()
+- added touch events with debounce, drag, long-press and swipe for up to five fingers that are only sampled
+    after a touch interrupt: EVE_touch_init(), EVE_touch_service(), EVE_touch_get_event() and EVE_touch_get_stats()
+- added scrolling lists that only put the rows in their window in the display list as recorded segments:
+    EVE_list_init(), EVE_list_window(), EVE_list_set_rows(), EVE_list_invalidate(), EVE_list_drag(), EVE_list_release(),
+    EVE_list_track(), EVE_list_row_at(), EVE_list_update() and EVE_list_burst()
+- added charts that keep their samples in a ring in RAM_G and show it as scrolling BARGRAPH bitmaps of up to 256 samples:
+    EVE_chart_init(), EVE_chart_free(), EVE_chart_line(), EVE_chart_add(), EVE_chart_add_block(), EVE_chart_clear()
+    and EVE_chart_burst()
+- added frame pacing that sends a frame right after a display refresh started and lowers the frame rate
+    when frames miss their refresh: EVE_pace_init(), EVE_pace_service(), EVE_pace_sent() and EVE_pace_get_stats()
+- added text fields that are shown as CMD_BUTTON or CMD_TOGGLE: EVE_text_init_button(), EVE_text_init_toggle()
+    and EVE_text_set_state()
 
 */
 
@@ -139,3 +160,2017 @@ void EVE_polar_cartesian(uint16_t length, uint16_t angle, int16_t *p_xc0, int16_
         *p_yc0 = (int16_t) calc;
     }
 }
+
+/* ##################################################################
+    RAM_G heap
+################################################################### */
+
+typedef struct
+{
+    uint32_t address;
+    uint32_t size; /* 0 for an unused entry */
+    uint32_t align;
+} ram_block_t;
+
+static ram_block_t ram_blocks[EVE_RAM_BLOCKS]; /* the handle for ram_blocks[n] is n + 1 */
+static uint32_t ram_end = EVE_RAM_G_SIZE;
+static uint16_t ram_moves = 0U; /* incremented by EVE_ram_compact() when it moved something */
+static uint8_t ram_generation = 0U; /* incremented by EVE_ram_init(), handles from before are invalid */
+
+static uint32_t ram_align_up(uint32_t address, uint32_t align)
+{
+    return ((address + (align - 1UL)) & ~(align - 1UL));
+}
+
+/* returns the index of the allocated block with the lowest address at or above "from", EVE_RAM_BLOCKS if there is none */
+static uint8_t ram_next_block(uint32_t from)
+{
+    uint8_t ret = EVE_RAM_BLOCKS;
+
+    for (uint8_t index = 0U; index < EVE_RAM_BLOCKS; index++)
+    {
+        if ((0UL != ram_blocks[index].size) && (ram_blocks[index].address >= from))
+        {
+            if ((EVE_RAM_BLOCKS == ret) || (ram_blocks[index].address < ram_blocks[ret].address))
+            {
+                ret = index;
+            }
+        }
+    }
+    return (ret);
+}
+
+/* returns the address of the first gap that fits "size" with "align", EVE_RAM_NONE if there is none */
+static uint32_t ram_find_gap(uint32_t size, uint32_t align)
+{
+    uint32_t ret = EVE_RAM_NONE;
+    uint32_t cursor = 0UL;
+    uint8_t done = 0U;
+
+    while (0U == done)
+    {
+        uint8_t next = ram_next_block(cursor);
+        uint32_t gap_end = (EVE_RAM_BLOCKS == next) ? ram_end : ram_blocks[next].address;
+        uint32_t address = ram_align_up(cursor, align);
+
+        if ((address < gap_end) && (size <= (gap_end - address)))
+        {
+            ret = address;
+            done = 1U;
+        }
+        else if (EVE_RAM_BLOCKS == next)
+        {
+            done = 1U;
+        }
+        else
+        {
+            cursor = ram_blocks[next].address + ram_blocks[next].size;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Reset the heap for RAM_G, all blocks are released.
+ * @param options - EVE_RAM_KEEP_PNG_SCRATCH to leave out the top 42kiB of RAM_G that EVE_cmd_loadimage() overwrites
+ * when it decodes a PNG, 0 to use all of RAM_G
+ * @note - Meant to be called after EVE_init() as the content of RAM_G is gone then, handles from before
+ * are invalid and the retained segments get new blocks with their next EVE_segment_update().
+ */
+void EVE_ram_init(uint8_t options)
+{
+    for (uint8_t index = 0U; index < EVE_RAM_BLOCKS; index++)
+    {
+        ram_blocks[index].size = 0UL;
+    }
+
+    ram_end = EVE_RAM_G_SIZE;
+    if (0U != (options & EVE_RAM_KEEP_PNG_SCRATCH))
+    {
+        ram_end -= EVE_RAM_PNG_SCRATCH;
+    }
+    ram_generation++;
+}
+
+/**
+ * @brief Allocate a block in RAM_G, first fit from the lowest address on.
+ * @param size - bytes, rounded up to a multiple of 4
+ * @param align - alignment of the start address, a power of two, values below 4 are treated as 4
+ * @return - the handle for the block, 0 if there is no gap for it or no free entry in the block table
+ * @note - Use EVE_ram_address() to get the address, it changes when EVE_ram_compact() moves the block.
+ */
+uint8_t EVE_ram_alloc(uint32_t size, uint32_t align)
+{
+    uint8_t ret = 0U;
+    uint8_t index = 0U;
+    uint32_t block_align = ((align < 4UL) || (0UL != (align & (align - 1UL)))) ? 4UL : align;
+    uint32_t block_size = ram_align_up(size, 4UL);
+
+    while ((index < EVE_RAM_BLOCKS) && (0UL != ram_blocks[index].size))
+    {
+        index++;
+    }
+
+    if ((index < EVE_RAM_BLOCKS) && (0UL != block_size))
+    {
+        uint32_t address = ram_find_gap(block_size, block_align);
+
+        if (EVE_RAM_NONE != address)
+        {
+            ram_blocks[index].address = address;
+            ram_blocks[index].size = block_size;
+            ram_blocks[index].align = block_align;
+            ret = index + 1U;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Release a block, nothing happens for 0 or a handle that is not allocated.
+ */
+void EVE_ram_free(uint8_t handle)
+{
+    if ((handle > 0U) && (handle <= EVE_RAM_BLOCKS))
+    {
+        ram_blocks[handle - 1U].size = 0UL;
+    }
+}
+
+/**
+ * @brief Get the current address of a block.
+ * @return - the address in RAM_G, EVE_RAM_NONE if the handle is not allocated
+ */
+uint32_t EVE_ram_address(uint8_t handle)
+{
+    uint32_t ret = EVE_RAM_NONE;
+
+    if ((handle > 0U) && (handle <= EVE_RAM_BLOCKS) && (0UL != ram_blocks[handle - 1U].size))
+    {
+        ret = ram_blocks[handle - 1U].address;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Move all blocks down to close the gaps between them, the data is moved with CMD_MEMCPY.
+ * @return - the number of blocks that were moved
+ * @note - Meant to be called outside display-list building, between screens, this waits for EVE to be idle.
+ * @note - Everything that uses the address of a block that was moved needs to be set up again,
+ * like bitmaps and fonts, the retained segments are recorded again by their next EVE_segment_update().
+ * @note - A block is moved in steps no larger than the distance it moves as the source and destination
+ * of CMD_MEMCPY must not overlap, a large block that moves only a little takes many steps.
+ */
+uint8_t EVE_ram_compact(void)
+{
+    uint8_t moved = 0U;
+    uint32_t cursor = 0UL;
+    uint8_t next;
+
+    EVE_execute_cmd();
+
+    next = ram_next_block(0UL);
+    while (next < EVE_RAM_BLOCKS)
+    {
+        ram_block_t *p_block = &ram_blocks[next];
+        uint32_t dest = ram_align_up(cursor, p_block->align);
+
+        if (dest < p_block->address)
+        {
+            uint32_t distance = p_block->address - dest;
+
+            for (uint32_t offset = 0UL; offset < p_block->size; offset += distance)
+            {
+                uint32_t num = ((p_block->size - offset) < distance) ? (p_block->size - offset) : distance;
+
+                EVE_cmd_memcpy(dest + offset, p_block->address + offset, num);
+            }
+            p_block->address = dest;
+            moved++;
+        }
+
+        cursor = p_block->address + p_block->size;
+        next = ram_next_block(cursor);
+    }
+
+    if (0U != moved)
+    {
+        ram_moves++;
+    }
+    return (moved);
+}
+
+/**
+ * @brief Get the size of the heap, the bytes in use, the largest free block and the fragmentation.
+ */
+void EVE_ram_get_stats(EVE_ram_stats_t *p_stats)
+{
+    if (p_stats != NULL)
+    {
+        uint32_t cursor = 0UL;
+        uint32_t free_bytes;
+        uint8_t next;
+
+        p_stats->size = ram_end;
+        p_stats->used = 0UL;
+        p_stats->largest_free = 0UL;
+        p_stats->blocks = 0U;
+
+        do
+        {
+            uint32_t gap_end;
+
+            next = ram_next_block(cursor);
+            gap_end = (EVE_RAM_BLOCKS == next) ? ram_end : ram_blocks[next].address;
+            if ((gap_end > cursor) && ((gap_end - cursor) > p_stats->largest_free))
+            {
+                p_stats->largest_free = gap_end - cursor;
+            }
+
+            if (next < EVE_RAM_BLOCKS)
+            {
+                p_stats->used += ram_blocks[next].size;
+                p_stats->blocks++;
+                cursor = ram_blocks[next].address + ram_blocks[next].size;
+            }
+        } while (next < EVE_RAM_BLOCKS);
+
+        free_bytes = ram_end - p_stats->used;
+        p_stats->fragmentation = (0UL == free_bytes) ? 0U :
+            (uint8_t) (100UL - ((p_stats->largest_free * 100UL) / free_bytes));
+    }
+}
+
+/* ##################################################################
+    cache for assets from the external flash
+################################################################### */
+
+#if EVE_GEN > 2
+
+#define ASSET_READ_UNIT 4096UL /* CMD_FLASHREAD commands are split at the 4kiB boundaries of the flash */
+
+typedef struct
+{
+    uint32_t last_used; /* value of asset_clock the last time the asset was drawn or loaded */
+    uint16_t asset_id;
+    uint8_t handle; /* the block in the RAM_G heap, 0 for an unused slot */
+} asset_slot_t;
+
+static const EVE_asset_t *p_asset_table = NULL;
+static uint16_t asset_count = 0U;
+static asset_slot_t asset_slots[EVE_ASSET_SLOTS];
+static uint32_t asset_clock = 0UL;
+static uint8_t asset_generation = 0U; /* the slots are only valid while this matches the generation of the heap */
+
+/* returns the slot for the asset if it is in RAM_G, EVE_ASSET_SLOTS if not */
+static uint8_t asset_find(uint16_t asset_id)
+{
+    uint8_t ret = EVE_ASSET_SLOTS;
+
+    if (asset_generation != ram_generation)
+    {
+        for (uint8_t index = 0U; index < EVE_ASSET_SLOTS; index++)
+        {
+            asset_slots[index].handle = 0U; /* the heap was reset */
+        }
+        asset_generation = ram_generation;
+    }
+
+    for (uint8_t index = 0U; index < EVE_ASSET_SLOTS; index++)
+    {
+        if ((0U != asset_slots[index].handle) && (asset_id == asset_slots[index].asset_id))
+        {
+            ret = index;
+        }
+    }
+    return (ret);
+}
+
+/* releases the least recently used asset that was not used since "since", returns 0 if there is none */
+static uint8_t asset_evict(uint32_t since)
+{
+    uint8_t victim = EVE_ASSET_SLOTS;
+
+    for (uint8_t index = 0U; index < EVE_ASSET_SLOTS; index++)
+    {
+        if ((0U != asset_slots[index].handle) && (asset_slots[index].last_used < since))
+        {
+            if ((EVE_ASSET_SLOTS == victim) || (asset_slots[index].last_used < asset_slots[victim].last_used))
+            {
+                victim = index;
+            }
+        }
+    }
+
+    if (victim < EVE_ASSET_SLOTS)
+    {
+        EVE_ram_free(asset_slots[victim].handle);
+        asset_slots[victim].handle = 0U;
+    }
+    return ((victim < EVE_ASSET_SLOTS) ? 1U : 0U);
+}
+
+/* gets a block for the asset, evicts the least recently used assets and compacts the heap if necessary */
+static uint8_t asset_alloc(uint32_t size, uint32_t since)
+{
+    uint8_t handle = EVE_ram_alloc(size, 4UL);
+    uint8_t compacted = 0U;
+
+    while ((0U == handle) && (0U == compacted))
+    {
+        if (0U == asset_evict(since))
+        {
+            compacted = 1U; /* nothing left to evict, the free space may be in pieces */
+            (void) EVE_ram_compact();
+        }
+        handle = EVE_ram_alloc(size, 4UL);
+    }
+    return (handle);
+}
+
+/* writes the CMD_FLASHREAD commands for an asset to the CMD-FIFO, split at the 4kiB boundaries of the flash */
+static void asset_read(uint32_t dest, uint32_t src, uint32_t size)
+{
+    uint32_t offset = 0UL;
+    uint32_t length = (size + 3UL) & ~3UL;
+
+    while (offset < length)
+    {
+        uint32_t num = ASSET_READ_UNIT - ((src + offset) & (ASSET_READ_UNIT - 1UL));
+
+        if (num > (length - offset))
+        {
+            num = length - offset;
+        }
+
+        uint32_t const words[4U] = {CMD_FLASHREAD, dest + offset, src + offset, num};
+
+        EVE_cmd_words_burst(words, 4UL);
+        offset += num;
+    }
+}
+
+/**
+ * @brief Set the table of the assets in the external flash, an asset is identified by its index in the table.
+ * @note - The table is not copied and has to stay in place.
+ * @note - Assets that are in RAM_G from a previous table are released.
+ */
+void EVE_asset_init(const EVE_asset_t *p_assets, uint16_t count)
+{
+    for (uint8_t index = 0U; index < EVE_ASSET_SLOTS; index++)
+    {
+        if ((asset_generation == ram_generation) && (0U != asset_slots[index].handle))
+        {
+            EVE_ram_free(asset_slots[index].handle);
+        }
+        asset_slots[index].handle = 0U;
+    }
+    asset_generation = ram_generation;
+    p_asset_table = p_assets;
+    asset_count = (NULL == p_assets) ? 0U : count;
+}
+
+/**
+ * @brief Make sure the assets in the list are in RAM_G, like all the bitmaps for the next screen.
+ * Assets that are missing get a block from the RAM_G heap, the least recently drawn assets that are not
+ * in the list are evicted to make room, the heap is compacted if that is not enough.
+ * The CMD_FLASHREAD commands for all missing assets are sent in one burst and executed together.
+ * @return - E_OK - if all assets are either in RAM_G or can be used directly from the flash
+ * @return - E_NOT_OK - if an asset that can not be used from the flash did not fit or the id is not in the table
+ * @note - Assets that can be used directly from the flash stay there when they do not fit.
+ * @note - The flash needs to be in full speed mode, see EVE_init_flash().
+ * @note - Meant to be called outside display-list building, this waits for the reads to complete.
+ */
+uint8_t EVE_asset_load(const uint16_t *p_ids, uint8_t count)
+{
+    uint8_t ret = E_OK;
+    uint8_t burst = 0U;
+    uint32_t since;
+
+    asset_clock++;
+    since = asset_clock; /* everything in the list is marked with this and is not evicted by this call */
+
+    for (uint8_t index = 0U; (p_ids != NULL) && (index < count); index++)
+    {
+        uint8_t slot = asset_find(p_ids[index]);
+
+        if (slot < EVE_ASSET_SLOTS)
+        {
+            asset_slots[slot].last_used = since;
+        }
+    }
+
+    for (uint8_t index = 0U; (p_ids != NULL) && (index < count); index++)
+    {
+        uint16_t asset_id = p_ids[index];
+
+        if (asset_id >= asset_count)
+        {
+            ret = E_NOT_OK;
+        }
+        else if (asset_find(asset_id) >= EVE_ASSET_SLOTS)
+        {
+            uint8_t slot = 0U;
+            uint8_t handle = 0U;
+
+            while ((slot < EVE_ASSET_SLOTS) && (0U != asset_slots[slot].handle))
+            {
+                slot++;
+            }
+
+            if ((slot >= EVE_ASSET_SLOTS) && (0U != asset_evict(since)))
+            {
+                slot = 0U;
+                while (0U != asset_slots[slot].handle)
+                {
+                    slot++;
+                }
+            }
+
+            if (slot < EVE_ASSET_SLOTS)
+            {
+                if (0U != burst)
+                {
+                    EVE_end_cmd_burst(); /* the heap may be compacted, that uses the CMD-FIFO */
+                    burst = 0U;
+                }
+                handle = asset_alloc(p_asset_table[asset_id].size, since);
+            }
+
+            if (0U != handle)
+            {
+                asset_slots[slot].asset_id = asset_id;
+                asset_slots[slot].handle = handle;
+                asset_slots[slot].last_used = since;
+
+                EVE_start_cmd_burst();
+                burst = 1U;
+                asset_read(EVE_ram_address(handle), p_asset_table[asset_id].flash_address, p_asset_table[asset_id].size);
+            }
+            else if (0U == p_asset_table[asset_id].direct)
+            {
+                ret = E_NOT_OK;
+            }
+            else
+            {
+                /* stays in the flash */
+            }
+        }
+        else
+        {
+            /* is in RAM_G already */
+        }
+    }
+
+    if (0U != burst)
+    {
+        EVE_end_cmd_burst();
+    }
+    EVE_execute_cmd();
+    return (ret);
+}
+
+/**
+ * @brief Get the address to draw an asset from and mark it as recently used.
+ * @return - the address in RAM_G if the asset is there
+ * @return - the address for BITMAP_SOURCE in the flash, 0x800000 | (flash_address / 32), if the asset
+ * is not in RAM_G and can be used directly from the flash
+ * @return - EVE_RAM_NONE if the asset is not available
+ */
+uint32_t EVE_asset_address(uint16_t asset_id)
+{
+    uint32_t ret = EVE_RAM_NONE;
+    uint8_t slot = asset_find(asset_id);
+
+    if (slot < EVE_ASSET_SLOTS)
+    {
+        asset_clock++;
+        asset_slots[slot].last_used = asset_clock;
+        ret = EVE_ram_address(asset_slots[slot].handle);
+    }
+    else if ((asset_id < asset_count) && (0U != p_asset_table[asset_id].direct))
+    {
+        ret = 0x800000UL | (p_asset_table[asset_id].flash_address / 32UL);
+    }
+    else
+    {
+        /* not available */
+    }
+    return (ret);
+}
+
+#endif /* EVE_GEN > 2 */
+
+/* ##################################################################
+    retained display-list segments
+################################################################### */
+
+/**
+ * @brief Prepare a segment, nothing is recorded until the first EVE_segment_update().
+ * @param p_build - the function that writes the commands of the segment, without CMD_DLSTART and without DL_DISPLAY
+ */
+void EVE_segment_init(EVE_segment_t *p_segment, EVE_segment_build_t p_build)
+{
+    if (p_segment != NULL)
+    {
+        p_segment->p_build = p_build;
+        p_segment->inputs = 0UL;
+        p_segment->capacity = 0U;
+        p_segment->length = 0U;
+        p_segment->moves = ram_moves;
+        p_segment->handle = 0U;
+        p_segment->generation = ram_generation;
+    }
+}
+
+/**
+ * @brief Record the segment if it was not recorded yet, was invalidated, if inputs changed
+ * or if EVE_ram_compact() moved any blocks since.
+ * Recording executes the build function in a display list of its own, reads the length from REG_CMD_DL
+ * and copies the result from RAM_DL to a block from the RAM_G heap with CMD_MEMCPY.
+ * @param inputs - anything that changes the result of the build function, like a hash over the data it uses
+ * @return - E_OK - if the copy in RAM_G is up to date
+ * @return - E_NOT_OK - if there is no build function or no room in the heap, the segment stays empty
+ * and is left out by EVE_segment_append_burst()
+ * @note - Meant to be called outside display-list building, this waits for EVE to be idle, before and after recording.
+ * @note - The block for a segment is the length of the first recording plus 25%, when a later recording
+ * does not fit the block is released and a larger one is allocated.
+ */
+uint8_t EVE_segment_update(EVE_segment_t *p_segment, uint32_t inputs)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((p_segment != NULL) && (p_segment->p_build != NULL))
+    {
+        if (p_segment->generation != ram_generation)
+        {
+            p_segment->handle = 0U; /* the heap was reset */
+            p_segment->capacity = 0U;
+            p_segment->length = 0U;
+            p_segment->generation = ram_generation;
+        }
+
+        if ((0U != p_segment->length) && (inputs == p_segment->inputs) && (ram_moves == p_segment->moves))
+        {
+            ret = E_OK;
+        }
+        else
+        {
+            uint16_t length;
+
+            p_segment->length = 0U;
+            EVE_execute_cmd();
+            EVE_cmd_dl(CMD_DLSTART);
+            p_segment->p_build();
+            EVE_execute_cmd();
+            length = EVE_memRead16(REG_CMD_DL);
+
+            if (length > p_segment->capacity)
+            {
+                uint32_t capacity = (((uint32_t) length + (length / 4U)) + 63UL) & ~63UL;
+
+                EVE_ram_free(p_segment->handle);
+                p_segment->handle = EVE_ram_alloc(capacity, 4UL);
+                p_segment->capacity = (0U != p_segment->handle) ? (uint16_t) capacity : 0U;
+            }
+
+            if ((0U != length) && (length <= p_segment->capacity))
+            {
+                EVE_cmd_memcpy(EVE_ram_address(p_segment->handle), EVE_RAM_DL, length);
+                p_segment->length = length;
+                p_segment->inputs = inputs;
+                p_segment->moves = ram_moves;
+                ret = E_OK;
+            }
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Make the next EVE_segment_update() record the segment again.
+ */
+void EVE_segment_invalidate(EVE_segment_t *p_segment)
+{
+    if (p_segment != NULL)
+    {
+        p_segment->length = 0U;
+    }
+}
+
+/**
+ * @brief Add the recorded segment to the display list with CMD_APPEND, nothing is added for an empty segment.
+ */
+void EVE_segment_append(const EVE_segment_t *p_segment)
+{
+    if ((p_segment != NULL) && (0U != p_segment->length) && (p_segment->generation == ram_generation))
+    {
+        EVE_cmd_append(EVE_ram_address(p_segment->handle), p_segment->length);
+    }
+}
+
+/**
+ * @brief Add the recorded segment to the display list with CMD_APPEND, nothing is added for an empty segment.
+ */
+void EVE_segment_append_burst(const EVE_segment_t *p_segment)
+{
+    if ((p_segment != NULL) && (0U != p_segment->length) && (p_segment->generation == ram_generation))
+    {
+        EVE_cmd_append_burst(EVE_ram_address(p_segment->handle), p_segment->length);
+    }
+}
+
+/* ##################################################################
+    text fields
+################################################################### */
+
+static const EVE_text_t *p_text_current = NULL; /* the field text_build() records */
+static EVE_text_stats_t text_stats = {0UL, 0UL, 0UL, 0UL, 0UL, 0UL};
+static uint32_t text_saving = 0UL; /* REG_CLOCK ticks per field, measured by EVE_text_calibrate() */
+
+/* the widget of a field */
+#define TEXT_TEXT 0U
+#define TEXT_BUTTON 1U
+#define TEXT_TOGGLE 2U
+
+/* the command for the widget of the field, burst-mode or not */
+static void text_send(const EVE_text_t *p_text, uint8_t burst)
+{
+    if (TEXT_BUTTON == p_text->widget)
+    {
+        if (0U != burst)
+        {
+            EVE_cmd_button_burst(p_text->xc0, p_text->yc0, p_text->width, p_text->height, p_text->font,
+                p_text->options, p_text->text);
+        }
+        else
+        {
+            EVE_cmd_button(p_text->xc0, p_text->yc0, p_text->width, p_text->height, p_text->font,
+                p_text->options, p_text->text);
+        }
+    }
+    else if (TEXT_TOGGLE == p_text->widget)
+    {
+        if (0U != burst)
+        {
+            EVE_cmd_toggle_burst(p_text->xc0, p_text->yc0, p_text->width, p_text->font, p_text->options,
+                p_text->state, p_text->text);
+        }
+        else
+        {
+            EVE_cmd_toggle(p_text->xc0, p_text->yc0, p_text->width, p_text->font, p_text->options,
+                p_text->state, p_text->text);
+        }
+    }
+    else
+    {
+        if (0U != burst)
+        {
+            EVE_cmd_text_burst(p_text->xc0, p_text->yc0, p_text->font, p_text->options, p_text->text);
+        }
+        else
+        {
+            EVE_cmd_text(p_text->xc0, p_text->yc0, p_text->font, p_text->options, p_text->text);
+        }
+    }
+}
+
+static void text_build(void)
+{
+    text_send(p_text_current, 0U);
+}
+
+/* FNV-1a over the parameters and the string */
+static uint32_t text_hash(const EVE_text_t *p_text)
+{
+    uint32_t hash = 2166136261UL;
+    uint32_t params[8U];
+    uint8_t index = 0U;
+
+    params[0U] = (uint16_t) p_text->xc0;
+    params[1U] = (uint16_t) p_text->yc0;
+    params[2U] = p_text->font;
+    params[3U] = p_text->options;
+    params[4U] = p_text->widget;
+    params[5U] = p_text->width;
+    params[6U] = p_text->height;
+    params[7U] = p_text->state;
+
+    for (uint8_t param = 0U; param < 8U; param++)
+    {
+        hash = (hash ^ params[param]) * 16777619UL;
+    }
+
+    while ((index < EVE_TEXT_LENGTH) && (p_text->text[index] != '\0'))
+    {
+        hash = (hash ^ (uint8_t) p_text->text[index]) * 16777619UL;
+        index++;
+    }
+    return (hash);
+}
+
+/* the recorded segment shows the current string */
+static uint8_t text_recorded(const EVE_text_t *p_text)
+{
+    return (((0U != p_text->segment.length) && (p_text->segment.generation == ram_generation)
+        && (p_text->segment.moves == ram_moves) && (p_text->segment.inputs == p_text->hash)) ? 1U : 0U);
+}
+
+/* REG_CLOCK ticks from sending a display list of all recorded fields until the CMD-FIFO is empty again */
+static uint32_t text_time(const EVE_text_t *p_texts, uint16_t count, uint8_t append)
+{
+    uint32_t start;
+
+    EVE_execute_cmd();
+    start = EVE_memRead32(REG_CLOCK);
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    for (uint16_t index = 0U; index < count; index++)
+    {
+        if (0U != text_recorded(&p_texts[index]))
+        {
+            if (0U != append)
+            {
+                EVE_segment_append_burst(&p_texts[index].segment);
+            }
+            else
+            {
+                text_send(&p_texts[index], 1U);
+            }
+        }
+    }
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    return (EVE_memRead32(REG_CLOCK) - start);
+}
+
+/* the parts that are the same for all widgets */
+static void text_init(EVE_text_t *p_text, uint8_t widget, int16_t xc0, int16_t yc0, uint16_t font, uint16_t options)
+{
+    EVE_segment_init(&p_text->segment, &text_build);
+    p_text->widget = widget;
+    p_text->xc0 = xc0;
+    p_text->yc0 = yc0;
+    p_text->font = font;
+#if EVE_GEN > 2
+    p_text->options = (uint16_t) (options & (uint16_t) ~EVE_OPT_FORMAT);
+#else
+    p_text->options = options;
+#endif
+    p_text->text[0U] = '\0';
+    p_text->hash = text_hash(p_text);
+    p_text->changed = 1U;
+}
+
+/**
+ * @brief Prepare a text field, it starts with an empty string.
+ * @param options - the options for CMD_TEXT, EVE_OPT_FORMAT is removed as the string is formatted on the host
+ */
+void EVE_text_init(EVE_text_t *p_text, int16_t xc0, int16_t yc0, uint16_t font, uint16_t options)
+{
+    if (p_text != NULL)
+    {
+        p_text->width = 0U;
+        p_text->height = 0U;
+        p_text->state = 0U;
+        text_init(p_text, TEXT_TEXT, xc0, yc0, font, options);
+    }
+}
+
+/**
+ * @brief Prepare a text field that is shown as CMD_BUTTON, it starts with an empty string.
+ * @param options - the options for CMD_BUTTON, EVE_OPT_FORMAT is removed as the string is formatted on the host
+ */
+void EVE_text_init_button(EVE_text_t *p_text, int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
+                          uint16_t font, uint16_t options)
+{
+    if (p_text != NULL)
+    {
+        p_text->width = wid;
+        p_text->height = hgt;
+        p_text->state = 0U;
+        text_init(p_text, TEXT_BUTTON, xc0, yc0, font, options);
+    }
+}
+
+/**
+ * @brief Prepare a text field that is shown as CMD_TOGGLE, it starts with an empty string.
+ * @param options - the options for CMD_TOGGLE, EVE_OPT_FORMAT is removed as the string is formatted on the host
+ * @note - The string holds both labels separated by a 0xff character, like for EVE_cmd_toggle().
+ */
+void EVE_text_init_toggle(EVE_text_t *p_text, int16_t xc0, int16_t yc0, uint16_t wid, uint16_t font,
+                          uint16_t options, uint16_t state)
+{
+    if (p_text != NULL)
+    {
+        p_text->width = wid;
+        p_text->height = 0U;
+        p_text->state = state;
+        text_init(p_text, TEXT_TOGGLE, xc0, yc0, font, options);
+    }
+}
+
+/**
+ * @brief Set the state of a toggle field, the field is only marked as changed if the state is different.
+ */
+void EVE_text_set_state(EVE_text_t *p_text, uint16_t state)
+{
+    if ((p_text != NULL) && (state != p_text->state))
+    {
+        p_text->state = state;
+        p_text->changed = 1U;
+        p_text->hash = text_hash(p_text);
+    }
+}
+
+/**
+ * @brief Set the string of a text field, the field is only marked as changed if the string is different.
+ * @note - Strings longer than EVE_TEXT_LENGTH - 1 are cut off.
+ */
+void EVE_text_set(EVE_text_t *p_text, const char *p_string)
+{
+    if ((p_text != NULL) && (p_string != NULL))
+    {
+        uint8_t index = 0U;
+        uint8_t end = 0U;
+
+        while (0U == end)
+        {
+            char character = (index < (EVE_TEXT_LENGTH - 1U)) ? p_string[index] : '\0';
+
+            if (p_text->text[index] != character)
+            {
+                p_text->text[index] = character;
+                p_text->changed = 1U;
+            }
+            end = ('\0' == character) ? 1U : 0U;
+            index++;
+        }
+
+        if (0U != p_text->changed)
+        {
+            p_text->hash = text_hash(p_text);
+        }
+    }
+}
+
+/**
+ * @brief Set the string of a text field to a number, with "decimals" digits after the decimal point,
+ * for example 1234 with 2 decimals is "12.34" and -5 with 2 decimals is "-0.05".
+ * @note - This is the host side replacement for "%d" with EVE_OPT_FORMAT, decimals is limited to 9.
+ */
+void EVE_text_set_int(EVE_text_t *p_text, int32_t value, uint8_t decimals)
+{
+    char digits[12U];
+    char string[24U];
+    uint32_t magnitude = (value < 0L) ? (0UL - (uint32_t) value) : (uint32_t) value;
+    uint8_t count = 0U;
+    uint8_t pos = 0U;
+    uint8_t places = (decimals > 9U) ? 9U : decimals;
+
+    do
+    {
+        digits[count] = (char) ('0' + (magnitude % 10UL));
+        magnitude = magnitude / 10UL;
+        count++;
+    } while ((0UL != magnitude) || (count <= places));
+
+    if (value < 0L)
+    {
+        string[pos] = '-';
+        pos++;
+    }
+
+    while (count > 0U)
+    {
+        count--;
+        string[pos] = digits[count];
+        pos++;
+        if ((0U != places) && (count == places))
+        {
+            string[pos] = '.';
+            pos++;
+        }
+    }
+    string[pos] = '\0';
+
+    EVE_text_set(p_text, string);
+}
+
+/**
+ * @brief Record the fields that did not change since the last EVE_text_burst() and that are not recorded yet.
+ * A field that changes every frame is not recorded and always sent as CMD_TEXT by EVE_text_burst(),
+ * a field that keeps its string for a frame is recorded once and then added with CMD_APPEND.
+ * @note - Meant to be called outside display-list building, right before the display list with
+ * EVE_text_burst() is started, every recording waits for EVE to be idle.
+ * @note - The recorded segments take their space from the RAM_G heap, EVE_ram_init() has to be called first,
+ * every field takes a block of its own so EVE_RAM_BLOCKS needs to be raised for more than a couple of fields,
+ * fields that do not fit in the heap are sent as CMD_TEXT, CMD_BUTTON or CMD_TOGGLE.
+ */
+void EVE_text_update(EVE_text_t *p_texts, uint16_t count)
+{
+    if (p_texts != NULL)
+    {
+        for (uint16_t index = 0U; index < count; index++)
+        {
+            EVE_text_t *p_text = &p_texts[index];
+
+            if ((0U == p_text->changed) && (0U == text_recorded(p_text)))
+            {
+                p_text_current = p_text;
+                if (E_OK == EVE_segment_update(&p_text->segment, p_text->hash))
+                {
+                    text_stats.records++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Add the text fields to the display list, CMD_APPEND for the recorded fields and CMD_TEXT,
+ * CMD_BUTTON or CMD_TOGGLE with the string from the host for the others.
+ * @note - Meant to be called between EVE_start_cmd_burst() and EVE_end_cmd_burst(), once per frame.
+ */
+void EVE_text_burst(EVE_text_t *p_texts, uint16_t count)
+{
+    if (p_texts != NULL)
+    {
+        uint32_t appends = 0UL;
+
+        for (uint16_t index = 0U; index < count; index++)
+        {
+            EVE_text_t *p_text = &p_texts[index];
+
+            if ((0U == p_text->changed) && (0U != text_recorded(p_text)))
+            {
+                EVE_segment_append_burst(&p_text->segment);
+                appends++;
+            }
+            else
+            {
+                text_send(p_text, 1U);
+                text_stats.texts++;
+            }
+            p_text->changed = 0U;
+        }
+
+        text_stats.frames++;
+        text_stats.appends += appends;
+        text_stats.saved_clocks = appends * text_saving;
+        text_stats.saved_total += text_stats.saved_clocks;
+    }
+}
+
+/**
+ * @brief Measure how much coprocessor time CMD_APPEND saves over CMD_TEXT for the fields, for the saved_clocks
+ * in the statistics. All fields are recorded and sent in a display list as CMD_TEXT and once more as CMD_APPEND,
+ * the time for each is taken from REG_CLOCK until REG_CMD_READ reached the end of the list.
+ * @return - E_OK - if the measurement is done
+ * @return - E_NOT_OK - if there was nothing recorded to measure or the coprocessor faulted
+ * @note - Meant to be called outside display-list building, with the fields set to typical strings,
+ * the display lists are not swapped, the next CMD_DLSTART overwrites them.
+ */
+uint8_t EVE_text_calibrate(EVE_text_t *p_texts, uint16_t count)
+{
+    uint8_t ret = E_NOT_OK;
+    uint16_t recorded = 0U;
+
+    if (p_texts != NULL)
+    {
+        for (uint16_t index = 0U; index < count; index++)
+        {
+            p_texts[index].changed = 0U;
+        }
+        EVE_text_update(p_texts, count);
+
+        for (uint16_t index = 0U; index < count; index++)
+        {
+            recorded += text_recorded(&p_texts[index]);
+        }
+
+        if (0U != recorded)
+        {
+            uint32_t text_clocks;
+            uint32_t append_clocks;
+
+            (void) EVE_get_and_reset_fault_state();
+            text_clocks = text_time(p_texts, count, 0U);
+            append_clocks = text_time(p_texts, count, 1U);
+
+            if (E_OK == EVE_get_and_reset_fault_state())
+            {
+                text_saving = (text_clocks > append_clocks) ? ((text_clocks - append_clocks) / recorded) : 0UL;
+                ret = E_OK;
+            }
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Copy the counters of the text fields to p_stats and optionally clear them.
+ */
+void EVE_text_get_stats(EVE_text_stats_t *p_stats, uint8_t clear)
+{
+    if (p_stats != NULL)
+    {
+        *p_stats = text_stats;
+    }
+
+    if (0U != clear)
+    {
+        text_stats.frames = 0UL;
+        text_stats.texts = 0UL;
+        text_stats.appends = 0UL;
+        text_stats.records = 0UL;
+        text_stats.saved_clocks = 0UL;
+        text_stats.saved_total = 0UL;
+    }
+}
+
+/* ##################################################################
+    scrolling lists
+################################################################### */
+
+static const EVE_list_t *p_list_current = NULL; /* the list list_build() records a row of */
+static uint16_t list_row_current = 0U;
+
+static void list_build(void)
+{
+    p_list_current->p_row(list_row_current);
+}
+
+/* the largest value for offset, 0 if all rows fit in the window */
+static int32_t list_max_offset(const EVE_list_t *p_list)
+{
+    int32_t max = (((int32_t) p_list->rows * (int32_t) p_list->row_height) - (int32_t) p_list->height) * 16;
+
+    return ((max > 0) ? max : 0);
+}
+
+static void list_clamp(EVE_list_t *p_list)
+{
+    int32_t max = list_max_offset(p_list);
+
+    if (p_list->offset < 0)
+    {
+        p_list->offset = 0;
+        p_list->velocity = 0;
+    }
+    if (p_list->offset > max)
+    {
+        p_list->offset = max;
+        p_list->velocity = 0;
+    }
+}
+
+/**
+ * @brief Prepare a list of rows that are written by p_row, all rows are row_height pixels high.
+ * @note - The rows are recorded as segments in the RAM_G heap, EVE_ram_init() has to be called first.
+ * @note - The window defaults to the full screen, see EVE_list_window().
+ * @note - EVE_LIST_SLOTS has to be larger than the number of rows that fit in the window at the same time plus one,
+ * otherwise rows are recorded again in every frame.
+ */
+void EVE_list_init(EVE_list_t *p_list, EVE_list_row_t p_row, uint16_t rows, uint16_t row_height)
+{
+    if (p_list != NULL)
+    {
+        for (uint16_t slot = 0U; slot < EVE_LIST_SLOTS; slot++)
+        {
+            EVE_segment_init(&p_list->slots[slot], list_build);
+        }
+        p_list->p_row = p_row;
+        p_list->offset = 0;
+        p_list->velocity = 0;
+        p_list->xc0 = 0;
+        p_list->yc0 = 0;
+        p_list->width = EVE_HSIZE;
+        p_list->height = EVE_VSIZE;
+        p_list->row_height = (0U != row_height) ? row_height : 1U;
+        p_list->rows = rows;
+        p_list->dragging = 0U;
+    }
+}
+
+/**
+ * @brief Set the part of the screen the list is shown in, the rows are cut off at the edges with the scissor.
+ */
+void EVE_list_window(EVE_list_t *p_list, int16_t xc0, int16_t yc0, uint16_t width, uint16_t height)
+{
+    if (p_list != NULL)
+    {
+        p_list->xc0 = xc0;
+        p_list->yc0 = yc0;
+        p_list->width = width;
+        p_list->height = height;
+        list_clamp(p_list);
+    }
+}
+
+/**
+ * @brief Change the number of rows, the rows that are recorded already stay as they are.
+ */
+void EVE_list_set_rows(EVE_list_t *p_list, uint16_t rows)
+{
+    if (p_list != NULL)
+    {
+        p_list->rows = rows;
+        list_clamp(p_list);
+    }
+}
+
+/**
+ * @brief Make the next EVE_list_update() record the rows in the window again, for when the data of the rows changed.
+ */
+void EVE_list_invalidate(EVE_list_t *p_list)
+{
+    if (p_list != NULL)
+    {
+        for (uint16_t slot = 0U; slot < EVE_LIST_SLOTS; slot++)
+        {
+            EVE_segment_invalidate(&p_list->slots[slot]);
+        }
+    }
+}
+
+/**
+ * @brief Move the list with a finger that moved delta pixels down since the last call,
+ * like the difference of dy between two EVE_TOUCH_DRAG events.
+ * @note - The list follows the finger until EVE_list_release(), the last delta is the velocity it keeps scrolling with.
+ */
+void EVE_list_drag(EVE_list_t *p_list, int16_t delta)
+{
+    if (p_list != NULL)
+    {
+        p_list->dragging = 1U;
+        p_list->velocity = -((int32_t) delta * 16);
+        p_list->offset += p_list->velocity;
+        list_clamp(p_list);
+    }
+}
+
+/**
+ * @brief Let go of the list, it keeps scrolling with the velocity of the last EVE_list_drag() and slows down.
+ */
+void EVE_list_release(EVE_list_t *p_list)
+{
+    if (p_list != NULL)
+    {
+        p_list->dragging = 0U;
+    }
+}
+
+/**
+ * @brief Scroll the list to the position of a linear tracker, as read from REG_TRACKER for a CMD_TRACK on a scrollbar.
+ * @param tracker - the value of REG_TRACKER, the upper 16 bits are the position from 0 to 65535
+ */
+void EVE_list_track(EVE_list_t *p_list, uint32_t tracker)
+{
+    if (p_list != NULL)
+    {
+        p_list->offset = (int32_t) (((int64_t) (tracker >> 16U) * list_max_offset(p_list)) / 65535);
+        p_list->velocity = 0;
+        list_clamp(p_list);
+    }
+}
+
+/**
+ * @brief Get the row at the screen coordinate yc0, like for an EVE_TOUCH_PRESS in the window of the list.
+ * @return the row or -1 if there is no row there
+ */
+int32_t EVE_list_row_at(const EVE_list_t *p_list, int16_t yc0)
+{
+    int32_t ret = -1;
+
+    if ((p_list != NULL) && (yc0 >= p_list->yc0) && (yc0 < (p_list->yc0 + (int32_t) p_list->height)))
+    {
+        int32_t row = ((((int32_t) yc0 - p_list->yc0) * 16) + p_list->offset) / ((int32_t) p_list->row_height * 16);
+
+        if (row < (int32_t) p_list->rows)
+        {
+            ret = row;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Move the list by its velocity and record the rows that scrolled into the window.
+ * @note - Meant to be called once per frame outside display-list building, before EVE_list_burst().
+ * @note - A row is only recorded when it scrolls into the window, after that it is appended
+ * from RAM_G until EVE_LIST_SLOTS other rows were in the window.
+ */
+void EVE_list_update(EVE_list_t *p_list)
+{
+    if ((p_list != NULL) && (p_list->p_row != NULL))
+    {
+        int32_t row_size = (int32_t) p_list->row_height * 16;
+        int32_t end = p_list->offset + ((int32_t) p_list->height * 16);
+
+        if (0U == p_list->dragging)
+        {
+            p_list->offset += p_list->velocity;
+            p_list->velocity -= p_list->velocity / 16; /* friction */
+            if ((p_list->velocity < 16) && (p_list->velocity > -16))
+            {
+                p_list->velocity = 0;
+            }
+            list_clamp(p_list);
+            end = p_list->offset + ((int32_t) p_list->height * 16);
+        }
+
+        p_list_current = p_list;
+        for (int32_t row = p_list->offset / row_size; (row < (int32_t) p_list->rows) && ((row * row_size) < end); row++)
+        {
+            list_row_current = (uint16_t) row;
+            (void) EVE_segment_update(&p_list->slots[(uint16_t) row % EVE_LIST_SLOTS], (uint32_t) row);
+        }
+    }
+}
+
+/**
+ * @brief Add the rows that are in the window to the display list, each with VERTEX_TRANSLATE_Y and CMD_APPEND.
+ * @note - The number of commands only depends on the height of the window, not on the number of rows.
+ * @note - A row that could not be recorded, like for a full RAM_G heap, is left out.
+ */
+void EVE_list_burst(const EVE_list_t *p_list)
+{
+    if (p_list != NULL)
+    {
+        int32_t row_size = (int32_t) p_list->row_height * 16;
+        int32_t end = p_list->offset + ((int32_t) p_list->height * 16);
+
+        EVE_cmd_dl_burst(DL_SAVE_CONTEXT);
+        EVE_cmd_dl_burst(SCISSOR_XY((uint16_t) p_list->xc0, (uint16_t) p_list->yc0));
+        EVE_cmd_dl_burst(SCISSOR_SIZE(p_list->width, p_list->height));
+
+        for (int32_t row = p_list->offset / row_size; (row < (int32_t) p_list->rows) && ((row * row_size) < end); row++)
+        {
+            const EVE_segment_t *p_slot = &p_list->slots[(uint16_t) row % EVE_LIST_SLOTS];
+
+            if ((0U != p_slot->length) && ((uint32_t) row == p_slot->inputs))
+            {
+                EVE_cmd_dl_burst(VERTEX_TRANSLATE_X((int32_t) p_list->xc0 * 16));
+                EVE_cmd_dl_burst(VERTEX_TRANSLATE_Y((((int32_t) p_list->yc0 * 16) + (row * row_size)) - p_list->offset));
+                EVE_segment_append_burst(p_slot);
+            }
+        }
+
+        EVE_cmd_dl_burst(DL_RESTORE_CONTEXT);
+    }
+}
+
+/* ##################################################################
+    charts
+################################################################### */
+
+#define CHART_LENGTH_MAX 1024U /* the largest ring, a chart of more than CHART_TILE samples is shown in tiles */
+#define CHART_TILE 256U /* a BARGRAPH bitmap is at most 256 x 256, each vertex shows up to this many samples */
+#define CHART_BLOCK 32U /* bytes on the stack for EVE_chart_add_block() */
+
+static uint8_t chart_valid(const EVE_chart_t *p_chart)
+{
+    return (((p_chart != NULL) && (0U != p_chart->handle) && (p_chart->generation == ram_generation)) ? 1U : 0U);
+}
+
+/**
+ * @brief Prepare a chart for the last width samples in the area at xc0 / yc0 with the size width x height.
+ * @param bitmap - the bitmap handle the chart uses, 0 to 14
+ * @note - The samples are kept in a ring of bytes in the RAM_G heap that is shown as a BARGRAPH bitmap,
+ * EVE_ram_init() has to be called first.
+ * @note - The ring is the next power of two up from width, all samples are 0 at the start.
+ * @note - Meant to be called outside display-list building, the ring is cleared with CMD_MEMSET.
+ * @return - E_OK - if the ring is in RAM_G
+ * @return - E_NOT_OK - if width is not 1 to 1024, height is not 2 to 1023 or there is no room in the heap
+ */
+uint8_t EVE_chart_init(EVE_chart_t *p_chart, uint8_t bitmap, int16_t xc0, int16_t yc0, uint16_t width, uint16_t height)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if (p_chart != NULL)
+    {
+        uint16_t length = 1U;
+
+        while (length < width)
+        {
+            length = length << 1U;
+        }
+
+        p_chart->xc0 = xc0;
+        p_chart->yc0 = yc0;
+        p_chart->width = width;
+        p_chart->height = height;
+        p_chart->length = length;
+        p_chart->head = 0U;
+        p_chart->handle = 0U;
+        p_chart->generation = ram_generation;
+        p_chart->bitmap = bitmap;
+        p_chart->line = 0U;
+
+        if ((0U != width) && (width <= CHART_LENGTH_MAX) && (height > 1U) && (height < 1024U))
+        {
+            p_chart->handle = EVE_ram_alloc(length, 4UL);
+            if (0U != p_chart->handle)
+            {
+                EVE_cmd_memset(EVE_ram_address(p_chart->handle), 0xffU, length);
+                ret = E_OK;
+            }
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Release the ring of the chart in the RAM_G heap.
+ */
+void EVE_chart_free(EVE_chart_t *p_chart)
+{
+    if (0U != chart_valid(p_chart))
+    {
+        EVE_ram_free(p_chart->handle);
+    }
+    if (p_chart != NULL)
+    {
+        p_chart->handle = 0U;
+    }
+}
+
+/**
+ * @brief Draw the chart as a line that is thickness pixels wide along the top of the samples, 0 for a filled area.
+ * @note - The line is cut out of the filled area with the stencil buffer, a jump between two samples
+ * that is larger than the thickness leaves a gap.
+ */
+void EVE_chart_line(EVE_chart_t *p_chart, uint8_t thickness)
+{
+    if (p_chart != NULL)
+    {
+        p_chart->line = thickness;
+    }
+}
+
+/**
+ * @brief Add a sample to the chart, it is shown at the right edge and all older samples move one pixel to the left.
+ * @param level - 0 for the bottom edge to 255 for the top edge of the chart
+ * @note - Only the one byte for the new sample is written to RAM_G.
+ * @note - Meant to be called outside display-list building.
+ */
+void EVE_chart_add(EVE_chart_t *p_chart, uint8_t level)
+{
+    if (0U != chart_valid(p_chart))
+    {
+        EVE_memWrite8(EVE_ram_address(p_chart->handle) + p_chart->head, 255U - level);
+        p_chart->head = (p_chart->head + 1U) & (p_chart->length - 1U);
+    }
+}
+
+/**
+ * @brief Add count samples to the chart, like for samples collected between two frames.
+ * @note - The samples are written to RAM_G in blocks of up to CHART_BLOCK bytes.
+ * @note - Meant to be called outside display-list building.
+ */
+void EVE_chart_add_block(EVE_chart_t *p_chart, const uint8_t *p_levels, uint16_t count)
+{
+    if ((0U != chart_valid(p_chart)) && (p_levels != NULL))
+    {
+        uint32_t address = EVE_ram_address(p_chart->handle);
+        uint8_t block[CHART_BLOCK];
+        uint16_t index = 0U;
+
+        if (count > p_chart->length) /* older samples would be overwritten right away */
+        {
+            index = count - p_chart->length;
+        }
+
+        while (index < count)
+        {
+            uint16_t part = p_chart->length - p_chart->head; /* up to the end of the ring */
+
+            if (part > (count - index))
+            {
+                part = count - index;
+            }
+            if (part > CHART_BLOCK)
+            {
+                part = CHART_BLOCK;
+            }
+            for (uint16_t byte = 0U; byte < part; byte++)
+            {
+                block[byte] = 255U - p_levels[index + byte];
+            }
+            EVE_memWrite_sram_buffer(address + p_chart->head, block, part);
+            p_chart->head = (p_chart->head + part) & (p_chart->length - 1U);
+            index += part;
+        }
+    }
+}
+
+/**
+ * @brief Set all samples of the chart to 0.
+ * @note - Meant to be called outside display-list building.
+ */
+void EVE_chart_clear(EVE_chart_t *p_chart)
+{
+    if (0U != chart_valid(p_chart))
+    {
+        EVE_cmd_memset(EVE_ram_address(p_chart->handle), 0xffU, p_chart->length);
+        p_chart->head = 0U;
+    }
+}
+
+/* set up the bitmap for the tile of the chart that starts with the sample at pixel pos from the left edge, */
+/* a tile ends at the right edge or at the end of a block of CHART_TILE bytes of the ring, */
+/* a ring of CHART_TILE bytes or less is one block that REPEAT wraps around, returns the samples in the tile */
+static uint16_t chart_tile(const EVE_chart_t *p_chart, uint16_t pos)
+{
+    uint16_t block = (p_chart->length > CHART_TILE) ? CHART_TILE : p_chart->length;
+    uint32_t sample = (((uint32_t) p_chart->head - p_chart->width) + pos) & (p_chart->length - 1U);
+    uint32_t offset = sample & (block - 1U);
+    uint16_t count = p_chart->width - pos;
+
+    if ((p_chart->length > block) && (count > (block - offset)))
+    {
+        count = (uint16_t) (block - offset);
+    }
+
+    EVE_cmd_dl_burst(BITMAP_SOURCE(EVE_ram_address(p_chart->handle) + (sample - offset)));
+    EVE_cmd_dl_burst(BITMAP_SIZE(EVE_NEAREST, EVE_REPEAT, EVE_BORDER, count, p_chart->height));
+    EVE_cmd_dl_burst(BITMAP_SIZE_H(count, p_chart->height));
+    EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_C | ((offset << 8U) & 0xffffffUL));
+    return (count);
+}
+
+/**
+ * @brief Add the chart to the display list, in the current color.
+ * @note - The ring is shown as BARGRAPH bitmaps of up to CHART_TILE samples, one vertex for each tile,
+ * BITMAP_TRANSFORM_C scrolls a tile to its oldest sample and BITMAP_TRANSFORM_E scales the 256 levels
+ * to the height of the chart.
+ * @note - The number of commands does not depend on the number of samples, it is 13 words plus 5 words
+ * for each tile for a filled area and 21 words plus 13 words for each tile for a line.
+ * A chart of up to 256 samples is one tile, a wider chart is up to 5 tiles.
+ */
+void EVE_chart_burst(const EVE_chart_t *p_chart)
+{
+    if (0U != chart_valid(p_chart))
+    {
+        uint32_t scale = 65536UL / p_chart->height; /* 8.8 fixed point, 256 levels to height pixels */
+        uint16_t block = (p_chart->length > CHART_TILE) ? CHART_TILE : p_chart->length;
+        uint16_t count;
+
+        EVE_cmd_dl_burst(DL_SAVE_CONTEXT);
+        EVE_cmd_dl_burst(VERTEX_FORMAT(0U));
+        EVE_cmd_dl_burst(BITMAP_HANDLE(p_chart->bitmap));
+        EVE_cmd_dl_burst(BITMAP_LAYOUT(EVE_BARGRAPH, block, 1U));
+        EVE_cmd_dl_burst(BITMAP_LAYOUT_H(block, 1U));
+        EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_A | 256UL);
+        EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_B);
+        EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_D);
+        EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_E | scale);
+
+        if (0U == p_chart->line)
+        {
+            EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_F);
+            EVE_cmd_dl_burst(DL_BEGIN | EVE_BITMAPS);
+            for (uint16_t pos = 0U; pos < p_chart->width; pos += count)
+            {
+                count = chart_tile(p_chart, pos);
+                EVE_cmd_dl_burst(VERTEX2F((int16_t) (p_chart->xc0 + (int16_t) pos), p_chart->yc0));
+            }
+        }
+        else
+        {
+            /* count in the stencil buffer how many of the filled area and the filled area moved up by line pixels
+            cover a pixel, the line is where only the moved one does */
+            EVE_cmd_dl_burst(SCISSOR_XY((uint16_t) p_chart->xc0, (uint16_t) p_chart->yc0));
+            EVE_cmd_dl_burst(SCISSOR_SIZE(p_chart->width, p_chart->height));
+            EVE_cmd_dl_burst(CLEAR_STENCIL(0U));
+            EVE_cmd_dl_burst(CLEAR(0U, 1U, 0U));
+            EVE_cmd_dl_burst(COLOR_MASK(0U, 0U, 0U, 0U));
+            EVE_cmd_dl_burst(STENCIL_OP(EVE_INCR, EVE_INCR));
+            EVE_cmd_dl_burst(DL_BEGIN | EVE_BITMAPS);
+            for (uint16_t pos = 0U; pos < p_chart->width; pos += count)
+            {
+                count = chart_tile(p_chart, pos);
+                EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_F);
+                EVE_cmd_dl_burst(VERTEX2F((int16_t) (p_chart->xc0 + (int16_t) pos), p_chart->yc0));
+                EVE_cmd_dl_burst(DL_BITMAP_TRANSFORM_F | ((scale * p_chart->line) & 0xffffffUL));
+                EVE_cmd_dl_burst(VERTEX2F((int16_t) (p_chart->xc0 + (int16_t) pos), p_chart->yc0));
+            }
+            EVE_cmd_dl_burst(COLOR_MASK(1U, 1U, 1U, 1U));
+            EVE_cmd_dl_burst(STENCIL_FUNC(EVE_EQUAL, 1U, 255U));
+            EVE_cmd_dl_burst(STENCIL_OP(EVE_KEEP, EVE_KEEP));
+            for (uint16_t pos = 0U; pos < p_chart->width; pos += count)
+            {
+                count = chart_tile(p_chart, pos);
+                EVE_cmd_dl_burst(VERTEX2F((int16_t) (p_chart->xc0 + (int16_t) pos), p_chart->yc0));
+            }
+        }
+
+        EVE_cmd_dl_burst(DL_END);
+        EVE_cmd_dl_burst(DL_RESTORE_CONTEXT);
+    }
+}
+
+/* ##################################################################
+    touch events
+################################################################### */
+
+/* what is known about one finger */
+typedef struct
+{
+    uint32_t down_ms; /* when the press was sent */
+    int16_t xc0; /* the last sample */
+    int16_t yc0;
+    int16_t start_x; /* where the finger went down */
+    int16_t start_y;
+    int16_t drag_x; /* where the last drag event was sent */
+    int16_t drag_y;
+    uint8_t down; /* the press was sent and the release was not */
+    uint8_t count; /* samples with the finger down while it is up or up while it is down, for the debounce */
+    uint8_t tag;
+    uint8_t moved; /* a drag event was sent, there is no long-press then */
+    uint8_t long_sent;
+} touch_finger_t;
+
+static touch_finger_t touch_fingers[EVE_TOUCH_POINTS];
+static EVE_touch_event_t touch_queue[EVE_TOUCH_EVENTS];
+static volatile uint8_t touch_head = 0U; /* only changed by EVE_touch_service() */
+static volatile uint8_t touch_tail = 0U; /* only changed by EVE_touch_get_event() */
+static volatile uint8_t touch_awake = 0U; /* set by the touch interrupt, cleared when all fingers are up */
+static uint8_t touch_points = 1U;
+static uint32_t touch_sample_ms = 0UL;
+static EVE_touch_stats_t touch_stats = {0UL, 0UL, 0UL, 0UL};
+
+static int32_t touch_abs(int32_t value)
+{
+    return ((value < 0) ? -value : value);
+}
+
+static void touch_int_callback(uint8_t int_flags)
+{
+    (void) int_flags;
+    touch_awake = 1U;
+    touch_stats.wakeups++;
+}
+
+static void touch_event(const touch_finger_t *p_finger, uint8_t finger, uint8_t type, uint32_t time_ms)
+{
+    if ((uint8_t) (touch_head - touch_tail) < EVE_TOUCH_EVENTS)
+    {
+        EVE_touch_event_t *p_event = &touch_queue[touch_head & (EVE_TOUCH_EVENTS - 1U)];
+        int16_t dx = (int16_t) (p_finger->xc0 - p_finger->start_x);
+        int16_t dy = (int16_t) (p_finger->yc0 - p_finger->start_y);
+
+        p_event->time_ms = time_ms;
+        p_event->xc0 = p_finger->xc0;
+        p_event->yc0 = p_finger->yc0;
+        p_event->dx = dx;
+        p_event->dy = dy;
+        p_event->type = type;
+        p_event->finger = finger;
+        p_event->tag = p_finger->tag;
+        p_event->direction = 0U;
+
+        if (EVE_TOUCH_SWIPE == type)
+        {
+            if (touch_abs(dx) >= touch_abs(dy))
+            {
+                p_event->direction = (dx > 0) ? EVE_SWIPE_RIGHT : EVE_SWIPE_LEFT;
+            }
+            else
+            {
+                p_event->direction = (dy > 0) ? EVE_SWIPE_DOWN : EVE_SWIPE_UP;
+            }
+        }
+
+        touch_head++; /* the event is complete before it is in the queue */
+        touch_stats.events++;
+    }
+    else
+    {
+        touch_stats.dropped++;
+    }
+}
+
+/* track one finger, returns 1 if the finger is down or on its way up or down */
+static uint8_t touch_track(uint8_t finger, uint32_t xy, uint8_t tag, uint32_t time_ms)
+{
+    touch_finger_t *p_finger = &touch_fingers[finger];
+    uint8_t touched = (0x8000U != (uint16_t) (xy >> 16U)) ? 1U : 0U;
+
+    if (0U != touched)
+    {
+        p_finger->xc0 = (int16_t) (uint16_t) (xy >> 16U);
+        p_finger->yc0 = (int16_t) (uint16_t) (xy & 0xffffUL);
+    }
+
+    if (0U == p_finger->down)
+    {
+        p_finger->count = (0U != touched) ? (uint8_t) (p_finger->count + 1U) : 0U;
+        if (p_finger->count >= EVE_TOUCH_DEBOUNCE)
+        {
+            p_finger->down = 1U;
+            p_finger->count = 0U;
+            p_finger->down_ms = time_ms;
+            p_finger->start_x = p_finger->xc0;
+            p_finger->start_y = p_finger->yc0;
+            p_finger->drag_x = p_finger->xc0;
+            p_finger->drag_y = p_finger->yc0;
+            p_finger->tag = tag;
+            p_finger->moved = 0U;
+            p_finger->long_sent = 0U;
+            touch_event(p_finger, finger, EVE_TOUCH_PRESS, time_ms);
+        }
+    }
+    else if (0U != touched)
+    {
+        p_finger->count = 0U;
+        if ((touch_abs(p_finger->xc0 - p_finger->drag_x) >= EVE_TOUCH_DRAG_MIN)
+            || (touch_abs(p_finger->yc0 - p_finger->drag_y) >= EVE_TOUCH_DRAG_MIN))
+        {
+            p_finger->drag_x = p_finger->xc0;
+            p_finger->drag_y = p_finger->yc0;
+            p_finger->moved = 1U;
+            touch_event(p_finger, finger, EVE_TOUCH_DRAG, time_ms);
+        }
+        else if ((0U == p_finger->moved) && (0U == p_finger->long_sent)
+                 && ((time_ms - p_finger->down_ms) >= EVE_TOUCH_LONG_MS))
+        {
+            p_finger->long_sent = 1U;
+            touch_event(p_finger, finger, EVE_TOUCH_LONG, time_ms);
+        }
+        else
+        {
+        }
+    }
+    else
+    {
+        p_finger->count++;
+        if (p_finger->count >= EVE_TOUCH_DEBOUNCE)
+        {
+            int32_t distance = touch_abs(p_finger->xc0 - p_finger->start_x) + touch_abs(p_finger->yc0 - p_finger->start_y);
+
+            p_finger->down = 0U;
+            p_finger->count = 0U;
+            if (((time_ms - p_finger->down_ms) <= EVE_TOUCH_SWIPE_MS) && (distance >= EVE_TOUCH_SWIPE_MIN))
+            {
+                touch_event(p_finger, finger, EVE_TOUCH_SWIPE, time_ms);
+            }
+            touch_event(p_finger, finger, EVE_TOUCH_RELEASE, time_ms);
+        }
+    }
+
+    return (((0U != p_finger->down) || (0U != p_finger->count)) ? 1U : 0U);
+}
+
+/**
+ * @brief Set up the touch events for 1 to EVE_TOUCH_POINTS touch points and register for the touch interrupt.
+ * @note - More than one touch point switches a capacitive touch controller to extended mode with REG_CTOUCH_EXTENDED.
+ * @note - Meant to be called after EVE_init() and outside display-list building, this writes to EVE.
+ * @note - The registers are only read by EVE_touch_service() after a touch interrupt and then until all fingers are up,
+ * INT_N has to be connected to EVE_int_edge() and EVE_int_service() has to be called from the main loop.
+ * Without INT_N calling EVE_int_edge() from the main loop works as well, this only reads REG_INT_FLAGS while idle.
+ */
+void EVE_touch_init(uint8_t points)
+{
+    touch_points = points;
+    if (touch_points > EVE_TOUCH_POINTS)
+    {
+        touch_points = EVE_TOUCH_POINTS;
+    }
+    if (0U == touch_points)
+    {
+        touch_points = 1U;
+    }
+
+    for (uint8_t finger = 0U; finger < EVE_TOUCH_POINTS; finger++)
+    {
+        touch_fingers[finger].down = 0U;
+        touch_fingers[finger].count = 0U;
+    }
+    touch_tail = touch_head;
+    touch_awake = 1U; /* a finger could be down already */
+
+    if (touch_points > 1U)
+    {
+        EVE_memWrite8(REG_CTOUCH_EXTENDED, 0U); /* extended mode, 0 is extended and 1 is compatibility */
+    }
+    EVE_int_set_callback(EVE_INT_TOUCH, touch_int_callback);
+}
+
+/**
+ * @brief Read the touch registers if the screen was touched and turn the samples into events.
+ * @param time_ms - a millisecond counter of the application, for the debounce, long-press and swipe timing
+ * @return the number of new events in the queue
+ * @note - Samples are at least EVE_TOUCH_INTERVAL_MS apart, call this at least that often from the main loop.
+ * @note - All the touch points are read in one transfer from REG_CTOUCH_TOUCH1_XY to REG_TOUCH_TAG4,
+ * the touch points 2 to 4 need one more transfer each for REG_CTOUCH_TOUCH2_XY / REG_CTOUCH_TOUCH3_XY
+ * and REG_CTOUCH_TOUCH4_X.
+ */
+uint8_t EVE_touch_service(uint32_t time_ms)
+{
+    uint8_t head = touch_head;
+
+    if ((0U != touch_awake) && ((time_ms - touch_sample_ms) >= EVE_TOUCH_INTERVAL_MS))
+    {
+        uint32_t regs[13U];
+        uint32_t xy[EVE_TOUCH_POINTS];
+        uint8_t tags[EVE_TOUCH_POINTS];
+        uint8_t active = 0U;
+
+        touch_sample_ms = time_ms;
+        touch_stats.samples++;
+
+        if (1U == touch_points)
+        {
+            EVE_memRead_regs(REG_TOUCH_SCREEN_XY, regs, 3U); /* REG_TOUCH_SCREEN_XY, REG_TOUCH_TAG_XY and REG_TOUCH_TAG */
+            xy[0U] = regs[0U];
+            tags[0U] = (uint8_t) regs[2U];
+        }
+        else
+        {
+            EVE_memRead_regs(REG_CTOUCH_TOUCH1_XY, regs, 13U);
+            xy[0U] = regs[2U]; /* REG_CTOUCH_TOUCH0_XY */
+            xy[1U] = regs[0U]; /* REG_CTOUCH_TOUCH1_XY */
+            tags[0U] = (uint8_t) regs[4U]; /* REG_TOUCH_TAG */
+            tags[1U] = (uint8_t) regs[6U]; /* REG_TOUCH_TAG1 */
+            tags[2U] = (uint8_t) regs[8U];
+            tags[3U] = (uint8_t) regs[10U];
+            tags[4U] = (uint8_t) regs[12U]; /* REG_TOUCH_TAG4 */
+
+            if (touch_points > 2U)
+            {
+                EVE_memRead_regs(REG_CTOUCH_TOUCH2_XY, &xy[2U], 2U); /* REG_CTOUCH_TOUCH2_XY and REG_CTOUCH_TOUCH3_XY */
+            }
+            if (touch_points > 4U)
+            {
+                xy[4U] = (((uint32_t) EVE_memRead16(REG_CTOUCH_TOUCH4_X)) << 16U) | (regs[1U] & 0xffffUL);
+            }
+        }
+
+        for (uint8_t finger = 0U; finger < touch_points; finger++)
+        {
+            active |= touch_track(finger, xy[finger], tags[finger], time_ms);
+        }
+
+        if (0U == active)
+        {
+            touch_awake = 0U; /* nothing to do until the next touch interrupt */
+        }
+    }
+
+    return ((uint8_t) (touch_head - head));
+}
+
+/**
+ * @brief Take the oldest event from the queue.
+ * @return - E_OK - if there was an event and it was copied to p_event
+ * @return - E_NOT_OK - if the queue is empty
+ * @note - The queue has one writer and one reader, this can be called from another task than EVE_touch_service().
+ */
+uint8_t EVE_touch_get_event(EVE_touch_event_t *p_event)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((p_event != NULL) && (touch_tail != touch_head))
+    {
+        *p_event = touch_queue[touch_tail & (EVE_TOUCH_EVENTS - 1U)];
+        touch_tail++; /* the event is copied before its slot is given back */
+        ret = E_OK;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Copy the counters of the touch events to p_stats and optionally clear them.
+ */
+void EVE_touch_get_stats(EVE_touch_stats_t *p_stats, uint8_t clear)
+{
+    if (p_stats != NULL)
+    {
+        *p_stats = touch_stats;
+    }
+
+    if (0U != clear)
+    {
+        touch_stats.wakeups = 0UL;
+        touch_stats.samples = 0UL;
+        touch_stats.events = 0UL;
+        touch_stats.dropped = 0UL;
+    }
+}
+
+/* ##################################################################
+    frame pacing
+################################################################### */
+
+static volatile uint8_t pace_swapped = 0U; /* set by the swap interrupt */
+static uint8_t pace_interrupt = 0U; /* EVE_pace_init() registered pace_int_callback() */
+static uint8_t pace_pending = 0U; /* a frame was sent and is not on screen yet */
+static uint8_t pace_in_slot = 0U; /* the last frame was due at the start of its slot, not later */
+static uint8_t pace_shown = 0U; /* a frame went on screen since EVE_pace_init(), pace_shown_frame is valid */
+static uint8_t pace_divider = 1U;
+static uint8_t pace_divider_max = 1U;
+static uint16_t pace_early = 0U; /* frames in a row that were on screen before their slot ended */
+static uint32_t pace_next = 0UL; /* the value of REG_FRAMES from which on the next frame is due */
+static uint32_t pace_due_frame = 0UL; /* REG_FRAMES and REG_CLOCK when EVE_pace_service() returned E_OK last */
+static uint32_t pace_due_clock = 0UL;
+static uint32_t pace_shown_frame = 0UL; /* REG_FRAMES when the last frame went on screen */
+static uint32_t pace_ref_frame = 0UL; /* REG_FRAMES and REG_CLOCK the refresh period is measured from */
+static uint32_t pace_ref_clock = 0UL;
+static uint32_t pace_ticks_us = 1UL; /* REG_CLOCK ticks per microsecond */
+static EVE_pace_stats_t pace_stats = {0UL, 0UL, 0UL, 0UL, 0UL, 1U};
+
+static void pace_int_callback(uint8_t int_flags)
+{
+    (void) int_flags;
+    pace_swapped = 1U;
+}
+
+/* read REG_FRAMES and REG_CLOCK in one transfer and measure the refresh period */
+static void pace_read(uint32_t *p_regs)
+{
+    uint32_t frames;
+
+    EVE_memRead_regs(REG_FRAMES, p_regs, 2U);
+    frames = p_regs[0U] - pace_ref_frame;
+
+    if (frames >= 8U)
+    {
+        pace_stats.refresh_us = ((p_regs[1U] - pace_ref_clock) / frames) / pace_ticks_us;
+
+        if (frames >= 64U) /* start over before the difference of REG_CLOCK can wrap around */
+        {
+            pace_ref_frame = p_regs[0U];
+            pace_ref_clock = p_regs[1U];
+        }
+    }
+}
+
+/* the last frame is on screen at refresh "shown", adapt the divider to how many refreshes it needed since it was due */
+static void pace_done(const uint32_t *p_regs, uint32_t shown)
+{
+    uint32_t needed = shown - pace_due_frame;
+    uint32_t interval = shown - pace_shown_frame;
+
+    pace_stats.build_us = (p_regs[1U] - pace_due_clock) / pace_ticks_us;
+
+    if ((0U != pace_in_slot) && (interval != pace_divider))
+    {
+        uint32_t deviation = (interval > pace_divider) ? (interval - pace_divider) : (pace_divider - interval);
+        uint32_t jitter = deviation * pace_stats.refresh_us;
+
+        if (jitter > pace_stats.jitter_max_us)
+        {
+            pace_stats.jitter_max_us = jitter;
+        }
+    }
+
+    if (needed > pace_divider)
+    {
+        pace_stats.missed++;
+        pace_divider = (needed < pace_divider_max) ? (uint8_t) needed : pace_divider_max;
+        pace_early = 0U;
+    }
+    else if (needed < pace_divider)
+    {
+        pace_early++;
+        if (pace_early >= EVE_PACE_SETTLE)
+        {
+            if (pace_divider > 1U) /* a frame can be on screen with the refresh it was due in, needed is 0 then */
+            {
+                pace_divider--;
+            }
+            pace_early = 0U;
+        }
+    }
+    else
+    {
+        pace_early = 0U;
+    }
+
+    pace_next = pace_due_frame + pace_divider;
+    if ((int32_t) (p_regs[0U] - pace_next) > 0) /* the slot is over already, send the next frame right away */
+    {
+        pace_next = p_regs[0U];
+    }
+    pace_shown_frame = shown;
+    pace_shown = 1U;
+    pace_stats.divider = pace_divider;
+    pace_pending = 0U;
+}
+
+/**
+ * @brief Set up the frame pacing, frames are sent every 1 to divider_max display refreshes.
+ * @param divider_max - the lowest frame rate is the refresh rate / divider_max
+ * @param use_interrupt - not zero to register a callback for EVE_INT_SWAP, the application calls EVE_int_service() then
+ * @note - Meant to be called after EVE_init() and outside display-list building.
+ * @note - CMD_SWAP already swaps the display list at the end of a refresh, there is no tearing. An animation is
+ * uneven when frames miss their refresh, the divider is raised then and lowered again after EVE_PACE_SETTLE frames
+ * in a row were on screen early enough.
+ */
+void EVE_pace_init(uint8_t divider_max, uint8_t use_interrupt)
+{
+    uint32_t regs[2U];
+    uint32_t frequency = EVE_memRead32(REG_FREQUENCY);
+
+    pace_ticks_us = (frequency >= 1000000UL) ? (frequency / 1000000UL) : 1UL;
+    pace_divider_max = (0U != divider_max) ? divider_max : 1U;
+    pace_divider = 1U;
+    pace_early = 0U;
+    pace_pending = 0U;
+    pace_swapped = 0U;
+    pace_shown = 0U;
+    pace_stats.frames = 0UL;
+    pace_stats.missed = 0UL;
+    pace_stats.jitter_max_us = 0UL;
+    pace_stats.build_us = 0UL;
+    pace_stats.divider = 1U;
+
+    EVE_memRead_regs(REG_FRAMES, regs, 2U);
+    pace_ref_frame = regs[0U];
+    pace_ref_clock = regs[1U];
+    pace_next = regs[0U];
+
+    pace_interrupt = (0U != use_interrupt) ? 1U : 0U;
+    if (0U != pace_interrupt)
+    {
+        EVE_int_set_callback(EVE_INT_SWAP, pace_int_callback);
+    }
+}
+
+/**
+ * @brief Check if the next frame is due, this is right after a refresh started so the coprocessor has the whole
+ * refresh to build the display list before the swap.
+ * @return - E_OK - if the next frame is to be sent now, followed by EVE_pace_sent()
+ * @return - EVE_IS_BUSY - if the last frame is not on screen yet or the next refresh for a frame did not start yet
+ * @note - Meant to be called from the main loop instead of a timer, each call reads REG_FRAMES and REG_CLOCK
+ * and calls EVE_busy() while the last frame is not done, with use_interrupt only after the swap interrupt.
+ */
+uint8_t EVE_pace_service(void)
+{
+    uint8_t ret = EVE_IS_BUSY;
+    uint32_t regs[2U] = {0UL, 0UL};
+
+    if (0U != pace_pending)
+    {
+        if (0U != pace_interrupt)
+        {
+            if (0U != pace_swapped)
+            {
+                pace_read(regs);
+                pace_done(regs, regs[0U]); /* REG_FRAMES was incremented with the swap */
+            }
+        }
+        else if (E_OK == EVE_busy())
+        {
+            pace_read(regs);
+            pace_done(regs, regs[0U] + 1U); /* the swap is at the end of the current refresh */
+        }
+        else
+        {
+        }
+    }
+    else
+    {
+        pace_read(regs);
+    }
+
+    if ((0U == pace_pending) && ((int32_t) (regs[0U] - pace_next) >= 0))
+    {
+        pace_in_slot = ((regs[0U] == pace_next) && (0U != pace_shown)) ? 1U : 0U;
+        pace_due_frame = regs[0U];
+        pace_due_clock = regs[1U];
+        ret = E_OK;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Tell the frame pacing that a frame with CMD_SWAP was sent, like after EVE_end_cmd_burst().
+ * @note - The time of the frame counts from when EVE_pace_service() returned E_OK, building it on the host included.
+ */
+void EVE_pace_sent(void)
+{
+    pace_swapped = 0U;
+    pace_pending = 1U;
+    pace_stats.frames++;
+}
+
+/**
+ * @brief Copy the numbers of the frame pacing to p_stats and optionally clear the counters.
+ */
+void EVE_pace_get_stats(EVE_pace_stats_t *p_stats, uint8_t clear)
+{
+    if (p_stats != NULL)
+    {
+        *p_stats = pace_stats;
+    }
+
+    if (0U != clear)
+    {
+        pace_stats.frames = 0UL;
+        pace_stats.missed = 0UL;
+        pace_stats.jitter_max_us = 0UL;
+    }
+}
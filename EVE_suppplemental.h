@@ -32,6 +32,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 5.0
 - added EVE_polar_cartesian()
+- added EVE_segment_t and the prototypes for the retained display-list segments
+- added the missing closing bracket for extern "C"
+- added the RAM_G heap: EVE_ram_stats_t and the prototypes for EVE_ram_init(), EVE_ram_alloc(), EVE_ram_free(),
+    EVE_ram_address(), EVE_ram_compact() and EVE_ram_get_stats()
+- changed EVE_segment_t to take the space for the copy from the RAM_G heap, removed EVE_segment_release_all()
+- added EVE_asset_t and the prototypes for the cache for assets from the external flash of BT81x
+- added EVE_text_t, EVE_text_stats_t and the prototypes for the text fields that are formatted on the host
+- added EVE_touch_event_t, EVE_touch_stats_t and the prototypes for the touch events
+- added EVE_list_row_t, EVE_list_t and the prototypes for the scrolling list
+- added EVE_chart_t and the prototypes for the charts
+- added EVE_pace_stats_t and the prototypes for the frame pacing
+- added the button and toggle text fields to EVE_text_t, a note on EVE_RAM_BLOCKS for pages with many fields
 
 */
 
@@ -41,13 +53,286 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "EVE.h"
 #include "EVE_commands.h"
 
+/* you may define these in your build-environment to use different settings */
+/* every retained segment takes a block, like every text field and every row of a list that is recorded, */
+/* a page with 120 text fields needs at least 128, the handles are 8 bit so the limit is 255 */
+#if !defined (EVE_RAM_BLOCKS)
+#define EVE_RAM_BLOCKS 32U /* maximum number of blocks that can be allocated from RAM_G at the same time */
+#endif
+
+#if EVE_RAM_BLOCKS > 255
+#error "EVE_RAM_BLOCKS is limited to 255 as the handles for the blocks are 8 bit"
+#endif
+
+#if !defined (EVE_ASSET_SLOTS)
+#define EVE_ASSET_SLOTS 16U /* maximum number of assets from the external flash that are in RAM_G at the same time */
+#endif
+
+#if !defined (EVE_TEXT_LENGTH)
+#define EVE_TEXT_LENGTH 16U /* maximum length of the string of a text field, including the terminating zero */
+#endif
+
+#if !defined (EVE_LIST_SLOTS)
+#define EVE_LIST_SLOTS 16U /* recorded rows of a list, more than fit in the window of the list at the same time */
+#endif
+
+#if !defined (EVE_TOUCH_EVENTS)
+#define EVE_TOUCH_EVENTS 16U /* size of the queue for touch events, a power of two up to 128 */
+#endif
+
+#if !defined (EVE_TOUCH_INTERVAL_MS)
+#define EVE_TOUCH_INTERVAL_MS 10U /* time between two samples while the screen is touched */
+#endif
+
+#if !defined (EVE_TOUCH_DEBOUNCE)
+#define EVE_TOUCH_DEBOUNCE 2U /* samples a finger has to be down or up before it is a press or a release */
+#endif
+
+#if !defined (EVE_TOUCH_DRAG_MIN)
+#define EVE_TOUCH_DRAG_MIN 4 /* pixels a finger has to move for a drag event */
+#endif
+
+#if !defined (EVE_TOUCH_LONG_MS)
+#define EVE_TOUCH_LONG_MS 800U /* time a finger has to be down without moving for a long-press event */
+#endif
+
+#if !defined (EVE_TOUCH_SWIPE_MIN)
+#define EVE_TOUCH_SWIPE_MIN 50 /* pixels between press and release for a swipe */
+#endif
+
+#if !defined (EVE_TOUCH_SWIPE_MS)
+#define EVE_TOUCH_SWIPE_MS 500U /* maximum time between press and release for a swipe */
+#endif
+
+#if !defined (EVE_PACE_SETTLE)
+#define EVE_PACE_SETTLE 60U /* frames in a row that are on screen early before the frame rate is raised again */
+#endif
+/* you may define these in your build-environment to use different settings */
+
+#define EVE_RAM_PNG_SCRATCH (42UL * 1024UL) /* the top of RAM_G that CMD_LOADIMAGE uses for PNG images */
+#define EVE_RAM_KEEP_PNG_SCRATCH 1U /* option for EVE_ram_init(), leave the top 42kiB of RAM_G out of the heap */
+#define EVE_RAM_NONE 0xffffffffUL /* returned by EVE_ram_address() for a handle that is not allocated */
+
+#define EVE_TOUCH_POINTS 5U /* touch points of FT811 / FT813 / BT815 / BT817 in extended mode */
+
+/* types of touch events */
+#define EVE_TOUCH_PRESS 1U
+#define EVE_TOUCH_RELEASE 2U
+#define EVE_TOUCH_DRAG 3U
+#define EVE_TOUCH_LONG 4U /* the finger is down for EVE_TOUCH_LONG_MS without a drag */
+#define EVE_TOUCH_SWIPE 5U /* sent before EVE_TOUCH_RELEASE for a fast move over EVE_TOUCH_SWIPE_MIN pixels */
+
+/* directions of EVE_TOUCH_SWIPE */
+#define EVE_SWIPE_LEFT 1U
+#define EVE_SWIPE_RIGHT 2U
+#define EVE_SWIPE_UP 3U
+#define EVE_SWIPE_DOWN 4U
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+/* state of the RAM_G heap */
+typedef struct
+{
+    uint32_t size; /* bytes in the heap */
+    uint32_t used; /* bytes in allocated blocks */
+    uint32_t largest_free; /* the largest block that could be allocated with 4 byte alignment */
+    uint8_t blocks; /* number of allocated blocks */
+    uint8_t fragmentation; /* percentage of the free bytes that are not in the largest free block */
+} EVE_ram_stats_t;
+
+/* function that writes the commands of a retained segment with the EVE_cmd_xxx() functions */
+typedef void (*EVE_segment_build_t)(void);
+
+/* a part of the display list that is recorded once and then put in every frame by CMD_APPEND */
+typedef struct
+{
+    EVE_segment_build_t p_build;
+    uint32_t inputs; /* the value for inputs the segment was recorded with */
+    uint16_t capacity; /* bytes in the block for the copy */
+    uint16_t length; /* bytes in the copy, 0 if the segment needs to be recorded */
+    uint16_t moves; /* value of the move counter of the heap when the segment was recorded */
+    uint8_t handle; /* the block in the RAM_G heap for the copy */
+    uint8_t generation; /* the handle is only valid while this matches the generation of the heap */
+} EVE_segment_t;
+
 void EVE_widget_circle(int16_t xc0, int16_t yc0, uint16_t radius, uint16_t border, uint32_t bgcolor);
 void EVE_widget_rectangle(int16_t xc0, int16_t yc0, int16_t wid, int16_t hgt, int16_t border, uint16_t linewidth, uint32_t bgcolor);
 void EVE_polar_cartesian(uint16_t length, uint16_t angle, int16_t *p_xc0, int16_t *p_yc0);
 
+void EVE_ram_init(uint8_t options);
+uint8_t EVE_ram_alloc(uint32_t size, uint32_t align);
+void EVE_ram_free(uint8_t handle);
+uint32_t EVE_ram_address(uint8_t handle);
+uint8_t EVE_ram_compact(void);
+void EVE_ram_get_stats(EVE_ram_stats_t *p_stats);
+
+#if EVE_GEN > 2
+
+/* an asset in the external flash, like a bitmap from the EVE Asset Builder */
+typedef struct
+{
+    uint32_t flash_address; /* relative to the flash so the first address is 0x000000 not 0x800000, 64 byte aligned */
+    uint32_t size; /* bytes */
+    uint8_t direct; /* not zero if the asset can be used directly from the flash, like ASTC bitmaps */
+} EVE_asset_t;
+
+void EVE_asset_init(const EVE_asset_t *p_assets, uint16_t count);
+uint8_t EVE_asset_load(const uint16_t *p_ids, uint8_t count);
+uint32_t EVE_asset_address(uint16_t asset_id);
+
+#endif /* EVE_GEN > 2 */
+
+void EVE_segment_init(EVE_segment_t *p_segment, EVE_segment_build_t p_build);
+uint8_t EVE_segment_update(EVE_segment_t *p_segment, uint32_t inputs);
+void EVE_segment_invalidate(EVE_segment_t *p_segment);
+void EVE_segment_append(const EVE_segment_t *p_segment);
+void EVE_segment_append_burst(const EVE_segment_t *p_segment);
+
+/* a text field that is formatted on the host and put in the display list as a recorded segment while it does not change, */
+/* shown as CMD_TEXT, CMD_BUTTON or CMD_TOGGLE */
+typedef struct
+{
+    EVE_segment_t segment; /* the recorded CMD_TEXT */
+    int16_t xc0;
+    int16_t yc0;
+    uint16_t font;
+    uint16_t options; /* options for the widget, without EVE_OPT_FORMAT */
+    uint16_t width; /* for CMD_BUTTON and CMD_TOGGLE */
+    uint16_t height; /* for CMD_BUTTON */
+    uint16_t state; /* for CMD_TOGGLE */
+    uint8_t widget; /* CMD_TEXT, CMD_BUTTON or CMD_TOGGLE, set by the init function */
+    uint32_t hash; /* over the string and the parameters, the inputs for the segment */
+    uint8_t changed; /* the string changed since the last EVE_text_burst() */
+    char text[EVE_TEXT_LENGTH];
+} EVE_text_t;
+
+/* counters for the text fields */
+typedef struct
+{
+    uint32_t frames; /* calls of EVE_text_burst() */
+    uint32_t texts; /* fields that were sent as CMD_TEXT */
+    uint32_t appends; /* fields that were added with CMD_APPEND */
+    uint32_t records; /* fields that were recorded by EVE_text_update() */
+    uint32_t saved_clocks; /* coprocessor time saved in the last frame, in REG_CLOCK ticks, after EVE_text_calibrate() */
+    uint32_t saved_total; /* saved_clocks summed up over all frames */
+} EVE_text_stats_t;
+
+void EVE_text_init(EVE_text_t *p_text, int16_t xc0, int16_t yc0, uint16_t font, uint16_t options);
+void EVE_text_init_button(EVE_text_t *p_text, int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
+                          uint16_t font, uint16_t options);
+void EVE_text_init_toggle(EVE_text_t *p_text, int16_t xc0, int16_t yc0, uint16_t wid, uint16_t font,
+                          uint16_t options, uint16_t state);
+void EVE_text_set_state(EVE_text_t *p_text, uint16_t state);
+void EVE_text_set(EVE_text_t *p_text, const char *p_string);
+void EVE_text_set_int(EVE_text_t *p_text, int32_t value, uint8_t decimals);
+void EVE_text_update(EVE_text_t *p_texts, uint16_t count);
+void EVE_text_burst(EVE_text_t *p_texts, uint16_t count);
+uint8_t EVE_text_calibrate(EVE_text_t *p_texts, uint16_t count);
+void EVE_text_get_stats(EVE_text_stats_t *p_stats, uint8_t clear);
+
+/* function that writes the commands for one row of a list with the EVE_cmd_xxx() functions, */
+/* relative to the top left corner of the row at 0 / 0 */
+typedef void (*EVE_list_row_t)(uint16_t row);
+
+/* a scrolling list that only puts the rows in the window in the display list, as recorded segments */
+typedef struct
+{
+    EVE_segment_t slots[EVE_LIST_SLOTS]; /* slot n holds a row with row % EVE_LIST_SLOTS == n */
+    EVE_list_row_t p_row;
+    int32_t offset; /* scroll position in 1/16 pixel, 0 for the first row at the top of the window */
+    int32_t velocity; /* 1/16 pixel per EVE_list_update() */
+    int16_t xc0; /* the window */
+    int16_t yc0;
+    uint16_t width;
+    uint16_t height;
+    uint16_t row_height;
+    uint16_t rows;
+    uint8_t dragging;
+} EVE_list_t;
+
+void EVE_list_init(EVE_list_t *p_list, EVE_list_row_t p_row, uint16_t rows, uint16_t row_height);
+void EVE_list_window(EVE_list_t *p_list, int16_t xc0, int16_t yc0, uint16_t width, uint16_t height);
+void EVE_list_set_rows(EVE_list_t *p_list, uint16_t rows);
+void EVE_list_invalidate(EVE_list_t *p_list);
+void EVE_list_drag(EVE_list_t *p_list, int16_t delta);
+void EVE_list_release(EVE_list_t *p_list);
+void EVE_list_track(EVE_list_t *p_list, uint32_t tracker);
+int32_t EVE_list_row_at(const EVE_list_t *p_list, int16_t yc0);
+void EVE_list_update(EVE_list_t *p_list);
+void EVE_list_burst(const EVE_list_t *p_list);
+
+/* a chart of the last width samples, kept in a ring in RAM_G that is shown as BARGRAPH bitmaps of up to 256 samples */
+typedef struct
+{
+    int16_t xc0; /* the area of the chart */
+    int16_t yc0;
+    uint16_t width; /* samples shown, one per pixel */
+    uint16_t height;
+    uint16_t length; /* bytes in the ring, a power of two */
+    uint16_t head; /* where the next sample goes */
+    uint8_t handle; /* the block in the RAM_G heap for the ring */
+    uint8_t generation; /* the handle is only valid while this matches the generation of the heap */
+    uint8_t bitmap; /* the bitmap handle */
+    uint8_t line; /* thickness of the line in pixels, 0 for a filled area */
+} EVE_chart_t;
+
+uint8_t EVE_chart_init(EVE_chart_t *p_chart, uint8_t bitmap, int16_t xc0, int16_t yc0, uint16_t width, uint16_t height);
+void EVE_chart_free(EVE_chart_t *p_chart);
+void EVE_chart_line(EVE_chart_t *p_chart, uint8_t thickness);
+void EVE_chart_add(EVE_chart_t *p_chart, uint8_t level);
+void EVE_chart_add_block(EVE_chart_t *p_chart, const uint8_t *p_levels, uint16_t count);
+void EVE_chart_clear(EVE_chart_t *p_chart);
+void EVE_chart_burst(const EVE_chart_t *p_chart);
+
+/* an event from EVE_touch_get_event() */
+typedef struct
+{
+    uint32_t time_ms; /* the time that was passed to EVE_touch_service() */
+    int16_t xc0; /* where the finger is, for EVE_TOUCH_RELEASE and EVE_TOUCH_SWIPE where it was last */
+    int16_t yc0;
+    int16_t dx; /* distance from where the finger went down */
+    int16_t dy;
+    uint8_t type; /* EVE_TOUCH_PRESS, EVE_TOUCH_RELEASE, EVE_TOUCH_DRAG, EVE_TOUCH_LONG or EVE_TOUCH_SWIPE */
+    uint8_t finger; /* the touch point, 0 to EVE_TOUCH_POINTS - 1 */
+    uint8_t tag; /* the tag under the finger when it went down */
+    uint8_t direction; /* EVE_SWIPE_LEFT, EVE_SWIPE_RIGHT, EVE_SWIPE_UP or EVE_SWIPE_DOWN for EVE_TOUCH_SWIPE, 0 otherwise */
+} EVE_touch_event_t;
+
+/* counters for the touch events */
+typedef struct
+{
+    uint32_t wakeups; /* touch interrupts */
+    uint32_t samples; /* reads of the touch registers */
+    uint32_t events; /* events put in the queue */
+    uint32_t dropped; /* events that were lost as the queue was full */
+} EVE_touch_stats_t;
+
+void EVE_touch_init(uint8_t points);
+uint8_t EVE_touch_service(uint32_t time_ms);
+uint8_t EVE_touch_get_event(EVE_touch_event_t *p_event);
+void EVE_touch_get_stats(EVE_touch_stats_t *p_stats, uint8_t clear);
+
+/* numbers from the frame pacing */
+typedef struct
+{
+    uint32_t frames; /* frames sent, calls of EVE_pace_sent() */
+    uint32_t missed; /* frames that needed more refreshes than the divider to be on screen */
+    uint32_t jitter_max_us; /* largest deviation of the time between two frames sent in their slot from divider refreshes */
+    uint32_t refresh_us; /* the measured time of one display refresh */
+    uint32_t build_us; /* time from the last frame being due until it was done, or on screen with use_interrupt */
+    uint8_t divider; /* frames are sent every divider refreshes */
+} EVE_pace_stats_t;
+
+void EVE_pace_init(uint8_t divider_max, uint8_t use_interrupt);
+uint8_t EVE_pace_service(void);
+void EVE_pace_sent(void);
+void EVE_pace_get_stats(EVE_pace_stats_t *p_stats, uint8_t clear);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* EVE_SUPPLEMENTAL_H */
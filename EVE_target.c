@@ -57,6 +57,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - Bugfix issue #89: ESP32 not initializing if GPIO pin number > 31
 - moved the include for EVE_target.h to avoid the empty translation unit warning
  from -Wpedantic when building for Arduino
+- added the SOFTWARE_TEST target for Linux
+- added spi_receive_block() with full-duplex DMA for ATSAMx51 and RP2040
+- removed the definitions of EVE_dma_buffer, the DMA buffers are in EVE_commands.c now
+- added EVE_PIO for RP2040, spi_set_width(), EVE_pio_transmit() and EVE_pio_receive() for dual and quad SPI with a PIO state machine
 
  */
 
@@ -93,7 +97,6 @@ void DELAY_MS(uint16_t val)
 
 static DmacDescriptor dmadescriptor __attribute__((aligned(16)));
 static DmacDescriptor dmawriteback __attribute__((aligned(16)));
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -168,9 +171,11 @@ void DELAY_MS(uint16_t val)
 
 #if defined (EVE_DMA)
 
-static DmacDescriptor dmadescriptor __attribute__((aligned(16)));
-static DmacDescriptor dmawriteback __attribute__((aligned(16)));
-uint32_t EVE_dma_buffer[1025U];
+/* the descriptors are indexed by the channel number */
+#define EVE_DMA_DESCRIPTORS (((EVE_DMA_CHANNEL > EVE_DMA_CHANNEL_RX) ? EVE_DMA_CHANNEL : EVE_DMA_CHANNEL_RX) + 1U)
+
+static DmacDescriptor dmadescriptor[EVE_DMA_DESCRIPTORS] __attribute__((aligned(16)));
+static DmacDescriptor dmawriteback[EVE_DMA_DESCRIPTORS] __attribute__((aligned(16)));
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -181,20 +186,31 @@ void EVE_init_dma(void)
     DMAC->CTRL.bit.SWRST = 1;
     while (DMAC->CTRL.bit.SWRST); /* wait for the software-reset to be complete */
 
-    DMAC->BASEADDR.reg = (uint32_t) &dmadescriptor;
-    DMAC->WRBADDR.reg = (uint32_t) &dmawriteback;
-    DMAC->CTRL.reg = DMAC_CTRL_LVLEN0 | DMAC_CTRL_DMAENABLE; /* enable level 0 transfers, enable DMA */
+    DMAC->BASEADDR.reg = (uint32_t) &dmadescriptor[0];
+    DMAC->WRBADDR.reg = (uint32_t) &dmawriteback[0];
+    DMAC->CTRL.reg = DMAC_CTRL_LVLEN0 | DMAC_CTRL_LVLEN1 | DMAC_CTRL_DMAENABLE; /* enable level 0 and 1 transfers, enable DMA */
     DMAC->Channel[EVE_DMA_CHANNEL].CHCTRLA.reg =
         DMAC_CHCTRLA_BURSTLEN_SINGLE |
         DMAC_CHCTRLA_TRIGACT_BURST |
         DMAC_CHCTRLA_TRIGSRC(EVE_SPI_DMA_TRIGGER);
 
-    dmadescriptor.BTCTRL.reg = DMAC_BTCTRL_SRCINC | DMAC_BTCTRL_VALID; /* increase source-address, beat-size = 8-bit */
-    dmadescriptor.DSTADDR.reg = (uint32_t) &EVE_SPI_SERCOM->SPI.DATA.reg;
-    dmadescriptor.DESCADDR.reg = 0; /* no next descriptor */
+    dmadescriptor[EVE_DMA_CHANNEL].BTCTRL.reg = DMAC_BTCTRL_SRCINC | DMAC_BTCTRL_VALID; /* increase source-address, beat-size = 8-bit */
+    dmadescriptor[EVE_DMA_CHANNEL].DSTADDR.reg = (uint32_t) &EVE_SPI_SERCOM->SPI.DATA.reg;
+    dmadescriptor[EVE_DMA_CHANNEL].DESCADDR.reg = 0; /* no next descriptor */
+
+    /* the receive channel is only used by spi_receive_block(), it has the higher priority to not lose any byte */
+    DMAC->Channel[EVE_DMA_CHANNEL_RX].CHCTRLA.reg =
+        DMAC_CHCTRLA_BURSTLEN_SINGLE |
+        DMAC_CHCTRLA_TRIGACT_BURST |
+        DMAC_CHCTRLA_TRIGSRC(EVE_SPI_DMA_TRIGGER_RX);
+    DMAC->Channel[EVE_DMA_CHANNEL_RX].CHPRILVL.reg = DMAC_CHPRILVL_PRILVL_LVL1;
+
+    dmadescriptor[EVE_DMA_CHANNEL_RX].BTCTRL.reg = DMAC_BTCTRL_DSTINC | DMAC_BTCTRL_VALID; /* increase destination-address, beat-size = 8-bit */
+    dmadescriptor[EVE_DMA_CHANNEL_RX].SRCADDR.reg = (uint32_t) &EVE_SPI_SERCOM->SPI.DATA.reg;
+    dmadescriptor[EVE_DMA_CHANNEL_RX].DESCADDR.reg = 0; /* no next descriptor */
 
     DMAC->Channel[EVE_DMA_CHANNEL].CHINTENSET.bit.TCMPL = 1; /* enable transfer complete interrupt */
-    DMAC->CTRL.reg = DMAC_CTRL_LVLEN0 | DMAC_CTRL_DMAENABLE; /* enable level 0 transfers, enable DMA */
+    DMAC->CTRL.reg = DMAC_CTRL_LVLEN0 | DMAC_CTRL_LVLEN1 | DMAC_CTRL_DMAENABLE; /* enable level 0 and 1 transfers, enable DMA */
 
     NVIC_SetPriority(DMAC_0_IRQn, 0);
     NVIC_EnableIRQ(DMAC_0_IRQn);
@@ -202,8 +218,8 @@ void EVE_init_dma(void)
 
 void EVE_start_dma_transfer(void)
 {
-    dmadescriptor.BTCNT.reg = (EVE_dma_buffer_index * 4U) - 1U;
-    dmadescriptor.SRCADDR.reg = (uint32_t) &EVE_dma_buffer[EVE_dma_buffer_index]; /* note: last entry in array + 1 */
+    dmadescriptor[EVE_DMA_CHANNEL].BTCNT.reg = (EVE_dma_buffer_index * 4U) - 1U;
+    dmadescriptor[EVE_DMA_CHANNEL].SRCADDR.reg = (uint32_t) &EVE_dma_buffer[EVE_dma_buffer_index]; /* note: last entry in array + 1 */
     EVE_SPI_SERCOM->SPI.CTRLB.bit.RXEN = 0; /* switch receiver off by setting RXEN to 0 which is not enable-protected */
     EVE_cs_set();
     DMAC->Channel[EVE_DMA_CHANNEL].CHCTRLA.bit.ENABLE = 1; /* start sending out EVE_dma_buffer */
@@ -220,6 +236,33 @@ void DMAC_0_Handler()
     EVE_cs_clear();
 }
 
+/* full-duplex read, the transmit channel clocks out dummy bytes from a fixed address */
+/* and the receive channel stores the bytes, this blocks until the last byte is in */
+void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    static const uint8_t dummy = 0U;
+
+    if (length > 0U)
+    {
+        DMAC->Channel[EVE_DMA_CHANNEL].CHINTENCLR.reg = DMAC_CHINTENCLR_TCMPL; /* DMAC_0_Handler() must not clear the chip-select */
+
+        dmadescriptor[EVE_DMA_CHANNEL_RX].BTCNT.reg = length;
+        dmadescriptor[EVE_DMA_CHANNEL_RX].DSTADDR.reg = (uint32_t) &p_data[length]; /* note: last entry in array + 1 */
+        dmadescriptor[EVE_DMA_CHANNEL].BTCTRL.reg = DMAC_BTCTRL_VALID; /* fixed source-address, beat-size = 8-bit */
+        dmadescriptor[EVE_DMA_CHANNEL].BTCNT.reg = length;
+        dmadescriptor[EVE_DMA_CHANNEL].SRCADDR.reg = (uint32_t) &dummy;
+
+        DMAC->Channel[EVE_DMA_CHANNEL_RX].CHCTRLA.bit.ENABLE = 1;
+        DMAC->Channel[EVE_DMA_CHANNEL].CHCTRLA.bit.ENABLE = 1;
+        while (0U == (DMAC->Channel[EVE_DMA_CHANNEL_RX].CHINTFLAG.reg & DMAC_CHINTFLAG_TCMPL)) {}
+
+        DMAC->Channel[EVE_DMA_CHANNEL_RX].CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL;
+        DMAC->Channel[EVE_DMA_CHANNEL].CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL;
+        dmadescriptor[EVE_DMA_CHANNEL].BTCTRL.reg = DMAC_BTCTRL_SRCINC | DMAC_BTCTRL_VALID;
+        DMAC->Channel[EVE_DMA_CHANNEL].CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+    }
+}
+
 #endif /* DMA */
 #endif /* ATSAMx51 */
 
@@ -295,7 +338,6 @@ void EVE_init_spi(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -414,7 +456,6 @@ void EVE_init_spi(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -442,6 +483,14 @@ void EVE_start_dma_transfer(void)
 #if defined (RP2040)
 /* note: set in platformio.ini by "build_flags = -D RP2040" */
 
+#if defined (EVE_PIO)
+#include "hardware/clocks.h"
+
+uint8_t EVE_spi_lines = 1U;
+static uint pio_offset_x2;
+static uint pio_offset_x4;
+#endif
+
 void EVE_init_spi(void)
 {
     // chip select is active-low -> initialized to high
@@ -458,18 +507,118 @@ void EVE_init_spi(void)
     gpio_set_function(EVE_MISO, GPIO_FUNC_SPI);
     gpio_set_function(EVE_SCK, GPIO_FUNC_SPI);
     gpio_set_function(EVE_MOSI, GPIO_FUNC_SPI);
+
+#if defined (EVE_PIO)
+    pio_offset_x2 = pio_add_program(EVE_PIO_INSTANCE, &eve_spi_x2_program);
+    pio_offset_x4 = pio_add_program(EVE_PIO_INSTANCE, &eve_spi_x4_program);
+    EVE_spi_lines = 1U;
+#endif
+}
+
+#if defined (EVE_PIO)
+
+/* switch the pins between EVE_SPI for single SPI and the PIO state machine for dual and quad SPI */
+void spi_set_width(uint8_t lines)
+{
+    uint32_t const pin_mask = (1UL << EVE_SCK) | (15UL << EVE_MOSI);
+    pio_sm_config config;
+    uint offset = pio_offset_x4;
+
+    pio_sm_set_enabled(EVE_PIO_INSTANCE, EVE_PIO_SM, false);
+
+    if ((2U == lines) || (4U == lines))
+    {
+        if (2U == lines)
+        {
+            offset = pio_offset_x2;
+            config = eve_spi_x2_program_get_default_config(offset);
+        }
+        else
+        {
+            config = eve_spi_x4_program_get_default_config(offset);
+        }
+
+        sm_config_set_out_pins(&config, EVE_MOSI, lines);
+        sm_config_set_set_pins(&config, EVE_MOSI, lines);
+        sm_config_set_in_pins(&config, EVE_MOSI);
+        sm_config_set_sideset_pins(&config, EVE_SCK);
+        sm_config_set_out_shift(&config, false, true, 8U); /* MSB first, autopull */
+        sm_config_set_in_shift(&config, false, true, 8U); /* MSB first, autopush */
+        /* two PIO cycles per clock cycle, the same clock as EVE_SPI */
+        sm_config_set_clkdiv(&config, (float) clock_get_hz(clk_sys) / (2.0f * (float) spi_get_baudrate(EVE_SPI)));
+
+        pio_sm_set_pins_with_mask(EVE_PIO_INSTANCE, EVE_PIO_SM, 0U, pin_mask);
+        pio_sm_set_pindirs_with_mask(EVE_PIO_INSTANCE, EVE_PIO_SM, pin_mask, pin_mask);
+        pio_gpio_init(EVE_PIO_INSTANCE, EVE_SCK);
+        for (uint8_t pin = 0U; pin < 4U; pin++)
+        {
+            pio_gpio_init(EVE_PIO_INSTANCE, EVE_MOSI + pin);
+        }
+
+        pio_sm_init(EVE_PIO_INSTANCE, EVE_PIO_SM, offset, &config);
+        pio_sm_set_enabled(EVE_PIO_INSTANCE, EVE_PIO_SM, true);
+        EVE_spi_lines = lines;
+    }
+    else
+    {
+        gpio_set_function(EVE_MISO, GPIO_FUNC_SPI);
+        gpio_set_function(EVE_SCK, GPIO_FUNC_SPI);
+        gpio_set_function(EVE_MOSI, GPIO_FUNC_SPI);
+        gpio_init(EVE_MOSI + 2U); /* IO2 and IO3 are not used with single SPI */
+        gpio_init(EVE_MOSI + 3U);
+        EVE_spi_lines = 1U;
+    }
+}
+
+/* the header tells the state machine how many clock cycles to write, */
+/* this returns when the state machine is waiting for the next header with the last clock cycle done */
+void EVE_pio_transmit(const uint8_t *p_data, uint32_t length)
+{
+    uint32_t const stall = 1UL << (PIO_FDEBUG_TXSTALL_LSB + EVE_PIO_SM);
+
+    if (length > 0U)
+    {
+        pio_sm_put_blocking(EVE_PIO_INSTANCE, EVE_PIO_SM, ((length * 8UL) / EVE_spi_lines) - 1UL);
+        for (uint32_t index = 0U; index < length; index++)
+        {
+            while (pio_sm_is_tx_fifo_full(EVE_PIO_INSTANCE, EVE_PIO_SM))
+            {
+            }
+            *((io_rw_8 *) &EVE_PIO_INSTANCE->txf[EVE_PIO_SM]) = p_data[index]; /* the byte is in bits 31..24 as well */
+        }
+        EVE_PIO_INSTANCE->fdebug = stall;
+        while (0U == (EVE_PIO_INSTANCE->fdebug & stall))
+        {
+        }
+    }
 }
 
+/* bit 31 of the header makes the state machine release the data lines and read */
+void EVE_pio_receive(uint8_t *p_data, uint32_t length)
+{
+    if (length > 0U)
+    {
+        pio_sm_put_blocking(EVE_PIO_INSTANCE, EVE_PIO_SM, 0x80000000UL | (((length * 8UL) / EVE_spi_lines) - 1UL));
+        for (uint32_t index = 0U; index < length; index++)
+        {
+            p_data[index] = (uint8_t) pio_sm_get_blocking(EVE_PIO_INSTANCE, EVE_PIO_SM);
+        }
+    }
+}
+
+#endif /* EVE_PIO */
+
 #if defined (EVE_DMA)
 
 #include "hardware/dma.h"
 #include "hardware/irq.h"
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 int dma_tx;
 dma_channel_config dma_tx_config;
+int dma_rx;
+dma_channel_config dma_rx_config;
 
 static void EVE_DMA_handler(void)
 {
@@ -486,6 +635,14 @@ void EVE_init_dma(void)
     channel_config_set_transfer_data_size(&dma_tx_config, DMA_SIZE_8);
     channel_config_set_dreq(&dma_tx_config, spi_get_index(EVE_SPI) ? DREQ_SPI1_TX : DREQ_SPI0_TX);
     dma_channel_set_irq0_enabled (dma_tx, true);
+
+    /* the receive channel is only used by spi_receive_block() */
+    dma_rx = dma_claim_unused_channel(true);
+    dma_rx_config = dma_channel_get_default_config(dma_rx);
+    channel_config_set_transfer_data_size(&dma_rx_config, DMA_SIZE_8);
+    channel_config_set_read_increment(&dma_rx_config, false);
+    channel_config_set_write_increment(&dma_rx_config, true);
+    channel_config_set_dreq(&dma_rx_config, spi_get_index(EVE_SPI) ? DREQ_SPI1_RX : DREQ_SPI0_RX);
     irq_set_exclusive_handler(DMA_IRQ_0, EVE_DMA_handler);
     irq_set_enabled(DMA_IRQ_0, true);
 }
@@ -500,6 +657,35 @@ void EVE_start_dma_transfer(void)
         true); // start transfer
     EVE_dma_busy = 42;
 }
+
+/* full-duplex read, the transmit channel clocks out dummy bytes from a fixed address */
+/* and the receive channel stores the bytes, this blocks until the last byte is in */
+void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    static const uint8_t dummy = 0U;
+    dma_channel_config tx_config = dma_tx_config;
+
+    if (length > 0U)
+    {
+        channel_config_set_read_increment(&tx_config, false);
+        dma_channel_set_irq0_enabled(dma_tx, false); /* EVE_DMA_handler() must not clear the chip-select */
+
+        dma_channel_configure(dma_rx, &dma_rx_config,
+            p_data, // write address
+            &spi_get_hw(EVE_SPI)->dr, // read address
+            length, // element count
+            true); // start transfer
+        dma_channel_configure(dma_tx, &tx_config,
+            &spi_get_hw(EVE_SPI)->dr, // write address
+            &dummy, // read address
+            length, // element count
+            true); // start transfer
+        dma_channel_wait_for_finish_blocking(dma_rx);
+
+        dma_hw->ints0 = 1U << dma_tx; /* ack irq */
+        dma_channel_set_irq0_enabled(dma_tx, true);
+    }
+}
 #endif /* DMA */
 
 #endif /* RP2040 */
@@ -542,7 +728,6 @@ void EVE_init_spi(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -657,7 +842,6 @@ void EVE_init_spi(void)
 
 #if defined (EVE_DMA)
 
-uint32_t EVE_dma_buffer[1025U];
 volatile uint16_t EVE_dma_buffer_index = 0;
 volatile uint8_t EVE_dma_busy = 0;
 
@@ -707,6 +891,42 @@ void DMA0_Channel2_IRQHandler(void)
 #endif /* DMA */
 #endif /* GD32C103 */
 
+/* ################################################################## */
+/* ################################################################## */
+
+#if defined (SOFTWARE_TEST)
+
+#if defined (EVE_DMA)
+
+volatile uint16_t EVE_dma_buffer_index = 0;
+volatile uint8_t EVE_dma_busy = 0;
+
+void EVE_init_dma(void)
+{
+}
+
+/* there is no DMA controller, the buffer is sent right away and the transfer is complete on return */
+void EVE_start_dma_transfer(void)
+{
+    EVE_dma_busy = 42;
+    EVE_cs_set();
+    for (uint16_t index = 0U; index < EVE_dma_buffer_index; index++)
+    {
+        if (index != 0U)
+        {
+            spi_transmit((uint8_t) EVE_dma_buffer[index]); /* skip the first byte, the address only has three bytes */
+        }
+        spi_transmit((uint8_t) (EVE_dma_buffer[index] >> 8U));
+        spi_transmit((uint8_t) (EVE_dma_buffer[index] >> 16U));
+        spi_transmit((uint8_t) (EVE_dma_buffer[index] >> 24U));
+    }
+    EVE_cs_clear();
+    EVE_dma_busy = 0;
+}
+
+#endif /* DMA */
+#endif /* SOFTWARE_TEST */
+
 #endif /* __GNUC__ */
 
 /* ################################################################## */
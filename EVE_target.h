@@ -78,6 +78,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - basic maintenance: checked for violations of white space and indent rules
 - fix: wrong target definition file names for XMEGA and AVR
 - added STM32G0
+- added the SOFTWARE_TEST target for Linux
 - added ARDUINO_TEENSY40 to the Teensy 4 target
 - added ARDUINO_UNOR4_MINIMA and ARDUINO_UNOR4_WIFI targets
 - added ARDUINO_GIGA target
@@ -89,6 +90,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - modified the RISC-V entry as there are ESP32 now with RISC-V core
 - added detection of the Tasking compiler and added tc38x and tc39xb targets
 - removed the unfortunately defunct WIZIOPICO
+- added spi_transmit_block() to all targets
+- added spi_receive_block() to all targets
+- changed EVE_dma_buffer to a pointer into a ring of EVE_DMA_BUFFERS buffers in EVE_commands.c
+- added EVE_burst_words and EVE_burst_segment() for spi_transmit_burst() in all targets
+- added a note on how to connect INT_N to EVE_int_edge()
+- added a note on how to connect more than one EVE with EVE_ctx_t
+- added EVE_SPI_WIDTH_MAX and a note on dual and quad SPI
+- added EVE_SPI_CLOCK_INIT, EVE_SPI_CLOCK_STEP and a note on EVE_SPI_CLOCK_MAX for EVE_ramp_spi_clock()
 
 */
 
@@ -129,11 +138,91 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
     the transfer of the SPI buffer by DMA.
   EVE_busy() does nothing but to report that EVE is busy
     if there is an active DMA transfer.
+  There are EVE_DMA_BUFFERS buffers in EVE_commands.c and EVE_dma_buffer
+    points to the one the current burst goes into.
+    When the DMA is still busy with the last buffer EVE_end_cmd_burst()
+    queues the buffer and the next burst goes into the next free buffer,
+    EVE_busy() starts the transfer of a queued buffer as soon as the DMA
+    is idle and REG_CMDB_SPACE shows enough room for it.
+    EVE_start_cmd_burst() only waits when all buffers are in use.
+
   At the end of the DMA transfer an IRQ is executed which clears the DMA
     active state and calls EVE_cs_clear() by which the command buffer
     is executed by the command co-processor.
+
+  A burst can be longer than the DMA buffer and the CMD-FIFO.
+  spi_transmit_burst() counts down EVE_burst_words and calls EVE_burst_segment()
+  when the DMA buffer or the known free space in the CMD-FIFO is used up.
+  EVE_burst_segment() ends the segment, waits for room and starts the next one.
+  With DMA the segment is queued like with EVE_end_cmd_burst(), without DMA
+  chip-select is released and REG_CMDB_SPACE is polled.
+
+  Blocks of data like the images for EVE_cmd_loadimage() or the payload
+  for EVE_cmd_inflate() and EVE_memWrite_sram_buffer() are sent with
+  spi_transmit_block(). The default is a loop over spi_transmit(),
+  targets can do better by filling the SPI FIFO without waiting for every byte
+  or by using DMA, this is implemented for ATSAMx5x, ATSAMC21, ATSAMD2x, STM32,
+  RP2040 and ESP32.
+  Targets that need fetch_flash_byte() to read from FLASH define
+  EVE_FLASH_NOT_MAPPED and keep the byte-wise loop for data from FLASH.
+
+  EVE_memRead_sram_buffer() reads with spi_receive_block(), the default is a
+  loop over spi_receive(). ATSAMx5x, ATSAMC21, ATSAMD2x and STM32 with a RX FIFO
+  keep one dummy byte in flight, RP2040 uses spi_read_blocking() and ESP32
+  reads with DMA. With EVE_DMA defined ATSAMx5x and RP2040 use a second
+  DMA channel for a full-duplex transfer, spi_receive_block() blocks until
+  the last byte is in.
+
+  INT_N of EVE is not handled by the targets as the pin and the external
+  interrupt are specific to the board. To use the interrupts, configure INT_N
+  as input with an interrupt on the falling edge and call EVE_int_edge()
+  from the interrupt handler, EVE_int_service() in the main loop then reads
+  REG_INT_FLAGS and calls the functions registered with EVE_int_set_callback().
+
+  More than one EVE can be connected with one EVE_ctx_t for each EVE, all calls go to the EVE
+  of the context that was made the current one with EVE_ctx_select().
+  The targets only know one chip-select, the p_bus_select function of the context
+  switches it over, for example with EVE_CS defined to a variable in the build-environment
+  that p_bus_select sets to the pin of the EVE. Use EVE_ctx_int_edge() for INT_N then.
+
+  EVE can use 2 or 4 data lines for the SPI, EVE_set_spi_width() switches EVE with REG_SPI_WIDTH
+  and then the host with spi_set_width(). The target defines EVE_SPI_WIDTH_MAX to the number
+  of data lines it supports and implements spi_set_width(), the other SPI functions stay the same
+  and transfer the same bytes, only faster. This is implemented for STM32 with QUADSPI
+  when EVE_QSPI is defined and for RP2040 with a PIO state machine when EVE_PIO is defined,
+  both are not implemented for EVE_DMA and stop the build with an #error when EVE_DMA is defined.
+  With more than one EVE p_bus_select has to set the width
+  that was used with EVE_set_spi_width() for the EVE it selects.
+
+  With EVE_SPI_CLOCK_MAX defined in the build-environment EVE_init() starts with the SPI
+  at EVE_SPI_CLOCK_INIT and ends with EVE_ramp_spi_clock(). This raises the SPI clock
+  in steps of EVE_SPI_CLOCK_STEP up to EVE_SPI_CLOCK_MAX and keeps the fastest clock
+  a test pattern in RAM_G could be written and read back with, EVE_get_spi_clock() tells which one.
+  The target has to implement spi_set_clock(), it sets the fastest clock the SPI can do
+  that is not above the requested one and returns it, and defines EVE_HAS_SPI_SET_CLOCK.
+  This is implemented for the software test target, RP2040, AVR and for STM32 with EVE_SPI_PCLK
+  defined to the clock of the SPI or QUADSPI, the other targets stop the build with an #error.
 */
 
+/* you may define these in your build-environment to use different settings */
+#if defined (EVE_DMA) && !defined (EVE_DMA_BUFFERS)
+#define EVE_DMA_BUFFERS 2U /* number of DMA buffers, 1 to not overlap building the next burst with the transfer */
+#endif
+/* you may define these in your build-environment to use different settings */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint16_t EVE_burst_words; /* words spi_transmit_burst() can write before it needs to call EVE_burst_segment() */
+void EVE_burst_segment(void);
+
+#ifdef __cplusplus
+}
+#endif
+
 #if !defined (ARDUINO)
 
 #if defined (__IMAGECRAFT__)
@@ -285,6 +374,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 /* ################################################################## */
 /* ################################################################## */
 
+#if defined (SOFTWARE_TEST)
+/* note: set in the build-environment to run the library on a PC against the model in EVE_model.c */
+
+#include "EVE_target/EVE_target_Test.h"
+
+#endif /* SOFTWARE_TEST */
+
+/* ################################################################## */
+/* ################################################################## */
+
 #endif /* __GNUC__ */
 
 /* ################################################################## */
@@ -400,4 +499,22 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #endif /* Arduino */
 
+/* targets that support dual or quad SPI define EVE_SPI_WIDTH_MAX and spi_set_width() */
+#if !defined (EVE_SPI_WIDTH_MAX)
+#define EVE_SPI_WIDTH_MAX 1U
+#endif
+
+/* EVE_SPI_CLOCK_MAX enables EVE_ramp_spi_clock(), the target needs to implement spi_set_clock() */
+#if defined (EVE_SPI_CLOCK_MAX)
+#if !defined (EVE_SPI_CLOCK_INIT)
+#define EVE_SPI_CLOCK_INIT 11000000UL /* FT8xx / BT8xx need the SPI at 11 MHz or less for the init */
+#endif
+#if !defined (EVE_SPI_CLOCK_STEP)
+#define EVE_SPI_CLOCK_STEP 2000000UL
+#endif
+#if !defined (EVE_HAS_SPI_SET_CLOCK)
+#error "EVE_SPI_CLOCK_MAX needs spi_set_clock(), it is not implemented for this target"
+#endif
+#endif
+
 #endif /* EVE_TARGET_H_ */
@@ -32,6 +32,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 5.0
 - derived from EVE_target_ATSAMC21.h
+- added spi_transmit_block()
+- added spi_receive_block()
+- changed EVE_dma_buffer to a pointer, the buffers are in EVE_commands.c now
+- spi_transmit_burst() calls EVE_burst_segment() when the current segment of a burst is full
 
 */
 
@@ -134,7 +138,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #endif
 
 #if defined (EVE_DMA)
-    extern uint32_t EVE_dma_buffer[1025U];
+    extern uint32_t *EVE_dma_buffer;
     extern volatile uint16_t EVE_dma_buffer_index;
     extern volatile uint8_t EVE_dma_busy;
 
@@ -183,6 +187,12 @@ static inline void spi_transmit_32(uint32_t data)
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
+    if (0U == EVE_burst_words) /* the DMA buffer or the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
+
 #if defined (EVE_DMA)
     EVE_dma_buffer[EVE_dma_buffer_index++] = data;
 #else
@@ -190,6 +200,22 @@ static inline void spi_transmit_burst(uint32_t data)
 #endif
 }
 
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* the receiver is off during the transfer so the next byte can go out as soon as DATA is empty */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    EVE_SPI_SERCOM->SPI.CTRLB.bit.RXEN = 0; /* switch receiver off by setting RXEN to 0 which is not enable-protected */
+
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        while (0U == (EVE_SPI_SERCOM->SPI.INTFLAG.reg & SERCOM_SPI_INTFLAG_DRE)) {}
+        EVE_SPI_SERCOM->SPI.DATA.reg = p_data[count];
+    }
+
+    while (0U == (EVE_SPI_SERCOM->SPI.INTFLAG.reg & SERCOM_SPI_INTFLAG_TXC)) {}
+    EVE_SPI_SERCOM->SPI.CTRLB.bit.RXEN = 1; /* switch receiver on by setting RXEN to 1 which is not enable protected */
+}
+
 static inline uint8_t spi_receive(uint8_t data)
 {
     EVE_SPI_SERCOM->SPI.DATA.reg = data;
@@ -197,6 +223,27 @@ static inline uint8_t spi_receive(uint8_t data)
     return (EVE_SPI_SERCOM->SPI.DATA.reg);
 }
 
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+/* one dummy byte is kept in flight so the SPI does not stop between two bytes */
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    if (length > 0U)
+    {
+        EVE_SPI_SERCOM->SPI.DATA.reg = 0U;
+
+        for (uint32_t count = 1U; count < length; count++)
+        {
+            while (0U == (EVE_SPI_SERCOM->SPI.INTFLAG.reg & SERCOM_SPI_INTFLAG_DRE)) {}
+            EVE_SPI_SERCOM->SPI.DATA.reg = 0U;
+            while (0U == (EVE_SPI_SERCOM->SPI.INTFLAG.reg & SERCOM_SPI_INTFLAG_RXC)) {}
+            p_data[count - 1U] = (uint8_t) EVE_SPI_SERCOM->SPI.DATA.reg;
+        }
+
+        while (0U == (EVE_SPI_SERCOM->SPI.INTFLAG.reg & SERCOM_SPI_INTFLAG_RXC)) {}
+        p_data[length - 1U] = (uint8_t) EVE_SPI_SERCOM->SPI.DATA.reg;
+    }
+}
+
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
     return (*p_data);
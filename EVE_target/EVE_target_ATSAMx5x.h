@@ -37,6 +37,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
     changing thru the build-environment
 - changed EVE_SPI to a numerical value to automatically determine the correct
     SERCOMx_DMAC_ID_TX
+- added spi_transmit_block()
+- added spi_receive_block() and EVE_DMA_CHANNEL_RX
+- changed EVE_dma_buffer to a pointer, the buffers are in EVE_commands.c now
+- spi_transmit_burst() calls EVE_burst_segment() when the current segment of a burst is full
 
 */
 
@@ -113,6 +117,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define EVE_DMA_CHANNEL 0U
 #endif
 
+#if defined (EVE_DMA) && !defined (EVE_DMA_CHANNEL_RX)
+#define EVE_DMA_CHANNEL_RX 1U
+#endif
+
 #if !defined (EVE_DELAY_1MS)
 #define EVE_DELAY_1MS 20000U /* ~1ms at 120MHz Core-Clock and activated cache, according to my Logic-Analyzer */
 #endif
@@ -123,30 +131,37 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #if EVE_SPI == 0U
 #define EVE_SPI_SERCOM SERCOM0
 #define EVE_SPI_DMA_TRIGGER SERCOM0_DMAC_ID_TX
+#define EVE_SPI_DMA_TRIGGER_RX SERCOM0_DMAC_ID_RX
 #elif EVE_SPI == 1U
 #define EVE_SPI_SERCOM SERCOM1
 #define EVE_SPI_DMA_TRIGGER SERCOM1_DMAC_ID_TX
+#define EVE_SPI_DMA_TRIGGER_RX SERCOM1_DMAC_ID_RX
 #elif EVE_SPI == 2U
 #define EVE_SPI_SERCOM SERCOM2
 #define EVE_SPI_DMA_TRIGGER SERCOM2_DMAC_ID_TX
+#define EVE_SPI_DMA_TRIGGER_RX SERCOM2_DMAC_ID_RX
 #elif EVE_SPI == 3U
 #define EVE_SPI_SERCOM SERCOM3
 #define EVE_SPI_DMA_TRIGGER SERCOM3_DMAC_ID_TX
+#define EVE_SPI_DMA_TRIGGER_RX SERCOM3_DMAC_ID_RX
 #elif EVE_SPI == 4U
 #define EVE_SPI_SERCOM SERCOM4
 #define EVE_SPI_DMA_TRIGGER SERCOM4_DMAC_ID_TX
+#define EVE_SPI_DMA_TRIGGER_RX SERCOM4_DMAC_ID_RX
 #elif EVE_SPI == 5U
 #define EVE_SPI_SERCOM SERCOM5
 #define EVE_SPI_DMA_TRIGGER SERCOM5_DMAC_ID_TX
+#define EVE_SPI_DMA_TRIGGER_RX SERCOM5_DMAC_ID_RX
 #endif
 
 #if defined (EVE_DMA)
-    extern uint32_t EVE_dma_buffer[1025U];
+    extern uint32_t *EVE_dma_buffer;
     extern volatile uint16_t EVE_dma_buffer_index;
     extern volatile uint8_t EVE_dma_busy;
 
     void EVE_init_dma(void);
     void EVE_start_dma_transfer(void);
+    void spi_receive_block(uint8_t *p_data, uint32_t length);
 #endif
 
 void DELAY_MS(uint16_t val);
@@ -190,6 +205,12 @@ static inline void spi_transmit_32(uint32_t data)
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
+    if (0U == EVE_burst_words) /* the DMA buffer or the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
+
 #if defined (EVE_DMA)
     EVE_dma_buffer[EVE_dma_buffer_index++] = data;
 #else
@@ -197,6 +218,22 @@ static inline void spi_transmit_burst(uint32_t data)
 #endif
 }
 
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* the receiver is off during the transfer so the next byte can go out as soon as DATA is empty */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    EVE_SPI_SERCOM->SPI.CTRLB.bit.RXEN = 0; /* switch receiver off by setting RXEN to 0 which is not enable-protected */
+
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        while (0U == (EVE_SPI_SERCOM->SPI.INTFLAG.reg & SERCOM_SPI_INTFLAG_DRE)) {}
+        EVE_SPI_SERCOM->SPI.DATA.reg = p_data[count];
+    }
+
+    while (0U == (EVE_SPI_SERCOM->SPI.INTFLAG.reg & SERCOM_SPI_INTFLAG_TXC)) {}
+    EVE_SPI_SERCOM->SPI.CTRLB.bit.RXEN = 1; /* switch receiver on by setting RXEN to 1 which is not enable protected */
+}
+
 static inline uint8_t spi_receive(uint8_t data)
 {
     EVE_SPI_SERCOM->SPI.DATA.reg = data;
@@ -204,6 +241,30 @@ static inline uint8_t spi_receive(uint8_t data)
     return (EVE_SPI_SERCOM->SPI.DATA.reg);
 }
 
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+/* one dummy byte is kept in flight so the SPI does not stop between two bytes, */
+/* with EVE_DMA the block is read by two DMA channels in EVE_target.c */
+#if !defined (EVE_DMA)
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    if (length > 0U)
+    {
+        EVE_SPI_SERCOM->SPI.DATA.reg = 0U;
+
+        for (uint32_t count = 1U; count < length; count++)
+        {
+            while (0U == (EVE_SPI_SERCOM->SPI.INTFLAG.reg & SERCOM_SPI_INTFLAG_DRE)) {}
+            EVE_SPI_SERCOM->SPI.DATA.reg = 0U;
+            while (0U == (EVE_SPI_SERCOM->SPI.INTFLAG.reg & SERCOM_SPI_INTFLAG_RXC)) {}
+            p_data[count - 1U] = (uint8_t) EVE_SPI_SERCOM->SPI.DATA.reg;
+        }
+
+        while (0U == (EVE_SPI_SERCOM->SPI.INTFLAG.reg & SERCOM_SPI_INTFLAG_RXC)) {}
+        p_data[length - 1U] = (uint8_t) EVE_SPI_SERCOM->SPI.DATA.reg;
+    }
+}
+#endif
+
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
     return (*p_data);
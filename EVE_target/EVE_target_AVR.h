@@ -35,6 +35,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - basic maintenance: checked for violations of white space and indent rules
 - split up the optional default defines to allow to only change what needs
     changing thru the build-environment
+- added spi_transmit_block() and EVE_FLASH_NOT_MAPPED
+- added spi_receive_block()
+- spi_transmit_burst() calls EVE_burst_segment() when the current segment of a burst is full
+- added spi_set_clock() for EVE_ramp_spi_clock()
 
 */
 
@@ -126,9 +130,24 @@ static inline void spi_transmit_32(uint32_t data)
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
+    if (0U == EVE_burst_words) /* the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
     spi_transmit_32(data);
 }
 
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* this is the place to speed things up by keeping the SPI busy, e.g. by filling a FIFO or by using DMA */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        spi_transmit(p_data[count]);
+    }
+}
+
 static inline uint8_t spi_receive(uint8_t data)
 {
 #if 1
@@ -165,6 +184,47 @@ static inline uint8_t spi_receive(uint8_t data)
 #endif
 }
 
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+/* this is the place to speed things up by keeping the SPI busy, e.g. by using a FIFO or full-duplex DMA */
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        p_data[count] = spi_receive(0U); /* read data byte by sending another dummy byte */
+    }
+}
+
+/* spi_set_clock() sets the prescaler for the fastest clock that is not above hz, see EVE_ramp_spi_clock() */
+/* the clock is F_CPU / 2 to F_CPU / 128, SPR1 and SPR0 in SPCR select /4, /16, /64 or /128 and SPI2X doubles that */
+#define EVE_HAS_SPI_SET_CLOCK
+static inline uint32_t spi_set_clock(uint32_t hz)
+{
+    static const uint8_t settings[7U] = {0x10U, 0x00U, 0x11U, 0x01U, 0x12U, 0x02U, 0x03U}; /* SPI2X << 4 | SPR */
+    uint32_t clock = F_CPU / 2U;
+    uint8_t index = 0U;
+
+    while ((clock > hz) && (index < 6U))
+    {
+        index++;
+        clock = clock / 2U;
+    }
+
+    SPCR = (SPCR & (uint8_t) ~((1U << SPR1) | (1U << SPR0))) | (settings[index] & 0x03U);
+    if (0U != (settings[index] & 0x10U))
+    {
+        SPSR |= (1U << SPI2X);
+    }
+    else
+    {
+        SPSR &= (uint8_t) ~(1U << SPI2X);
+    }
+    return (clock);
+}
+
+/* the FLASH is not in the data address space, */
+/* data from FLASH is read with fetch_flash_byte() and not thru spi_transmit_block() */
+#define EVE_FLASH_NOT_MAPPED
+
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
     /* do we have an AVR with more than 64kB FLASH memory? */
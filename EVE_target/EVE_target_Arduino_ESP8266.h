@@ -35,6 +35,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - split up the optional default defines to allow to only change what needs
     changing thru the build-environment
 - changed #include "EVE_cpp_wrapper.h" to #include "../EVE_cpp_wrapper.h"
+- added spi_transmit_block()
+- added spi_receive_block()
+- spi_transmit_burst() calls EVE_burst_segment() when the current segment of a burst is full
 
 */
 
@@ -100,6 +103,12 @@ static inline void spi_transmit_32(uint32_t data)
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
+    if (0U == EVE_burst_words) /* the DMA buffer or the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
+
 #if defined (EVE_DMA)
     EVE_dma_buffer[EVE_dma_buffer_index++] = data;
 #else
@@ -107,11 +116,25 @@ static inline void spi_transmit_burst(uint32_t data)
 #endif
 }
 
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* SPI.writeBytes() sends the whole block without reading anything back */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    wrapper_spi_transmit_block(p_data, length);
+}
+
 static inline uint8_t spi_receive(uint8_t data)
 {
     return (wrapper_spi_receive(data));
 }
 
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+/* SPI.transferBytes() reads the whole block in one go */
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    wrapper_spi_receive_block(p_data, length);
+}
+
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
     return (*p_data);
@@ -35,6 +35,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - split up the optional default defines to allow to only change what needs
     changing thru the build-environment
 - changed #include "EVE_cpp_wrapper.h" to #include "../EVE_cpp_wrapper.h"
+- added spi_transmit_block()
+- added spi_receive_block()
+- changed EVE_dma_buffer to a pointer, the buffers are in EVE_commands.c now
+- spi_transmit_burst() calls EVE_burst_segment() when the current segment of a burst is full
 
 */
 
@@ -67,7 +71,7 @@ extern "C"
 #define EVE_DMA
 
 #if defined (EVE_DMA)
-extern uint32_t EVE_dma_buffer[1025U];
+extern uint32_t *EVE_dma_buffer;
 extern volatile uint16_t EVE_dma_buffer_index;
 extern volatile uint8_t EVE_dma_busy;
 
@@ -114,6 +118,12 @@ static inline void spi_transmit_32(uint32_t data)
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
+    if (0U == EVE_burst_words) /* the DMA buffer or the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
+
 #if defined (EVE_DMA)
     EVE_dma_buffer[EVE_dma_buffer_index++] = data;
 #else
@@ -121,11 +131,31 @@ static inline void spi_transmit_burst(uint32_t data)
 #endif
 }
 
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* this is the place to speed things up by keeping the SPI busy, e.g. by filling a FIFO or by using DMA */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        spi_transmit(p_data[count]);
+    }
+}
+
 static inline uint8_t spi_receive(uint8_t data)
 {
     return (wrapper_spi_receive(data));
 }
 
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+/* this is the place to speed things up by keeping the SPI busy, e.g. by using a FIFO or full-duplex DMA */
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        p_data[count] = spi_receive(0U); /* read data byte by sending another dummy byte */
+    }
+}
+
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
     return (*p_data);
@@ -37,6 +37,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
     changing thru the build-environment
 - changed #include "EVE_cpp_wrapper.h" to #include "../EVE_cpp_wrapper.h"
 - removed the unfortunately defunct WIZIOPICO
+- added spi_transmit_block()
+- added spi_receive_block()
+- changed EVE_dma_buffer to a pointer, the buffers are in EVE_commands.c now
+- spi_transmit_burst() calls EVE_burst_segment() when the current segment of a burst is full
 
 */
 
@@ -111,7 +115,7 @@ static inline void EVE_cs_clear(void)
 }
 
 #if defined (EVE_DMA)
-extern uint32_t EVE_dma_buffer[1025U];
+extern uint32_t *EVE_dma_buffer;
 extern volatile uint16_t EVE_dma_buffer_index;
 extern volatile uint8_t EVE_dma_busy;
 
@@ -133,6 +137,12 @@ static inline void spi_transmit_32(uint32_t data)
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
+    if (0U == EVE_burst_words) /* the DMA buffer or the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
+
 #if defined (EVE_DMA)
     EVE_dma_buffer[EVE_dma_buffer_index++] = data;
 #else
@@ -140,6 +150,13 @@ static inline void spi_transmit_burst(uint32_t data)
 #endif
 }
 
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* spi_write_blocking() keeps the TX FIFO filled and drains the RX FIFO */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    spi_write_blocking(EVE_SPI, p_data, length);
+}
+
 static inline uint8_t spi_receive(uint8_t data)
 {
     uint8_t result;
@@ -148,6 +165,13 @@ static inline uint8_t spi_receive(uint8_t data)
     return (result);
 }
 
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+/* spi_read_blocking() keeps the TX FIFO filled with dummy bytes and drains the RX FIFO */
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    spi_read_blocking(EVE_SPI, 0U, p_data, length);
+}
+
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
     return (*p_data);
@@ -37,6 +37,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
     changing thru the build-environment
 - changed a couple of {0U} to {}
 - changed back a couple of {} to {0} as C and C++ are not the same thing...
+- added spi_transmit_block()
+- added spi_receive_block()
+- changed EVE_dma_buffer to a pointer, the buffers are in EVE_commands.c now
+- spi_transmit_burst() calls EVE_burst_segment() when the current segment of a burst is full
 
 */
 
@@ -106,7 +110,7 @@ static inline void EVE_pdn_clear(void)
 }
 
 #if defined (EVE_DMA)
-    extern uint32_t EVE_dma_buffer[1025U];
+    extern uint32_t *EVE_dma_buffer;
     extern volatile uint16_t EVE_dma_buffer_index;
     extern volatile uint8_t EVE_dma_busy;
 
@@ -138,6 +142,12 @@ static inline void spi_transmit_32(uint32_t data)
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
+    if (0U == EVE_burst_words) /* the DMA buffer or the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
+
 #if defined (EVE_DMA)
     EVE_dma_buffer[EVE_dma_buffer_index++] = data;
 #else
@@ -145,6 +155,26 @@ static inline void spi_transmit_burst(uint32_t data)
 #endif
 }
 
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* the transfers are split to fit the max_transfer_sz of 4088 bytes set in EVE_init_spi() */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    uint32_t offset = 0U;
+
+    while (offset < length)
+    {
+        spi_transaction_t trans = {0};
+        uint32_t chunk = ((length - offset) > 4088U) ? 4088U : (length - offset);
+
+        trans.length = chunk * 8U;
+        trans.rxlength = 0;
+        trans.flags = 0;
+        trans.tx_buffer = &p_data[offset];
+        spi_device_polling_transmit(EVE_spi_device_simple, &trans);
+        offset += chunk;
+    }
+}
+
 static inline uint8_t spi_receive(uint8_t data)
 {
     spi_transaction_t trans = {0};
@@ -157,6 +187,28 @@ static inline uint8_t spi_receive(uint8_t data)
     return (trans.rx_data[0U]);
 }
 
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+/* the transfers are split to fit the max_transfer_sz of 4088 bytes set in EVE_init_spi(), */
+/* these are full-duplex DMA transfers as the bus is initialized with SPI_DMA_CH_AUTO */
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    uint32_t offset = 0U;
+
+    while (offset < length)
+    {
+        spi_transaction_t trans = {0};
+        uint32_t chunk = ((length - offset) > 4088U) ? 4088U : (length - offset);
+
+        trans.length = chunk * 8U;
+        trans.rxlength = chunk * 8U;
+        trans.flags = 0;
+        trans.tx_buffer = NULL;
+        trans.rx_buffer = &p_data[offset];
+        spi_device_polling_transmit(EVE_spi_device_simple, &trans);
+        offset += chunk;
+    }
+}
+
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
     return (*p_data);
@@ -34,6 +34,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - extracted from EVE_target.h
 - split up the optional default defines to allow to only change what needs
     changing thru the build-environment
+- added spi_transmit_block()
+- added spi_receive_block()
+- changed EVE_dma_buffer to a pointer, the buffers are in EVE_commands.c now
+- spi_transmit_burst() calls EVE_burst_segment() when the current segment of a burst is full
+- added EVE_PIO for dual and quad SPI with a PIO state machine and spi_set_width()
+- added spi_set_clock() for EVE_ramp_spi_clock()
 
 */
 
@@ -73,6 +79,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #if !defined (EVE_SPI)
 #define EVE_SPI spi0
 #endif
+
+#if !defined (EVE_PIO_SM)
+#define EVE_PIO_SM 0U
+#endif
+
+#if !defined (EVE_PIO_INSTANCE)
+#define EVE_PIO_INSTANCE pio0
+#endif
 /* you may define these in your build-environment to use different settings */
 
 // #define EVE_DMA /* to be defined in the build-environment */
@@ -102,14 +116,215 @@ static inline void EVE_pdn_clear(void)
 }
 
 #if defined (EVE_DMA)
-    extern uint32_t EVE_dma_buffer[1025U];
+    extern uint32_t *EVE_dma_buffer;
     extern volatile uint16_t EVE_dma_buffer_index;
     extern volatile uint8_t EVE_dma_busy;
 
     void EVE_init_dma(void);
     void EVE_start_dma_transfer(void);
+    void spi_receive_block(uint8_t *p_data, uint32_t length);
+#endif
+
+#if defined (EVE_PIO)
+/* EVE_PIO adds dual and quad SPI, single SPI stays on EVE_SPI and spi_set_width() switches the pins */
+/* over to a PIO state machine for 2 or 4 data lines, chip-select stays on the GPIO */
+/* IO0 to IO3 of EVE need to be on four consecutive pins starting with EVE_MOSI, */
+/* so EVE_MISO is EVE_MOSI + 1 and EVE_CS and EVE_PDN need to be moved away from EVE_MOSI + 2 and EVE_MOSI + 3 */
+/* the PIO runs with the clock EVE_SPI has when spi_set_width() is called */
+#include "hardware/pio.h"
+
+#if defined (EVE_DMA)
+#error "EVE_PIO is not implemented for EVE_DMA"
 #endif
 
+#if (EVE_MISO) != ((EVE_MOSI) + 1)
+#error "EVE_PIO needs EVE_MISO to be EVE_MOSI + 1"
+#endif
+
+#if (((EVE_CS) >= (EVE_MOSI)) && ((EVE_CS) <= ((EVE_MOSI) + 3))) || (((EVE_PDN) >= (EVE_MOSI)) && ((EVE_PDN) <= ((EVE_MOSI) + 3)))
+#error "EVE_PIO needs EVE_MOSI to EVE_MOSI + 3 for IO0 to IO3, EVE_CS and EVE_PDN need to be on other pins"
+#endif
+
+#define EVE_SPI_WIDTH_MAX 4U
+
+/* -------------------------------------------------------------------------------- */
+/* eve_spi.pio, the output of pioasm is below                                        */
+/*                                                                                  */
+/* .program eve_spi_x2                                                              */
+/* .side_set 1                                                                      */
+/* ; the side-set pin is SCK, the out, set and in pins start with IO0               */
+/* ; the first word is a header: bit 31 is set for a read, bits 30..0 are           */
+/* ; the number of clock cycles - 1, autopull and autopush with 8 bits, MSB first   */
+/* .wrap_target                                                                     */
+/*     pull   block         side 0                                                  */
+/*     out    y, 1          side 0                                                  */
+/*     out    x, 31         side 0                                                  */
+/*     jmp    !y, write     side 0                                                  */
+/*     set    pindirs, 0    side 0  ; EVE drives the data lines                     */
+/* read:                                                                            */
+/*     in     pins, 2       side 1  ; EVE changed the data with the falling edge    */
+/*     jmp    x--, read     side 0                                                  */
+/*     jmp    0             side 0                                                  */
+/* write:                                                                           */
+/*     set    pindirs, 15   side 0                                                  */
+/* loop:                                                                            */
+/*     out    pins, 2       side 0                                                  */
+/*     jmp    x--, loop     side 1  ; EVE reads the data with the rising edge       */
+/* .wrap                                                                            */
+/*                                                                                  */
+/* .program eve_spi_x4 is the same with "in pins, 4" and "out pins, 4"              */
+/* -------------------------------------------------------------------------------- */
+
+#define eve_spi_x2_wrap_target 0
+#define eve_spi_x2_wrap 10
+
+static const uint16_t eve_spi_x2_program_instructions[] = {
+            //     .wrap_target
+    0x80a0, //  0: pull   block           side 0
+    0x6041, //  1: out    y, 1            side 0
+    0x603f, //  2: out    x, 31           side 0
+    0x0068, //  3: jmp    !y, 8           side 0
+    0xe080, //  4: set    pindirs, 0      side 0
+    0x5002, //  5: in     pins, 2         side 1
+    0x0045, //  6: jmp    x--, 5          side 0
+    0x0000, //  7: jmp    0               side 0
+    0xe08f, //  8: set    pindirs, 15     side 0
+    0x6002, //  9: out    pins, 2         side 0
+    0x1049, // 10: jmp    x--, 9          side 1
+            //     .wrap
+};
+
+static const struct pio_program eve_spi_x2_program = {
+    .instructions = eve_spi_x2_program_instructions,
+    .length = 11,
+    .origin = -1,
+};
+
+static inline pio_sm_config eve_spi_x2_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + eve_spi_x2_wrap_target, offset + eve_spi_x2_wrap);
+    sm_config_set_sideset(&c, 1, false, false);
+    return c;
+}
+
+#define eve_spi_x4_wrap_target 0
+#define eve_spi_x4_wrap 10
+
+static const uint16_t eve_spi_x4_program_instructions[] = {
+            //     .wrap_target
+    0x80a0, //  0: pull   block           side 0
+    0x6041, //  1: out    y, 1            side 0
+    0x603f, //  2: out    x, 31           side 0
+    0x0068, //  3: jmp    !y, 8           side 0
+    0xe080, //  4: set    pindirs, 0      side 0
+    0x5004, //  5: in     pins, 4         side 1
+    0x0045, //  6: jmp    x--, 5          side 0
+    0x0000, //  7: jmp    0               side 0
+    0xe08f, //  8: set    pindirs, 15     side 0
+    0x6004, //  9: out    pins, 4         side 0
+    0x1049, // 10: jmp    x--, 9          side 1
+            //     .wrap
+};
+
+static const struct pio_program eve_spi_x4_program = {
+    .instructions = eve_spi_x4_program_instructions,
+    .length = 11,
+    .origin = -1,
+};
+
+static inline pio_sm_config eve_spi_x4_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + eve_spi_x4_wrap_target, offset + eve_spi_x4_wrap);
+    sm_config_set_sideset(&c, 1, false, false);
+    return c;
+}
+
+/* end of the pioasm output */
+
+extern uint8_t EVE_spi_lines; /* 1, 2 or 4, set by spi_set_width() */
+
+void spi_set_width(uint8_t lines);
+void EVE_pio_transmit(const uint8_t *p_data, uint32_t length);
+void EVE_pio_receive(uint8_t *p_data, uint32_t length);
+
+static inline void spi_transmit(uint8_t data)
+{
+    if (1U == EVE_spi_lines)
+    {
+        spi_write_blocking(EVE_SPI, &data, 1U);
+    }
+    else
+    {
+        EVE_pio_transmit(&data, 1U);
+    }
+}
+
+static inline void spi_transmit_32(uint32_t data)
+{
+    if (1U == EVE_spi_lines)
+    {
+        spi_write_blocking(EVE_SPI, (uint8_t *) &data, 4U);
+    }
+    else
+    {
+        EVE_pio_transmit((uint8_t *) &data, 4U);
+    }
+}
+
+/* spi_transmit_burst() is only used for cmd-FIFO commands */
+/* so it *always* has to transfer 4 bytes */
+static inline void spi_transmit_burst(uint32_t data)
+{
+    if (0U == EVE_burst_words) /* the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
+    spi_transmit_32(data);
+}
+
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    if (1U == EVE_spi_lines)
+    {
+        spi_write_blocking(EVE_SPI, p_data, length);
+    }
+    else
+    {
+        EVE_pio_transmit(p_data, length);
+    }
+}
+
+/* the data is ignored with dual and quad SPI as EVE does not look at the data lines while it is sending */
+static inline uint8_t spi_receive(uint8_t data)
+{
+    uint8_t result;
+
+    if (1U == EVE_spi_lines)
+    {
+        spi_write_read_blocking(EVE_SPI, &data, &result, 1U);
+    }
+    else
+    {
+        EVE_pio_receive(&result, 1U);
+    }
+    return (result);
+}
+
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    if (1U == EVE_spi_lines)
+    {
+        spi_read_blocking(EVE_SPI, 0U, p_data, length);
+    }
+    else
+    {
+        EVE_pio_receive(p_data, length);
+    }
+}
+#else
 static inline void spi_transmit(uint8_t data)
 {
     spi_write_blocking(EVE_SPI, &data, 1U);
@@ -124,6 +339,12 @@ static inline void spi_transmit_32(uint32_t data)
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
+    if (0U == EVE_burst_words) /* the DMA buffer or the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
+
 #if defined (EVE_DMA)
     EVE_dma_buffer[EVE_dma_buffer_index++] = data;
 #else
@@ -131,6 +352,13 @@ static inline void spi_transmit_burst(uint32_t data)
 #endif
 }
 
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* spi_write_blocking() keeps the TX FIFO filled and drains the RX FIFO */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    spi_write_blocking(EVE_SPI, p_data, length);
+}
+
 static inline uint8_t spi_receive(uint8_t data)
 {
     uint8_t result;
@@ -139,6 +367,26 @@ static inline uint8_t spi_receive(uint8_t data)
     return (result);
 }
 
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+/* spi_read_blocking() keeps the TX FIFO filled with dummy bytes and drains the RX FIFO, */
+/* with EVE_DMA the block is read by two DMA channels in EVE_target.c */
+#if !defined (EVE_DMA)
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    spi_read_blocking(EVE_SPI, 0U, p_data, length);
+}
+#endif
+
+#endif /* EVE_PIO */
+
+/* spi_set_clock() sets the SPI clock and returns the one the SPI is using now, see EVE_ramp_spi_clock() */
+/* spi_set_baudrate() returns the actual clock, the PIO of EVE_PIO takes it over with the next spi_set_width() */
+#define EVE_HAS_SPI_SET_CLOCK
+static inline uint32_t spi_set_clock(uint32_t hz)
+{
+    return (spi_set_baudrate(EVE_SPI, hz));
+}
+
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
     return (*p_data);
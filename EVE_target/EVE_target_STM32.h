@@ -33,6 +33,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 5.0
 - extracted from EVE_target.h
 - basic maintenance: checked for violations of white space and indent rules
+- added spi_transmit_block()
+- added spi_receive_block()
+- changed EVE_dma_buffer to a pointer, the buffers are in EVE_commands.c now
+- spi_transmit_burst() calls EVE_burst_segment() when the current segment of a burst is full
+- added EVE_QSPI to connect EVE to the QUADSPI for dual and quad SPI with spi_set_width()
+- added spi_set_clock() for EVE_ramp_spi_clock() with EVE_SPI_PCLK defined
 
 */
 
@@ -132,7 +138,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //#define EVE_DMA /* to be defined in the build-environment */
 
 #if defined (EVE_DMA)
-    extern uint32_t EVE_dma_buffer[1025U];
+    extern uint32_t *EVE_dma_buffer;
     extern volatile uint16_t EVE_dma_buffer_index;
     extern volatile uint8_t EVE_dma_busy;
 
@@ -162,6 +168,65 @@ static inline void EVE_cs_set(void)
     HAL_GPIO_WritePin(EVE_CS_PORT, EVE_CS, GPIO_PIN_RESET);
 }
 
+#if defined (EVE_QSPI)
+/* EVE_QSPI connects EVE to the QUADSPI instead of a SPI, e.g. on STM32F446, STM32G474 or STM32H743 */
+/* the QUADSPI is used in indirect mode with data phases only, EVE_cs_set() / EVE_cs_clear() still use the GPIO */
+/* and nCS of the QUADSPI is not connected, the QUADSPI has to be enabled by the application with CR.FTHRES = 0 */
+/* and a prescaler for no more than 11 MHz before EVE_init(), single SPI uses IO0 as MOSI and IO1 as MISO */
+#if !defined (QUADSPI)
+#error "EVE_QSPI needs a controller with QUADSPI"
+#endif
+
+#if defined (EVE_DMA)
+#error "EVE_QSPI is not implemented for EVE_DMA"
+#endif
+
+#define EVE_SPI_WIDTH_MAX 4U
+
+/* start an indirect write or read of length bytes with the data-mode for the width set by spi_set_width() */
+static inline void qspi_start(uint32_t fmode, uint32_t length)
+{
+    while (0U != (QUADSPI->SR & QUADSPI_SR_BUSY)) {}
+    QUADSPI->DLR = length - 1U;
+    QUADSPI->CCR = (QUADSPI->CCR & QUADSPI_CCR_DMODE) | fmode;
+}
+
+/* wait for the end of a write and clear the transfer complete flag */
+static inline void qspi_end(void)
+{
+    while (0U == (QUADSPI->SR & QUADSPI_SR_TCF)) {}
+    QUADSPI->FCR = QUADSPI_FCR_CTCF;
+}
+
+static inline void qspi_write8(uint8_t data)
+{
+    while (0U == (QUADSPI->SR & QUADSPI_SR_FTF)) {}
+    *((volatile uint8_t *) &QUADSPI->DR) = data;
+}
+
+static inline uint8_t qspi_read8(void)
+{
+    while (0U == (QUADSPI->SR & (QUADSPI_SR_FTF | QUADSPI_SR_TCF))) {}
+    return (*((volatile uint8_t *) &QUADSPI->DR));
+}
+
+static inline void spi_transmit(uint8_t data)
+{
+    qspi_start(0U, 1U);
+    qspi_write8(data);
+    qspi_end();
+}
+
+static inline void spi_transmit_32(uint32_t data)
+{
+    qspi_start(0U, 4U);
+    qspi_write8((uint8_t)(data & 0x000000ffUL));
+    qspi_write8((uint8_t)(data >> 8U));
+    qspi_write8((uint8_t)(data >> 16U));
+    qspi_write8((uint8_t)(data >> 24U));
+    qspi_end();
+}
+#else
 #if defined (STM32H7)
 static inline void spi_transmit(uint8_t data)
 {
@@ -187,11 +252,18 @@ static inline void spi_transmit_32(uint32_t data)
     spi_transmit((uint8_t)(data >> 16));
     spi_transmit((uint8_t)(data >> 24));
 }
+#endif /* EVE_QSPI */
 
 /* spi_transmit_burst() is only used for cmd-FIFO commands */
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
+    if (0U == EVE_burst_words) /* the DMA buffer or the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
+
 #if defined (EVE_DMA)
     EVE_dma_buffer[EVE_dma_buffer_index++] = data;
 #else
@@ -199,6 +271,133 @@ static inline void spi_transmit_burst(uint32_t data)
 #endif
 }
 
+#if defined (EVE_QSPI)
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* the block is one transfer, the QUADSPI keeps the clock running as long as its FIFO is not empty */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    if (length > 0U)
+    {
+        qspi_start(0U, length);
+        for (uint32_t count = 0U; count < length; count++)
+        {
+            qspi_write8(p_data[count]);
+        }
+        qspi_end();
+    }
+}
+
+/* the data is ignored as EVE does not look at MOSI while it is sending */
+static inline uint8_t spi_receive(uint8_t data)
+{
+    uint8_t ret;
+
+    (void) data;
+    qspi_start(QUADSPI_CCR_FMODE_0, 1U); /* indirect read, starts with the write to CCR */
+    ret = qspi_read8();
+    qspi_end();
+    return (ret);
+}
+
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    if (length > 0U)
+    {
+        qspi_start(QUADSPI_CCR_FMODE_0, length);
+        for (uint32_t count = 0U; count < length; count++)
+        {
+            p_data[count] = qspi_read8();
+        }
+        qspi_end();
+    }
+}
+
+/* spi_set_width() switches the QUADSPI to 1, 2 or 4 data lines, see EVE_set_spi_width() */
+static inline void spi_set_width(uint8_t lines)
+{
+    uint32_t dmode = QUADSPI_CCR_DMODE_0; /* single */
+
+    if (2U == lines)
+    {
+        dmode = QUADSPI_CCR_DMODE_1; /* dual */
+    }
+    else if (4U == lines)
+    {
+        dmode = QUADSPI_CCR_DMODE; /* quad */
+    }
+    else
+    {
+    }
+
+    while (0U != (QUADSPI->SR & QUADSPI_SR_BUSY)) {}
+    QUADSPI->CCR = dmode; /* indirect write without instruction and address, nothing is sent before data is written */
+}
+
+#if defined (EVE_SPI_PCLK)
+/* spi_set_clock() sets the prescaler for the fastest clock that is not above hz, see EVE_ramp_spi_clock() */
+#define EVE_HAS_SPI_SET_CLOCK
+/* EVE_SPI_PCLK is the clock of the QUADSPI, e.g. -DEVE_SPI_PCLK=180000000UL */
+static inline uint32_t spi_set_clock(uint32_t hz)
+{
+    uint32_t divider = (EVE_SPI_PCLK + hz - 1U) / hz;
+
+    if (divider > 256U)
+    {
+        divider = 256U;
+    }
+
+    while (0U != (QUADSPI->SR & QUADSPI_SR_BUSY)) {}
+    QUADSPI->CR = (QUADSPI->CR & ~QUADSPI_CR_PRESCALER) | ((divider - 1U) << QUADSPI_CR_PRESCALER_Pos);
+    return (EVE_SPI_PCLK / divider);
+}
+#endif
+#else
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* the next byte is written as soon as the transmit buffer is empty, what is received is thrown away at the end */
+#if defined (STM32H7)
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        while (!LL_SPI_IsActiveFlag_TXP(EVE_SPI)) {}
+        LL_SPI_TransmitData8(EVE_SPI, p_data[count]);
+        while (LL_SPI_IsActiveFlag_RXP(EVE_SPI))
+        {
+            (void) LL_SPI_ReceiveData8(EVE_SPI);
+        }
+    }
+
+    while (!LL_SPI_IsActiveFlag_TXC(EVE_SPI)) {}
+    while (LL_SPI_IsActiveFlag_RXWNE(EVE_SPI) || LL_SPI_IsActiveFlag_RXP(EVE_SPI))
+    {
+        (void) LL_SPI_ReceiveData8(EVE_SPI);
+    }
+    LL_SPI_ClearFlag_OVR(EVE_SPI);
+}
+#else
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        while (!LL_SPI_IsActiveFlag_TXE(EVE_SPI)) {}
+        LL_SPI_TransmitData8(EVE_SPI, p_data[count]);
+        if (LL_SPI_IsActiveFlag_RXNE(EVE_SPI))
+        {
+            (void) LL_SPI_ReceiveData8(EVE_SPI);
+        }
+    }
+
+    while (!LL_SPI_IsActiveFlag_TXE(EVE_SPI)) {}
+    while (LL_SPI_IsActiveFlag_BSY(EVE_SPI)) {}
+    while (LL_SPI_IsActiveFlag_RXNE(EVE_SPI))
+    {
+        (void) LL_SPI_ReceiveData8(EVE_SPI);
+    }
+    LL_SPI_ClearFlag_OVR(EVE_SPI); /* the receiver may have overrun while we were not looking */
+}
+#endif
+
 #if defined (STM32H7)
 static inline uint8_t spi_receive(uint8_t data)
 {
@@ -217,6 +416,95 @@ static inline uint8_t spi_receive(uint8_t data)
 }
 #endif
 
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+/* one dummy byte is kept in flight so the SPI does not stop between two bytes, */
+/* this needs a RX FIFO as otherwise an interrupt could make the receiver overrun */
+#if defined (STM32H7)
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    if (length > 0U)
+    {
+        LL_SPI_TransmitData8(EVE_SPI, 0U);
+
+        for (uint32_t count = 1U; count < length; count++)
+        {
+            while (!LL_SPI_IsActiveFlag_TXP(EVE_SPI)) {}
+            LL_SPI_TransmitData8(EVE_SPI, 0U);
+            while (!LL_SPI_IsActiveFlag_RXP(EVE_SPI)) {}
+            p_data[count - 1U] = LL_SPI_ReceiveData8(EVE_SPI);
+        }
+
+        while (!LL_SPI_IsActiveFlag_RXP(EVE_SPI)) {}
+        p_data[length - 1U] = LL_SPI_ReceiveData8(EVE_SPI);
+    }
+}
+#elif defined (STM32F0) || defined (STM32F3) || defined (STM32G0) || defined (STM32G4)
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    if (length > 0U)
+    {
+        LL_SPI_TransmitData8(EVE_SPI, 0U);
+
+        for (uint32_t count = 1U; count < length; count++)
+        {
+            while (!LL_SPI_IsActiveFlag_TXE(EVE_SPI)) {}
+            LL_SPI_TransmitData8(EVE_SPI, 0U);
+            while (!LL_SPI_IsActiveFlag_RXNE(EVE_SPI)) {}
+            p_data[count - 1U] = LL_SPI_ReceiveData8(EVE_SPI);
+        }
+
+        while (!LL_SPI_IsActiveFlag_RXNE(EVE_SPI)) {}
+        p_data[length - 1U] = LL_SPI_ReceiveData8(EVE_SPI);
+    }
+}
+#else
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        p_data[count] = spi_receive(0U); /* read data byte by sending another dummy byte */
+    }
+}
+#endif
+
+#if defined (EVE_SPI_PCLK)
+/* spi_set_clock() sets the prescaler for the fastest clock that is not above hz, see EVE_ramp_spi_clock() */
+#define EVE_HAS_SPI_SET_CLOCK
+/* EVE_SPI_PCLK is the clock of the bus EVE_SPI is connected to, e.g. -DEVE_SPI_PCLK=84000000UL */
+static inline uint32_t spi_set_clock(uint32_t hz)
+{
+    static const uint32_t prescalers[8U] =
+    {
+        LL_SPI_BAUDRATEPRESCALER_DIV2, LL_SPI_BAUDRATEPRESCALER_DIV4,
+        LL_SPI_BAUDRATEPRESCALER_DIV8, LL_SPI_BAUDRATEPRESCALER_DIV16,
+        LL_SPI_BAUDRATEPRESCALER_DIV32, LL_SPI_BAUDRATEPRESCALER_DIV64,
+        LL_SPI_BAUDRATEPRESCALER_DIV128, LL_SPI_BAUDRATEPRESCALER_DIV256
+    };
+    uint32_t clock = EVE_SPI_PCLK / 2U;
+    uint8_t index = 0U;
+
+    while ((clock > hz) && (index < 7U))
+    {
+        index++;
+        clock = clock / 2U;
+    }
+
+#if defined (STM32H7)
+    while (!LL_SPI_IsActiveFlag_TXC(EVE_SPI)) {}
+#else
+    while (LL_SPI_IsActiveFlag_BSY(EVE_SPI)) {}
+#endif
+    LL_SPI_Disable(EVE_SPI); /* the prescaler can not be changed while the SPI is enabled */
+    LL_SPI_SetBaudRatePrescaler(EVE_SPI, prescalers[index]);
+    LL_SPI_Enable(EVE_SPI);
+#if defined (STM32H7)
+    LL_SPI_StartMasterTransfer(EVE_SPI);
+#endif
+    return (clock);
+}
+#endif
+#endif /* EVE_QSPI */
+
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
     return (*p_data);
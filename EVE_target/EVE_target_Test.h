@@ -33,123 +33,206 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 5.0
 - new target for software tests
 - basic maintenance: checked for violations of white space and indent rules
+- reworked into a host target for Linux: the SPI is connected to a software model
+    of EVE in EVE_model.c instead of to a bunch of test-buffers that did not even compile
+- added spi_transmit_block()
+- added spi_receive_block()
+- changed EVE_dma_buffer to a pointer, the buffers are in EVE_commands.c now
+- spi_transmit_burst() calls EVE_burst_segment() when the current segment of a burst is full
+- added EVE_model_set_int_hook() and EVE_model_touch()
+- added EVE_MODEL_INSTANCES and EVE_model_select() to connect more than one EVE
+- added EVE_SPI_WIDTH_MAX and spi_set_width() for dual and quad SPI
+- added spi_set_clock(), bit_errors and the prototypes for EVE_model_spi_clock() and EVE_model_spi_limit()
+- added the prototype for EVE_model_touch_point()
+- the prototypes of the model are extern "C" so it can be used from C++
 
 */
 
-#ifndef EVE_TARGET_TEST_H
-#define EVE_TARGET_TEST_H
-
-#if defined (SOFTWARE_TEST)
-
-#include <stdint.h>
+/* This target is used to run the library on a PC.
+  There is no SPI, the functions below feed the bytes into a behavioral model
+  of a FT81x / BT81x that is implemented in EVE_model.c.
+  The model decodes the SPI transfers, keeps RAM_G, RAM_DL, the registers
+  and RAM_CMD and executes the commands written to the command co-processor FIFO.
+  Nothing is rendered, this is about what is going over the SPI.
 
-/* ToDo: checkout Google Test / Mock */
+  Build with -DSOFTWARE_TEST and the define for the display, e.g. -DEVE_EVE3_50G,
+  and add EVE_model.c to the sources.
 
-extern uint8_t EVE_spi_test_buffer[8192];
-extern uint8_t EVE_spi_test_buffer_index;
-extern uint8_t EVE_spi_test_buffer_receive[32];
+  INT_N of the model is connected by EVE_model_set_int_hook(), e.g. EVE_model_set_int_hook(EVE_int_edge).
 
-struct
-{
-    uint8_t called;
-} Test_EVE_pdn_set;
-
-struct
-{
-    uint8_t called;
-} Test_EVE_pdn_clear;
+  DMA is supported as well, with EVE_DMA defined EVE_start_dma_transfer() in EVE_target.c
+  sends out the buffer to the model.
+  The transfer is executed right away, there is no concurrency,
+  but the function calls are the same as on a real controller.
+*/
 
-struct
-{
-    uint8_t called;
-} Test_EVE_cs_set;
+#ifndef EVE_TARGET_TEST_H
+#define EVE_TARGET_TEST_H
 
-struct
-{
-    uint8_t called;
-} Test_EVE_cs_clear;
+#if defined (SOFTWARE_TEST)
 
-struct
-{
-    uint8_t called;
-} Test_EVE_spi_transmit;
+#include <stdint.h>
 
-struct
-{
-    uint8_t called;
-} Test_EVE_spi_transmit_32;
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_MODEL_FLASH_SIZE)
+#define EVE_MODEL_FLASH_SIZE (8UL*1024UL*1024UL) /* size of the external flash of BT81x in bytes */
+#endif
+#if !defined (EVE_MODEL_INSTANCES)
+#define EVE_MODEL_INSTANCES 1U /* number of EVE connected to the host, see EVE_model_select() */
+#endif
+/* you may define these in your build-environment to use different settings */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* counters for everything the model saw on the SPI since the last EVE_model_clear_stats() */
+typedef struct
+{
+    uint32_t spi_bytes; /* bytes clocked thru the SPI, in either direction */
+    uint32_t cs_cycles; /* number of chip-select low / high cycles, one per SPI transaction */
+    uint32_t fifo_bytes; /* bytes written to the command co-processor FIFO thru REG_CMDB_WRITE */
+    uint32_t commands; /* co-processor commands executed, display-list commands included */
+    uint32_t dl_words; /* entries written to RAM_DL by the co-processor */
+    uint32_t swaps; /* display-list swaps, by CMD_SWAP or a write to REG_DLSWAP */
+    uint32_t fifo_overflows; /* 32 bit words written to a full command co-processor FIFO */
+    uint32_t faults; /* co-processor faults */
+    uint32_t protocol_errors; /* transfers without chip-select, writes to read-only memory, broken transactions */
+    uint32_t bit_errors; /* bytes damaged by a SPI clock above the limit set by EVE_model_spi_limit() */
+} EVE_model_stats_t;
+
+void EVE_model_reset(void);
+void EVE_model_pdn(uint8_t level);
+void EVE_model_cs_set(void);
+void EVE_model_cs_clear(void);
+uint8_t EVE_model_transfer(uint8_t data);
+void EVE_model_advance_us(uint32_t usec);
+void EVE_model_set_lazy(uint8_t lazy);
+void EVE_model_get_stats(EVE_model_stats_t *p_stats);
+void EVE_model_clear_stats(void);
+uint32_t EVE_model_peek32(uint32_t address);
+void EVE_model_poke32(uint32_t address, uint32_t data);
+void EVE_model_flash_load(uint32_t offset, const uint8_t *p_data, uint32_t length);
+void EVE_model_set_int_hook(void (*p_hook)(void));
+void EVE_model_touch(uint32_t xy, uint8_t tag);
+void EVE_model_touch_point(uint8_t point, uint32_t xy, uint8_t tag);
+void EVE_model_select(uint8_t instance);
+void EVE_model_spi_width(uint8_t lines);
+void EVE_model_spi_clock(uint32_t hz);
+void EVE_model_spi_limit(uint32_t hz);
+
+#if defined (EVE_DMA)
+    extern uint32_t *EVE_dma_buffer;
+    extern volatile uint16_t EVE_dma_buffer_index;
+    extern volatile uint8_t EVE_dma_busy;
+
+    void EVE_init_dma(void);
+    void EVE_start_dma_transfer(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
 
-#define EVE_DELAY_1MS 4U  /* no real delay needed for the software tests */
+#define EVE_SPI_WIDTH_MAX 4U /* the model supports dual and quad SPI */
 
 static inline void DELAY_MS(uint16_t val)
 {
-    for (uint16_t counter = 0; counter < EVE_DELAY_1MS; counter++)
-    {
-        __asm__ volatile("nop");
-    }
+    EVE_model_advance_us(((uint32_t) val) * 1000UL); /* no real delay, only the time in the model moves on */
 }
+
 static inline void EVE_pdn_set(void)
 {
-    Test_EVE_pdn_set.called = Test_EVE_pdn_set.called + 1U;
+    EVE_model_pdn(0U);
 }
 
 static inline void EVE_pdn_clear(void)
 {
-    Test_EVE_pdn_clear.called = Test_EVE_pdn_clear.called + 1U;
+    EVE_model_pdn(1U);
 }
 
 static inline void EVE_cs_set(void)
 {
-    Test_EVE_cs_set.called = Test_EVE_cs_set.called + 1U;
-    EVE_spi_test_buffer_index = 0;
+    EVE_model_cs_set();
 }
 
 static inline void EVE_cs_clear(void)
 {
-    Test_EVE_cs_clear.called = Test_EVE_cs_clear.called + 1U;
+    EVE_model_cs_clear();
 }
 
 static inline void spi_transmit(uint8_t data)
 {
-    Test_EVE_spi_transmit.called = Test_EVE_spi_transmit.called + 1U;
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = data;
-    EVE_spi_test_buffer_index++;
+    (void) EVE_model_transfer(data);
 }
 
 static inline void spi_transmit_32(uint32_t data)
 {
-    Test_EVE_spi_transmit_32.called = Test_EVE_spi_transmit_32.called + 1U;
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = ((uint8_t)(data & 0x000000ffUL));
-    EVE_spi_test_buffer_index++;
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = ((uint8_t)(data >> 8U));
-    EVE_spi_test_buffer_index++;
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = ((uint8_t)(data >> 16U));
-    EVE_spi_test_buffer_index++;
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = ((uint8_t)(data >> 24U));
-    EVE_spi_test_buffer_index++;
+    spi_transmit((uint8_t)(data & 0x000000ffUL));
+    spi_transmit((uint8_t)(data >> 8U));
+    spi_transmit((uint8_t)(data >> 16U));
+    spi_transmit((uint8_t)(data >> 24U));
 }
 
 /* spi_transmit_burst() is only used for cmd-FIFO commands */
 /* so it *always* has to transfer 4 bytes */
 static inline void spi_transmit_burst(uint32_t data)
 {
-    Test_EVE_spi_transmit_burst.called = Test_EVE_spi_transmit_burst.called + 1U;
+    if (0U == EVE_burst_words) /* the DMA buffer or the CMD-FIFO is full */
+    {
+        EVE_burst_segment();
+    }
+    EVE_burst_words--;
+
+#if defined (EVE_DMA)
+    EVE_dma_buffer[EVE_dma_buffer_index++] = data;
+#else
     spi_transmit_32(data);
+#endif
+}
+
+/* spi_transmit_block() is used for blocks of data like images and the payload of CMD_INFLATE */
+/* this is the place to speed things up by keeping the SPI busy, e.g. by filling a FIFO or by using DMA */
+static inline void spi_transmit_block(const uint8_t *p_data, uint32_t length)
+{
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        spi_transmit(p_data[count]);
+    }
 }
 
 static inline uint8_t spi_receive(uint8_t data)
 {
-    Test_EVE_spi_transmit.called = Test_EVE_spi_receive.called + 1U;
-    uint8_t result = EVE_spi_test_buffer_receive[EVE_spi_test_buffer_index];
-    EVE_spi_test_buffer[EVE_spi_test_buffer_index] = data;
-    EVE_spi_test_buffer_index++;
+    return (EVE_model_transfer(data));
+}
+
+/* spi_receive_block() is used to read blocks of data like snapshots from RAM_G */
+/* this is the place to speed things up by keeping the SPI busy, e.g. by using a FIFO or full-duplex DMA */
+static inline void spi_receive_block(uint8_t *p_data, uint32_t length)
+{
+    for (uint32_t count = 0U; count < length; count++)
+    {
+        p_data[count] = spi_receive(0U); /* read data byte by sending another dummy byte */
+    }
+}
+
+/* spi_set_width() switches the SPI of the host to 1, 2 or 4 data lines, see EVE_set_spi_width() */
+static inline void spi_set_width(uint8_t lines)
+{
+    EVE_model_spi_width(lines);
+}
+
+/* spi_set_clock() sets the SPI clock of the host and returns the clock it is using now, see EVE_ramp_spi_clock() */
+#define EVE_HAS_SPI_SET_CLOCK
+static inline uint32_t spi_set_clock(uint32_t hz)
+{
+    EVE_model_spi_clock(hz);
+    return (hz);
 }
 
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
-    Test_EVE_fetch_flash_byte.called = Test_EVE_fetch_flash_byte.called + 1U;
-    (void) *p_data;
-    return (0x00);
+    return (*p_data);
 }
 
 #endif /* SOFTWARE_TEST */
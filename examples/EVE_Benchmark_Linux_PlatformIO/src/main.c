@@ -0,0 +1,2481 @@
+/*
+@file    main.c
+@brief   Benchmark for the EVE_cmd_* functions, runs on Linux with the SOFTWARE_TEST target
+@version 1.0
+@date    2026-10-17
+@author  Rudolph Riedel
+
+This calls every public EVE_cmd_* and EVE_cmd_*_burst function from EVE_commands.h
+in batches and prints one line per function and mode as comma separated values:
+
+function,mode,calls,spi_bytes,cs_toggles,host_ns,errors
+
+mode        - "single" is a call outside of a burst, "burst" is a call between EVE_start_cmd_burst() and EVE_end_cmd_burst()
+calls       - the total number of calls the numbers are based on
+spi_bytes   - bytes on the SPI per call, the overhead of EVE_start_cmd_burst() / EVE_end_cmd_burst() is not included
+cs_toggles  - chip-select low / high cycles per call, the overhead of a burst is not included either
+host_ns     - nano-seconds per call on the host, this includes the time the model needs to decode the transfers
+errors      - co-processor faults, protocol errors and FIFO overflows the model saw, anything but 0 is a bug
+
+The overhead of a burst is reported separately in the line for "EVE_start_cmd_burst+EVE_end_cmd_burst".
+After the functions there is a line with mode "check" for every behaviour check from check_list[],
+these run a feature once and compare what it did against the state of the model, like RAM_G, RAM_DL
+and REG_CMD_DL, every comparison that fails is printed to stderr and counts as an error.
+EVE_memWrite_sram_buffer() and EVE_memRead_sram_buffer() are run with blocks of BENCH_BLOCK_SIZE bytes,
+every byte that is read back different from what was written counts as an error.
+The spi_bytes and cs_toggles columns are exact and only change when the command encoders change,
+host_ns is only useful for comparison between builds on the same machine.
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "EVE.h"
+#include "EVE_suppplemental.h"
+
+#define BENCH_CALLS 16U  /* calls per batch, small enough for the display-list and the DMA buffer */
+#define BENCH_REPEAT 64U /* number of batches */
+
+#define BENCH_SINGLE 0x01U /* the function works outside of a burst */
+#define BENCH_BURST 0x02U  /* the function works between EVE_start_cmd_burst() and EVE_end_cmd_burst() */
+#define BENCH_CHECK 0x04U  /* a behaviour check from check_list[] */
+
+#define BENCH_MEM 0x10000UL /* RAM_G address used as target for the memory commands */
+#define BENCH_FLASH 0x1000UL /* flash address used for the flash commands, the first block holds the blob */
+#define BENCH_READ 0x80000UL /* RAM_G address only used by EVE_memWrite_sram_buffer() and EVE_memRead_sram_buffer() */
+#define BENCH_BLOCK_SIZE 4096U
+
+typedef struct
+{
+    const char *p_name;
+    void (*p_function)(void);
+    uint8_t modes;
+    uint8_t calls; /* calls per batch if less than BENCH_CALLS for functions that are very slow in the model */
+} bench_t;
+
+typedef struct
+{
+    uint64_t spi_bytes;
+    uint64_t cs_cycles;
+    uint64_t nsec;
+    uint32_t calls;
+    uint32_t errors;
+} bench_result_t;
+
+typedef struct
+{
+    const char *p_name;
+    void (*p_function)(void);
+} check_t;
+
+/* counts a failed comparison in a behaviour check */
+#define CHECK(condition) check_true((condition) ? 1U : 0U, #condition, __LINE__)
+
+/* 1 kiB, 32 x 32 L8, zlib compressed */
+static const uint8_t bench_zlib[51U] =
+{
+    0x78, 0xda, 0x63, 0xe0, 0x10, 0x90, 0x50, 0xd0, 0x30, 0xb0, 0x70, 0xf0, 0x08, 0x88, 0x48, 0xc8,
+    0x28, 0xa8, 0x68, 0xe8, 0x98, 0x30, 0x63, 0xc1, 0x8a, 0x0d, 0x3b, 0x0e, 0x9c, 0xb8, 0x70, 0xe3,
+    0xc1, 0x8b, 0x0f, 0x3f, 0x18, 0x46, 0xe5, 0x47, 0xe5, 0x47, 0xe5, 0x87, 0xad, 0x3c, 0x00, 0x8d,
+    0x8a, 0xf0, 0x10
+};
+
+/* 8 x 8 RGB .png */
+static const uint8_t bench_png[165U] =
+{
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x08, 0x08, 0x02, 0x00, 0x00, 0x00, 0x4b, 0x6d, 0x29,
+    0xdc, 0x00, 0x00, 0x00, 0x6c, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x15, 0xcd, 0x41, 0x15, 0x00,
+    0x51, 0x08, 0x42, 0x51, 0xa3, 0x18, 0x85, 0x28, 0x46, 0x79, 0x51, 0x88, 0x42, 0x14, 0xa2, 0xcc,
+    0x1f, 0x97, 0x5c, 0x0e, 0xce, 0x0c, 0x3b, 0x68, 0xb8, 0x81, 0xc1, 0x43, 0x86, 0x0e, 0x33, 0xcb,
+    0x2e, 0x5a, 0x6e, 0x61, 0xf1, 0x92, 0xa5, 0xfb, 0x40, 0xac, 0x90, 0x38, 0x81, 0xb0, 0x88, 0xa8,
+    0x1e, 0x1c, 0x7b, 0xe8, 0xb8, 0x83, 0xc3, 0x47, 0x8e, 0xde, 0x83, 0x7f, 0xe0, 0x55, 0x5f, 0xf8,
+    0x9f, 0x21, 0xd0, 0xf7, 0x6e, 0xcc, 0x1a, 0x99, 0xf3, 0x1f, 0xdb, 0xc4, 0xd4, 0x0f, 0xc2, 0x06,
+    0x85, 0xcb, 0x5f, 0x76, 0x48, 0x68, 0x1e, 0x94, 0x2d, 0x2a, 0xd7, 0x7f, 0xc2, 0x25, 0xa5, 0xe5,
+    0x03, 0xc6, 0x7b, 0x58, 0x01, 0x57, 0x39, 0x36, 0xf2, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e,
+    0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+/* just the RIFF header of an .avi with 56 bytes of payload, enough to get thru CMD_PLAYVIDEO */
+static const uint8_t bench_avi[64U] =
+{
+    'R', 'I', 'F', 'F', 56U, 0U, 0U, 0U, 'A', 'V', 'I', ' '
+};
+
+static uint8_t bench_pattern[BENCH_BLOCK_SIZE];
+static uint8_t bench_readback[BENCH_BLOCK_SIZE];
+static uint32_t bench_mismatches; /* errors found by the benchmark functions themselves */
+static uint32_t check_failures; /* comparisons that failed in the current behaviour check */
+static uint8_t check_zlib[BENCH_BLOCK_SIZE + 11U]; /* bench_pattern as a stored zlib block */
+static uint32_t check_callbacks; /* calls of check_callback() */
+static uint8_t check_flags; /* the flags check_callback() got last */
+static uint32_t check_first; /* the first color word check_segment_build() writes */
+static uint32_t check_media_pos; /* bytes of bench_png check_media_read() returned */
+
+/* ################################################################## */
+
+static void bench_none(void)
+{
+}
+
+/* EVE4: BT817 / BT818 */
+#if EVE_GEN > 3
+
+static void bench_flashprogram(void)
+{
+    EVE_cmd_flashprogram(BENCH_FLASH, BENCH_MEM, 4096UL);
+}
+
+static void bench_fontcache(void)
+{
+    EVE_cmd_fontcache(30UL, BENCH_MEM, 16384UL);
+}
+
+static void bench_fontcachequery(void)
+{
+    uint32_t total;
+    uint32_t used;
+
+    EVE_cmd_fontcachequery(&total, &used);
+}
+
+static void bench_getimage(void)
+{
+    uint32_t source;
+    uint32_t fmt;
+    uint32_t width;
+    uint32_t height;
+    uint32_t palette;
+
+    EVE_cmd_getimage(&source, &fmt, &width, &height, &palette);
+}
+
+static void bench_linetime(void)
+{
+    EVE_cmd_linetime(BENCH_MEM);
+}
+
+static void bench_newlist(void)
+{
+    EVE_cmd_newlist(BENCH_MEM);
+    EVE_cmd_dl(CMD_ENDLIST);
+}
+
+static void bench_pclkfreq(void)
+{
+    (void) EVE_cmd_pclkfreq(51000000UL, 0L);
+}
+
+static void bench_wait(void)
+{
+    EVE_cmd_wait(10UL);
+}
+
+static void bench_animframeram(void)
+{
+    EVE_cmd_animframeram(100, 100, BENCH_MEM, 1UL);
+}
+
+static void bench_animframeram_burst(void)
+{
+    EVE_cmd_animframeram_burst(100, 100, BENCH_MEM, 1UL);
+}
+
+static void bench_animstartram(void)
+{
+    EVE_cmd_animstartram(1L, BENCH_MEM, 1UL);
+}
+
+static void bench_animstartram_burst(void)
+{
+    EVE_cmd_animstartram_burst(1L, BENCH_MEM, 1UL);
+}
+
+static void bench_apilevel(void)
+{
+    EVE_cmd_apilevel(2UL);
+}
+
+static void bench_apilevel_burst(void)
+{
+    EVE_cmd_apilevel_burst(2UL);
+}
+
+static void bench_calibratesub(void)
+{
+    EVE_cmd_calibratesub(0U, 0U, 200U, 100U);
+}
+
+static void bench_calllist(void)
+{
+    EVE_cmd_calllist(BENCH_MEM);
+}
+
+static void bench_calllist_burst(void)
+{
+    EVE_cmd_calllist_burst(BENCH_MEM);
+}
+
+static void bench_hsf(void)
+{
+    EVE_cmd_hsf(0UL);
+}
+
+static void bench_runanim(void)
+{
+    EVE_cmd_runanim(0UL, 0UL);
+}
+
+static void bench_runanim_burst(void)
+{
+    EVE_cmd_runanim_burst(0UL, 0UL);
+}
+
+#endif /* EVE_GEN > 3 */
+
+/* EVE3: BT815 / BT816 */
+#if EVE_GEN > 2
+
+static const uint8_t bench_block[256U] = {0U};
+
+static const uint32_t bench_arguments[2U] = {42UL, 0x1234UL};
+
+static void bench_clearcache(void)
+{
+    EVE_cmd_clearcache();
+}
+
+static void bench_flashattach(void)
+{
+    EVE_cmd_flashattach();
+}
+
+static void bench_flashdetach(void)
+{
+    EVE_cmd_flashdetach();
+}
+
+static void bench_flasherase(void)
+{
+    EVE_cmd_flasherase();
+}
+
+static void bench_flashfast(void)
+{
+    (void) EVE_cmd_flashfast();
+}
+
+static void bench_flashspidesel(void)
+{
+    EVE_cmd_flashspidesel();
+}
+
+static void bench_flashread(void)
+{
+    EVE_cmd_flashread(BENCH_MEM, BENCH_FLASH, 256UL);
+}
+
+static void bench_flashsource(void)
+{
+    EVE_cmd_flashsource(BENCH_FLASH);
+}
+
+static void bench_flashspirx(void)
+{
+    EVE_cmd_flashspirx(BENCH_MEM, 256UL);
+}
+
+static void bench_flashspitx(void)
+{
+    EVE_cmd_flashspitx(256UL, bench_block);
+}
+
+static void bench_flashupdate(void)
+{
+    EVE_cmd_flashupdate(BENCH_FLASH, BENCH_MEM, 4096UL);
+}
+
+static void bench_flashwrite(void)
+{
+    EVE_cmd_flashwrite(BENCH_FLASH, 256UL, bench_block);
+}
+
+static void bench_inflate2(void)
+{
+    EVE_cmd_inflate2(BENCH_MEM, 0UL, bench_zlib, sizeof(bench_zlib));
+}
+
+static void bench_animdraw(void)
+{
+    EVE_cmd_animdraw(1L);
+}
+
+static void bench_animdraw_burst(void)
+{
+    EVE_cmd_animdraw_burst(1L);
+}
+
+static void bench_animframe(void)
+{
+    EVE_cmd_animframe(100, 100, BENCH_FLASH, 1UL);
+}
+
+static void bench_animframe_burst(void)
+{
+    EVE_cmd_animframe_burst(100, 100, BENCH_FLASH, 1UL);
+}
+
+static void bench_animstart(void)
+{
+    EVE_cmd_animstart(1L, BENCH_FLASH, 1UL);
+}
+
+static void bench_animstart_burst(void)
+{
+    EVE_cmd_animstart_burst(1L, BENCH_FLASH, 1UL);
+}
+
+static void bench_animstop(void)
+{
+    EVE_cmd_animstop(1L);
+}
+
+static void bench_animstop_burst(void)
+{
+    EVE_cmd_animstop_burst(1L);
+}
+
+static void bench_animxy(void)
+{
+    EVE_cmd_animxy(1L, 100, 100);
+}
+
+static void bench_animxy_burst(void)
+{
+    EVE_cmd_animxy_burst(1L, 100, 100);
+}
+
+static void bench_appendf(void)
+{
+    EVE_cmd_appendf(BENCH_FLASH, 16UL);
+}
+
+static void bench_appendf_burst(void)
+{
+    EVE_cmd_appendf_burst(BENCH_FLASH, 16UL);
+}
+
+static void bench_bitmap_transform(void)
+{
+    (void) EVE_cmd_bitmap_transform(0L, 0L, 256L, 0L, 0L, 256L, 0L, 0L, 512L, 0L, 0L, 512L);
+}
+
+static void bench_bitmap_transform_burst(void)
+{
+    EVE_cmd_bitmap_transform_burst(0L, 0L, 256L, 0L, 0L, 256L, 0L, 0L, 512L, 0L, 0L, 512L);
+}
+
+static void bench_fillwidth(void)
+{
+    EVE_cmd_fillwidth(100UL);
+}
+
+static void bench_fillwidth_burst(void)
+{
+    EVE_cmd_fillwidth_burst(100UL);
+}
+
+static void bench_gradienta(void)
+{
+    EVE_cmd_gradienta(0, 0, 0xff000000UL, 100, 100, 0x00ffffffUL);
+}
+
+static void bench_gradienta_burst(void)
+{
+    EVE_cmd_gradienta_burst(0, 0, 0xff000000UL, 100, 100, 0x00ffffffUL);
+}
+
+static void bench_rotatearound(void)
+{
+    EVE_cmd_rotatearound(16L, 16L, 0x2000UL, 65536L);
+}
+
+static void bench_rotatearound_burst(void)
+{
+    EVE_cmd_rotatearound_burst(16L, 16L, 0x2000UL, 65536L);
+}
+
+static void bench_button_var(void)
+{
+    EVE_cmd_button_var(10, 10, 100, 40, 28U, EVE_OPT_FORMAT, "%d", 1U, bench_arguments);
+}
+
+static void bench_button_var_burst(void)
+{
+    EVE_cmd_button_var_burst(10, 10, 100, 40, 28U, EVE_OPT_FORMAT, "%d", 1U, bench_arguments);
+}
+
+static void bench_text_var(void)
+{
+    EVE_cmd_text_var(10, 10, 28U, EVE_OPT_FORMAT, "%d %x", 2U, bench_arguments);
+}
+
+static void bench_text_var_burst(void)
+{
+    EVE_cmd_text_var_burst(10, 10, 28U, EVE_OPT_FORMAT, "%d %x", 2U, bench_arguments);
+}
+
+static void bench_toggle_var(void)
+{
+    EVE_cmd_toggle_var(10, 10, 60U, 28U, EVE_OPT_FORMAT, 0U, "%d\xff%d", 2U, bench_arguments);
+}
+
+static void bench_toggle_var_burst(void)
+{
+    EVE_cmd_toggle_var_burst(10, 10, 60U, 28U, EVE_OPT_FORMAT, 0U, "%d\xff%d", 2U, bench_arguments);
+}
+
+#endif /* EVE_GEN > 2 */
+
+static void bench_getprops(void)
+{
+    uint32_t pointer;
+    uint32_t width;
+    uint32_t height;
+
+    EVE_cmd_getprops(&pointer, &width, &height);
+}
+
+static void bench_getptr(void)
+{
+    (void) EVE_cmd_getptr();
+}
+
+static void bench_inflate(void)
+{
+    EVE_cmd_inflate(BENCH_MEM, bench_zlib, sizeof(bench_zlib));
+}
+
+static void bench_interrupt(void)
+{
+    EVE_cmd_interrupt(0UL);
+}
+
+static void bench_loadimage(void)
+{
+    EVE_cmd_loadimage(BENCH_MEM, EVE_OPT_NODL, bench_png, sizeof(bench_png));
+}
+
+static void bench_mediafifo(void)
+{
+    EVE_cmd_mediafifo(0xf0000UL, 0x10000UL);
+}
+
+static void bench_memcpy(void)
+{
+    EVE_cmd_memcpy(BENCH_MEM + 4096UL, BENCH_MEM, 1024UL);
+}
+
+static void bench_memcrc(void)
+{
+    (void) EVE_cmd_memcrc(BENCH_MEM, 1024UL);
+}
+
+static void bench_memset(void)
+{
+    EVE_cmd_memset(BENCH_MEM, 0x55U, 1024UL);
+}
+
+static void bench_memzero(void)
+{
+    EVE_cmd_memzero(BENCH_MEM, 1024UL);
+}
+
+static void bench_playvideo(void)
+{
+    EVE_cmd_playvideo(0UL, bench_avi, sizeof(bench_avi));
+}
+
+static void bench_setrotate(void)
+{
+    EVE_cmd_setrotate(0UL);
+}
+
+static void bench_snapshot(void)
+{
+    EVE_cmd_snapshot(0x40000UL);
+}
+
+static void bench_snapshot2(void)
+{
+    EVE_cmd_snapshot2(EVE_RGB565, BENCH_MEM, 0, 0, 32U, 32U);
+}
+
+static void bench_track(void)
+{
+    EVE_cmd_track(100, 100, 1U, 1U, 10U);
+}
+
+static void bench_videoframe(void)
+{
+    EVE_cmd_videoframe(BENCH_MEM, BENCH_MEM - 4UL);
+}
+
+static void bench_memwrite_sram_buffer(void)
+{
+    EVE_memWrite_sram_buffer(BENCH_READ, bench_pattern, BENCH_BLOCK_SIZE);
+}
+
+static void bench_memread_sram_buffer(void)
+{
+    EVE_memRead_sram_buffer(BENCH_READ, bench_readback, BENCH_BLOCK_SIZE);
+
+    for (uint32_t index = 0U; index < BENCH_BLOCK_SIZE; index++)
+    {
+        if (bench_readback[index] != bench_pattern[index])
+        {
+            bench_mismatches++;
+        }
+        bench_readback[index] = 0U;
+    }
+}
+
+static void bench_dl(void)
+{
+    EVE_cmd_dl(DL_COLOR_RGB | 0x123456UL);
+}
+
+static void bench_dl_burst(void)
+{
+    EVE_cmd_dl_burst(DL_COLOR_RGB | 0x123456UL);
+}
+
+static void bench_append(void)
+{
+    EVE_cmd_append(BENCH_MEM, 16UL);
+}
+
+static void bench_append_burst(void)
+{
+    EVE_cmd_append_burst(BENCH_MEM, 16UL);
+}
+
+static void bench_bgcolor(void)
+{
+    EVE_cmd_bgcolor(0x00204080UL);
+}
+
+static void bench_bgcolor_burst(void)
+{
+    EVE_cmd_bgcolor_burst(0x00204080UL);
+}
+
+static void bench_button(void)
+{
+    EVE_cmd_button(10, 10, 100, 40, 28U, 0U, "Button");
+}
+
+static void bench_button_burst(void)
+{
+    EVE_cmd_button_burst(10, 10, 100, 40, 28U, 0U, "Button");
+}
+
+static void bench_calibrate(void)
+{
+    EVE_cmd_calibrate();
+}
+
+static void bench_clock(void)
+{
+    EVE_cmd_clock(100, 100, 50U, 0U, 8U, 15U, 0U, 0U);
+}
+
+static void bench_clock_burst(void)
+{
+    EVE_cmd_clock_burst(100, 100, 50U, 0U, 8U, 15U, 0U, 0U);
+}
+
+static void bench_dial(void)
+{
+    EVE_cmd_dial(100, 100, 50U, 0U, 0x4000U);
+}
+
+static void bench_dial_burst(void)
+{
+    EVE_cmd_dial_burst(100, 100, 50U, 0U, 0x4000U);
+}
+
+static void bench_fgcolor(void)
+{
+    EVE_cmd_fgcolor(0x00408020UL);
+}
+
+static void bench_fgcolor_burst(void)
+{
+    EVE_cmd_fgcolor_burst(0x00408020UL);
+}
+
+static void bench_gauge(void)
+{
+    EVE_cmd_gauge(100, 100, 50U, 0U, 10U, 5U, 30U, 100U);
+}
+
+static void bench_gauge_burst(void)
+{
+    EVE_cmd_gauge_burst(100, 100, 50U, 0U, 10U, 5U, 30U, 100U);
+}
+
+static void bench_getmatrix(void)
+{
+    int32_t value_a;
+    int32_t value_b;
+    int32_t value_c;
+    int32_t value_d;
+    int32_t value_e;
+    int32_t value_f;
+
+    EVE_cmd_getmatrix(&value_a, &value_b, &value_c, &value_d, &value_e, &value_f);
+}
+
+static void bench_gradcolor(void)
+{
+    EVE_cmd_gradcolor(0x00ffffffUL);
+}
+
+static void bench_gradcolor_burst(void)
+{
+    EVE_cmd_gradcolor_burst(0x00ffffffUL);
+}
+
+static void bench_gradient(void)
+{
+    EVE_cmd_gradient(0, 0, 0x000000UL, 100, 100, 0xffffffUL);
+}
+
+static void bench_gradient_burst(void)
+{
+    EVE_cmd_gradient_burst(0, 0, 0x000000UL, 100, 100, 0xffffffUL);
+}
+
+static void bench_keys(void)
+{
+    EVE_cmd_keys(10, 10, 200, 40, 28U, 0U, "abcd");
+}
+
+static void bench_keys_burst(void)
+{
+    EVE_cmd_keys_burst(10, 10, 200, 40, 28U, 0U, "abcd");
+}
+
+static void bench_number(void)
+{
+    EVE_cmd_number(10, 10, 28U, 0U, 123456L);
+}
+
+static void bench_number_burst(void)
+{
+    EVE_cmd_number_burst(10, 10, 28U, 0U, 123456L);
+}
+
+static void bench_progress(void)
+{
+    EVE_cmd_progress(10, 10, 200U, 20U, 0U, 50U, 100U);
+}
+
+static void bench_progress_burst(void)
+{
+    EVE_cmd_progress_burst(10, 10, 200U, 20U, 0U, 50U, 100U);
+}
+
+static void bench_romfont(void)
+{
+    EVE_cmd_romfont(1UL, 34UL);
+}
+
+static void bench_romfont_burst(void)
+{
+    EVE_cmd_romfont_burst(1UL, 34UL);
+}
+
+static void bench_rotate(void)
+{
+    EVE_cmd_rotate(0x2000UL);
+}
+
+static void bench_rotate_burst(void)
+{
+    EVE_cmd_rotate_burst(0x2000UL);
+}
+
+static void bench_scale(void)
+{
+    EVE_cmd_scale(0x20000L, 0x20000L);
+}
+
+static void bench_scale_burst(void)
+{
+    EVE_cmd_scale_burst(0x20000L, 0x20000L);
+}
+
+static void bench_scrollbar(void)
+{
+    EVE_cmd_scrollbar(10, 10, 200U, 20U, 0U, 10U, 20U, 100U);
+}
+
+static void bench_scrollbar_burst(void)
+{
+    EVE_cmd_scrollbar_burst(10, 10, 200U, 20U, 0U, 10U, 20U, 100U);
+}
+
+static void bench_setbase(void)
+{
+    EVE_cmd_setbase(16UL);
+}
+
+static void bench_setbase_burst(void)
+{
+    EVE_cmd_setbase_burst(16UL);
+}
+
+static void bench_setbitmap(void)
+{
+    EVE_cmd_setbitmap(BENCH_MEM, EVE_L8, 32U, 32U);
+}
+
+static void bench_setbitmap_burst(void)
+{
+    EVE_cmd_setbitmap_burst(BENCH_MEM, EVE_L8, 32U, 32U);
+}
+
+static void bench_setfont(void)
+{
+    EVE_cmd_setfont(5UL, BENCH_MEM);
+}
+
+static void bench_setfont_burst(void)
+{
+    EVE_cmd_setfont_burst(5UL, BENCH_MEM);
+}
+
+static void bench_setfont2(void)
+{
+    EVE_cmd_setfont2(5UL, BENCH_MEM, 32UL);
+}
+
+static void bench_setfont2_burst(void)
+{
+    EVE_cmd_setfont2_burst(5UL, BENCH_MEM, 32UL);
+}
+
+static void bench_setscratch(void)
+{
+    EVE_cmd_setscratch(14UL);
+}
+
+static void bench_setscratch_burst(void)
+{
+    EVE_cmd_setscratch_burst(14UL);
+}
+
+static void bench_sketch(void)
+{
+    EVE_cmd_sketch(0, 0, 100U, 100U, BENCH_MEM, EVE_L8);
+}
+
+static void bench_sketch_burst(void)
+{
+    EVE_cmd_sketch_burst(0, 0, 100U, 100U, BENCH_MEM, EVE_L8);
+}
+
+static void bench_slider(void)
+{
+    EVE_cmd_slider(10, 10, 200U, 20U, 0U, 50U, 100U);
+}
+
+static void bench_slider_burst(void)
+{
+    EVE_cmd_slider_burst(10, 10, 200U, 20U, 0U, 50U, 100U);
+}
+
+static void bench_spinner(void)
+{
+    EVE_cmd_spinner(100, 100, 0U, 0U);
+}
+
+static void bench_spinner_burst(void)
+{
+    EVE_cmd_spinner_burst(100, 100, 0U, 0U);
+}
+
+static void bench_text(void)
+{
+    EVE_cmd_text(10, 10, 28U, 0U, "Hello World");
+}
+
+static void bench_text_burst(void)
+{
+    EVE_cmd_text_burst(10, 10, 28U, 0U, "Hello World");
+}
+
+static void bench_toggle(void)
+{
+    EVE_cmd_toggle(10, 10, 60U, 28U, 0U, 0U, "on\xffoff");
+}
+
+static void bench_toggle_burst(void)
+{
+    EVE_cmd_toggle_burst(10, 10, 60U, 28U, 0U, 0U, "on\xffoff");
+}
+
+static void bench_translate(void)
+{
+    EVE_cmd_translate(0x10000L, 0x10000L);
+}
+
+static void bench_translate_burst(void)
+{
+    EVE_cmd_translate_burst(0x10000L, 0x10000L);
+}
+
+static void bench_color_rgb(void)
+{
+    EVE_color_rgb(0x00ff8000UL);
+}
+
+static void bench_color_rgb_burst(void)
+{
+    EVE_color_rgb_burst(0x00ff8000UL);
+}
+
+static void bench_color_a(void)
+{
+    EVE_color_a(128U);
+}
+
+static void bench_color_a_burst(void)
+{
+    EVE_color_a_burst(128U);
+}
+
+/* ################################################################## */
+
+/* same order as in EVE_commands.h, the plain functions are used in both modes if they have a burst-mode branch */
+static const bench_t bench_list[] =
+{
+#if EVE_GEN > 3
+    {"EVE_cmd_flashprogram", bench_flashprogram, BENCH_SINGLE, 0U},
+    {"EVE_cmd_fontcache", bench_fontcache, BENCH_SINGLE, 0U},
+    {"EVE_cmd_fontcachequery", bench_fontcachequery, BENCH_SINGLE, 0U},
+    {"EVE_cmd_getimage", bench_getimage, BENCH_SINGLE, 0U},
+    {"EVE_cmd_linetime", bench_linetime, BENCH_SINGLE, 0U},
+    {"EVE_cmd_newlist", bench_newlist, BENCH_SINGLE, 0U},
+    {"EVE_cmd_pclkfreq", bench_pclkfreq, BENCH_SINGLE, 0U},
+    {"EVE_cmd_wait", bench_wait, BENCH_SINGLE, 0U},
+#endif
+#if EVE_GEN > 2
+    {"EVE_cmd_clearcache", bench_clearcache, BENCH_SINGLE, 0U},
+    {"EVE_cmd_flashdetach", bench_flashdetach, BENCH_SINGLE, 0U},
+    {"EVE_cmd_flashspidesel", bench_flashspidesel, BENCH_SINGLE, 0U},
+    {"EVE_cmd_flashspirx", bench_flashspirx, BENCH_SINGLE, 0U},
+    {"EVE_cmd_flashspitx", bench_flashspitx, BENCH_SINGLE, 0U},
+    {"EVE_cmd_flashattach", bench_flashattach, BENCH_SINGLE, 0U},
+    {"EVE_cmd_flashfast", bench_flashfast, BENCH_SINGLE, 0U},
+    {"EVE_cmd_flasherase", bench_flasherase, BENCH_SINGLE, 1U},
+    {"EVE_cmd_flashread", bench_flashread, BENCH_SINGLE, 0U},
+    {"EVE_cmd_flashsource", bench_flashsource, BENCH_SINGLE, 0U},
+    {"EVE_cmd_flashupdate", bench_flashupdate, BENCH_SINGLE, 0U},
+    {"EVE_cmd_flashwrite", bench_flashwrite, BENCH_SINGLE, 0U},
+    {"EVE_cmd_inflate2", bench_inflate2, BENCH_SINGLE, 0U},
+#endif
+    {"EVE_cmd_getprops", bench_getprops, BENCH_SINGLE, 0U},
+    {"EVE_cmd_getptr", bench_getptr, BENCH_SINGLE, 0U},
+    {"EVE_cmd_inflate", bench_inflate, BENCH_SINGLE, 0U},
+    {"EVE_cmd_interrupt", bench_interrupt, BENCH_SINGLE, 0U},
+    {"EVE_cmd_loadimage", bench_loadimage, BENCH_SINGLE, 0U},
+    {"EVE_cmd_mediafifo", bench_mediafifo, BENCH_SINGLE, 0U},
+    {"EVE_cmd_memcpy", bench_memcpy, BENCH_SINGLE, 0U},
+    {"EVE_cmd_memcrc", bench_memcrc, BENCH_SINGLE, 0U},
+    {"EVE_cmd_memset", bench_memset, BENCH_SINGLE, 0U},
+    {"EVE_cmd_memzero", bench_memzero, BENCH_SINGLE, 0U},
+    {"EVE_cmd_playvideo", bench_playvideo, BENCH_SINGLE, 0U},
+    {"EVE_cmd_setrotate", bench_setrotate, BENCH_SINGLE, 0U},
+    {"EVE_cmd_snapshot", bench_snapshot, BENCH_SINGLE, 1U},
+    {"EVE_cmd_snapshot2", bench_snapshot2, BENCH_SINGLE, 0U},
+    {"EVE_cmd_track", bench_track, BENCH_SINGLE, 0U},
+    {"EVE_cmd_videoframe", bench_videoframe, BENCH_SINGLE, 0U},
+#if EVE_GEN > 3
+    {"EVE_cmd_animframeram", bench_animframeram, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_animframeram_burst", bench_animframeram_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_animstartram", bench_animstartram, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_animstartram_burst", bench_animstartram_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_apilevel", bench_apilevel, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_apilevel_burst", bench_apilevel_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_calibratesub", bench_calibratesub, BENCH_SINGLE, 0U},
+    {"EVE_cmd_calllist", bench_calllist, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_calllist_burst", bench_calllist_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_hsf", bench_hsf, BENCH_SINGLE, 0U},
+    {"EVE_cmd_runanim", bench_runanim, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_runanim_burst", bench_runanim_burst, BENCH_BURST, 0U},
+#endif
+#if EVE_GEN > 2
+    {"EVE_cmd_animdraw", bench_animdraw, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_animdraw_burst", bench_animdraw_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_animframe", bench_animframe, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_animframe_burst", bench_animframe_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_animstart", bench_animstart, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_animstart_burst", bench_animstart_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_animstop", bench_animstop, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_animstop_burst", bench_animstop_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_animxy", bench_animxy, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_animxy_burst", bench_animxy_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_appendf", bench_appendf, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_appendf_burst", bench_appendf_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_bitmap_transform", bench_bitmap_transform, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_bitmap_transform_burst", bench_bitmap_transform_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_fillwidth", bench_fillwidth, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_fillwidth_burst", bench_fillwidth_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_gradienta", bench_gradienta, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_gradienta_burst", bench_gradienta_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_rotatearound", bench_rotatearound, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_rotatearound_burst", bench_rotatearound_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_button_var", bench_button_var, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_button_var_burst", bench_button_var_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_text_var", bench_text_var, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_text_var_burst", bench_text_var_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_toggle_var", bench_toggle_var, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_toggle_var_burst", bench_toggle_var_burst, BENCH_BURST, 0U},
+#endif
+    {"EVE_cmd_dl", bench_dl, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_dl_burst", bench_dl_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_append", bench_append, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_append_burst", bench_append_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_bgcolor", bench_bgcolor, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_bgcolor_burst", bench_bgcolor_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_button", bench_button, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_button_burst", bench_button_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_calibrate", bench_calibrate, BENCH_SINGLE, 0U},
+    {"EVE_cmd_clock", bench_clock, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_clock_burst", bench_clock_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_dial", bench_dial, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_dial_burst", bench_dial_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_fgcolor", bench_fgcolor, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_fgcolor_burst", bench_fgcolor_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_gauge", bench_gauge, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_gauge_burst", bench_gauge_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_getmatrix", bench_getmatrix, BENCH_SINGLE, 0U},
+    {"EVE_cmd_gradcolor", bench_gradcolor, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_gradcolor_burst", bench_gradcolor_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_gradient", bench_gradient, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_gradient_burst", bench_gradient_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_keys", bench_keys, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_keys_burst", bench_keys_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_number", bench_number, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_number_burst", bench_number_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_progress", bench_progress, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_progress_burst", bench_progress_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_romfont", bench_romfont, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_romfont_burst", bench_romfont_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_rotate", bench_rotate, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_rotate_burst", bench_rotate_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_scale", bench_scale, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_scale_burst", bench_scale_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_scrollbar", bench_scrollbar, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_scrollbar_burst", bench_scrollbar_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_setbase", bench_setbase, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_setbase_burst", bench_setbase_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_setbitmap", bench_setbitmap, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_setbitmap_burst", bench_setbitmap_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_setfont", bench_setfont, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_setfont_burst", bench_setfont_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_setfont2", bench_setfont2, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_setfont2_burst", bench_setfont2_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_setscratch", bench_setscratch, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_setscratch_burst", bench_setscratch_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_sketch", bench_sketch, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_sketch_burst", bench_sketch_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_slider", bench_slider, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_slider_burst", bench_slider_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_spinner", bench_spinner, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_spinner_burst", bench_spinner_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_text", bench_text, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_text_burst", bench_text_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_toggle", bench_toggle, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_toggle_burst", bench_toggle_burst, BENCH_BURST, 0U},
+    {"EVE_cmd_translate", bench_translate, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_cmd_translate_burst", bench_translate_burst, BENCH_BURST, 0U},
+    {"EVE_color_rgb", bench_color_rgb, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_color_rgb_burst", bench_color_rgb_burst, BENCH_BURST, 0U},
+    {"EVE_color_a", bench_color_a, BENCH_SINGLE | BENCH_BURST, 0U},
+    {"EVE_color_a_burst", bench_color_a_burst, BENCH_BURST, 0U},
+    {"EVE_memWrite_sram_buffer", bench_memwrite_sram_buffer, BENCH_SINGLE, 0U},
+    {"EVE_memRead_sram_buffer", bench_memread_sram_buffer, BENCH_SINGLE, 0U}
+};
+
+/* ##################################################################
+    behaviour checks
+##################################################################### */
+
+static void check_true(uint8_t condition, const char *p_condition, int line)
+{
+    if (0U == condition)
+    {
+        (void) fprintf(stderr, "main.c:%d: check failed: %s\n", line, p_condition);
+        check_failures++;
+    }
+}
+
+/* a display list with the color words "first" to "first + count - 1" */
+static void check_frame(uint32_t first, uint32_t count)
+{
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_cmd_dl_burst(DL_CLEAR_COLOR_RGB);
+    EVE_cmd_dl_burst(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        EVE_cmd_dl_burst(DL_COLOR_RGB | ((first + index) & 0xffffffUL));
+    }
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+}
+
+/* waits for the CMD_SWAP of the last display list to be executed with the next frame */
+static void check_swap(void)
+{
+    while (EVE_DLSWAP_DONE != EVE_memRead8(REG_DLSWAP))
+    {
+    }
+}
+
+/* compares RAM_DL with what check_frame() wrote */
+static void check_frame_dl(uint32_t first, uint32_t count)
+{
+    uint32_t equal = 1U;
+
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        if (EVE_model_peek32(EVE_RAM_DL + 8UL + (index * 4UL)) != (DL_COLOR_RGB | ((first + index) & 0xffffffUL)))
+        {
+            equal = 0U;
+        }
+    }
+    CHECK(0U != equal);
+    CHECK(DL_DISPLAY == EVE_model_peek32(EVE_RAM_DL + 8UL + (count * 4UL)));
+}
+
+/* a burst that is almost three times the size of the CMD-FIFO and that starts with a frame, */
+/* the co-processor stops at the CMD_DLSTART of the second frame until the first one is on screen, */
+/* segments that do not fit in the free space then are FIFO overflows */
+static void check_burst_segments(void)
+{
+    EVE_model_stats_t stats;
+
+    EVE_start_cmd_burst();
+    check_frame(0UL, 0U);
+    check_frame(0x123400UL, 1800U);
+    check_frame(0x432100UL, 1200U);
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    check_swap();
+
+    EVE_model_get_stats(&stats);
+    CHECK(((1800UL + 1200UL + 15UL) * 4UL) == stats.fifo_bytes); /* every command once */
+    CHECK(0U == stats.fifo_overflows);
+    CHECK(3U == stats.swaps);
+    CHECK(((1200UL + 3UL) * 4UL) == EVE_model_peek32(REG_CMD_DL));
+    check_frame_dl(0x432100UL, 1200U);
+}
+
+/* compares BENCH_BLOCK_SIZE bytes of RAM_G with bench_pattern */
+static uint8_t check_pattern(uint32_t address)
+{
+    uint8_t equal = 1U;
+
+    for (uint32_t index = 0U; index < BENCH_BLOCK_SIZE; index += 4U)
+    {
+        uint32_t expected = ((uint32_t) bench_pattern[index]) | (((uint32_t) bench_pattern[index + 1U]) << 8U)
+            | (((uint32_t) bench_pattern[index + 2U]) << 16U) | (((uint32_t) bench_pattern[index + 3U]) << 24U);
+
+        if (EVE_model_peek32(address + index) != expected)
+        {
+            equal = 0U;
+        }
+    }
+    return (equal);
+}
+
+/* a CMD_INFLATE with more data than fits in the CMD-FIFO and a CMD_MEMCPY, */
+/* both are advanced by EVE_cmd_poll() without waiting on the host */
+static void check_cmd_poll(void)
+{
+    EVE_cmd_job_t job;
+    uint32_t adler_a = 1U;
+    uint32_t adler_b = 0U;
+    uint32_t polls = 0U;
+    uint8_t status;
+
+    check_zlib[0U] = 0x78U;
+    check_zlib[1U] = 0x01U;
+    check_zlib[2U] = 0x01U; /* the final block, stored */
+    check_zlib[3U] = (uint8_t) BENCH_BLOCK_SIZE;
+    check_zlib[4U] = (uint8_t) (BENCH_BLOCK_SIZE >> 8U);
+    check_zlib[5U] = (uint8_t) ~check_zlib[3U];
+    check_zlib[6U] = (uint8_t) ~check_zlib[4U];
+    for (uint32_t index = 0U; index < BENCH_BLOCK_SIZE; index++)
+    {
+        check_zlib[7U + index] = bench_pattern[index];
+        adler_a = (adler_a + bench_pattern[index]) % 65521UL;
+        adler_b = (adler_b + adler_a) % 65521UL;
+    }
+    check_zlib[BENCH_BLOCK_SIZE + 7U] = (uint8_t) (adler_b >> 8U);
+    check_zlib[BENCH_BLOCK_SIZE + 8U] = (uint8_t) adler_b;
+    check_zlib[BENCH_BLOCK_SIZE + 9U] = (uint8_t) (adler_a >> 8U);
+    check_zlib[BENCH_BLOCK_SIZE + 10U] = (uint8_t) adler_a;
+
+    EVE_cmd_memzero(BENCH_MEM, 2UL * BENCH_BLOCK_SIZE);
+    EVE_execute_cmd();
+
+    status = EVE_cmd_inflate_start(&job, BENCH_MEM, check_zlib, sizeof(check_zlib));
+    while (EVE_IS_BUSY == status)
+    {
+        polls++;
+        status = EVE_cmd_poll(&job);
+    }
+    CHECK(E_OK == status);
+    CHECK(polls > 1U); /* the data took more than one step */
+    CHECK(sizeof(check_zlib) == job.done);
+    CHECK(0U != check_pattern(BENCH_MEM));
+
+    status = EVE_cmd_memcpy_start(&job, BENCH_MEM + BENCH_BLOCK_SIZE, BENCH_MEM, BENCH_BLOCK_SIZE);
+    while (EVE_IS_BUSY == status)
+    {
+        status = EVE_cmd_poll(&job);
+    }
+    CHECK(E_OK == status);
+    CHECK(0U != check_pattern(BENCH_MEM + BENCH_BLOCK_SIZE));
+    CHECK(E_OK == EVE_cmd_poll(&job)); /* a finished job stays finished */
+}
+
+static void check_callback(uint8_t int_flags)
+{
+    check_callbacks++;
+    check_flags = int_flags;
+}
+
+/* an interrupt from CMD_INTERRUPT goes thru INT_N and EVE_int_edge() to the callback for EVE_INT_CMDFLAG */
+static void check_int_dispatch(void)
+{
+    check_callbacks = 0U;
+    check_flags = 0U;
+    (void) EVE_memRead8(REG_INT_FLAGS); /* the flags are set regardless of REG_INT_MASK */
+    EVE_model_set_int_hook(EVE_int_edge);
+
+    EVE_int_set_callback(EVE_INT_CMDFLAG, check_callback);
+    CHECK(EVE_INT_CMDFLAG == EVE_model_peek32(REG_INT_MASK));
+    CHECK(1U == EVE_model_peek32(REG_INT_EN));
+    CHECK(0U == EVE_int_service()); /* no edge, nothing to read */
+
+    EVE_cmd_interrupt(0UL);
+    EVE_execute_cmd();
+    CHECK(0U == check_callbacks); /* the callbacks are only called from EVE_int_service() */
+    CHECK(0U != (EVE_INT_CMDFLAG & EVE_int_service()));
+    CHECK(1U == check_callbacks);
+    CHECK(0U != (EVE_INT_CMDFLAG & check_flags));
+    CHECK(0U == EVE_model_peek32(REG_INT_FLAGS)); /* cleared by the read */
+    CHECK(0U == EVE_int_service());
+    CHECK(1U == check_callbacks);
+
+    EVE_int_set_callback(EVE_INT_CMDFLAG, NULL);
+    CHECK(0U == EVE_model_peek32(REG_INT_MASK));
+    CHECK(0U == EVE_model_peek32(REG_INT_EN));
+    EVE_model_set_int_hook(NULL);
+}
+
+static void check_segment_build(void)
+{
+    for (uint32_t index = 0U; index < 20U; index++)
+    {
+        EVE_cmd_dl(DL_COLOR_RGB | (check_first + index));
+    }
+}
+
+/* a segment is recorded to RAM_G once, replayed into a frame by CMD_APPEND and recorded again for new inputs */
+static void check_segment(void)
+{
+    EVE_segment_t segment;
+    EVE_model_stats_t stats;
+    uint32_t address;
+    uint32_t equal = 1U;
+
+    EVE_ram_init(0U);
+    check_first = 0x050000UL;
+    EVE_segment_init(&segment, check_segment_build);
+    CHECK(E_OK == EVE_segment_update(&segment, 1UL));
+    CHECK((20U * 4U) == segment.length);
+    address = EVE_ram_address(segment.handle);
+    for (uint32_t index = 0U; index < 20U; index++)
+    {
+        if ((DL_COLOR_RGB | (0x050000UL + index)) != EVE_model_peek32(address + (index * 4UL)))
+        {
+            equal = 0U;
+        }
+    }
+    CHECK(0U != equal);
+
+    EVE_model_clear_stats();
+    check_first = 0x060000UL; /* not seen without a change of the inputs */
+    CHECK(E_OK == EVE_segment_update(&segment, 1UL));
+    EVE_model_get_stats(&stats);
+    CHECK(0U == stats.spi_bytes);
+
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_cmd_dl_burst(DL_CLEAR_COLOR_RGB);
+    EVE_cmd_dl_burst(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    EVE_segment_append_burst(&segment);
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    check_swap();
+    CHECK(((20UL + 3UL) * 4UL) == EVE_model_peek32(REG_CMD_DL));
+    check_frame_dl(0x050000UL, 20U);
+
+    CHECK(E_OK == EVE_segment_update(&segment, 2UL));
+    CHECK(0x060000UL == (EVE_model_peek32(EVE_ram_address(segment.handle)) & 0xffffffUL));
+
+    EVE_ram_free(segment.handle);
+}
+
+/* freeing the first block leaves a gap that EVE_ram_compact() closes, the data moves along */
+/* with the blocks and a segment behind them is recorded again at its new address */
+static void check_ram_compact(void)
+{
+    EVE_segment_t segment;
+    EVE_ram_stats_t ram_stats;
+    EVE_model_stats_t stats;
+    uint8_t first;
+    uint8_t second;
+
+    EVE_ram_init(0U);
+    first = EVE_ram_alloc(1000UL, 4UL);
+    second = EVE_ram_alloc(BENCH_BLOCK_SIZE, 256UL);
+    CHECK((0U != first) && (0U != second));
+    CHECK(1024UL == EVE_ram_address(second));
+    EVE_memWrite_sram_buffer(EVE_ram_address(second), bench_pattern, BENCH_BLOCK_SIZE);
+
+    check_first = 0x070000UL;
+    EVE_segment_init(&segment, check_segment_build);
+    CHECK(E_OK == EVE_segment_update(&segment, 1UL));
+    CHECK(EVE_ram_address(segment.handle) == (1024UL + BENCH_BLOCK_SIZE));
+
+    EVE_ram_free(first);
+    EVE_ram_get_stats(&ram_stats);
+    CHECK(2U == ram_stats.blocks);
+    CHECK(0U != ram_stats.fragmentation);
+
+    CHECK(2U == EVE_ram_compact());
+    CHECK(0UL == EVE_ram_address(second));
+    CHECK(BENCH_BLOCK_SIZE == EVE_ram_address(segment.handle));
+    EVE_execute_cmd();
+    CHECK(0U != check_pattern(0UL));
+    EVE_ram_get_stats(&ram_stats);
+    CHECK(0U == ram_stats.fragmentation);
+    CHECK((ram_stats.size - ram_stats.used) == ram_stats.largest_free);
+    CHECK(0U == EVE_ram_compact()); /* nothing left to move */
+
+    EVE_model_clear_stats();
+    CHECK(E_OK == EVE_segment_update(&segment, 1UL));
+    EVE_model_get_stats(&stats);
+    CHECK(0U != stats.fifo_bytes); /* recorded again */
+    CHECK((DL_COLOR_RGB | 0x070000UL) == EVE_model_peek32(BENCH_BLOCK_SIZE));
+
+    EVE_ram_free(second);
+    EVE_ram_free(segment.handle);
+}
+
+/* returns bench_png in pieces of 20 bytes */
+static uint32_t check_media_read(uint8_t *p_buffer, uint32_t max)
+{
+    uint32_t length = sizeof(bench_png) - check_media_pos;
+
+    length = (length > 20U) ? 20U : length;
+    length = (length > max) ? max : length;
+    for (uint32_t index = 0U; index < length; index++)
+    {
+        p_buffer[index] = bench_png[check_media_pos + index];
+    }
+    check_media_pos += length;
+    return (length);
+}
+
+/* a .png thru a media FIFO that is smaller than the image, the FIFO wraps around a couple of times */
+static void check_media_fifo(void)
+{
+    EVE_media_t media;
+    uint8_t buffer[32U];
+    uint32_t pointer = 0U;
+    uint32_t width = 0U;
+    uint32_t height = 0U;
+    uint32_t polls = 0U;
+    uint8_t status;
+
+    check_media_pos = 0U;
+    CHECK(E_OK == EVE_media_start(&media, 0xf0000UL, 64UL, buffer, sizeof(buffer), check_media_read));
+    CHECK(60U == media.total); /* filled up to four bytes before the read pointer */
+    CHECK(60U == EVE_model_peek32(REG_MEDIAFIFO_WRITE));
+
+    EVE_cmd_loadimage(BENCH_MEM, EVE_OPT_MEDIAFIFO | EVE_OPT_NODL, NULL, 0UL);
+    do
+    {
+        polls++;
+        status = EVE_media_poll(&media);
+    } while (EVE_IS_BUSY == status);
+
+    CHECK(E_OK == status);
+    CHECK(polls > 2U);
+    CHECK(sizeof(bench_png) == media.total);
+    CHECK(EVE_model_peek32(REG_MEDIAFIFO_READ) == EVE_model_peek32(REG_MEDIAFIFO_WRITE));
+    CHECK(EVE_IS_BUSY != EVE_media_poll(&media)); /* nothing more to do */
+
+    EVE_cmd_getprops(&pointer, &width, &height);
+    CHECK((BENCH_MEM == pointer) && (8U == width) && (8U == height));
+}
+
+/* a frame with the text fields */
+static void check_text_frame(EVE_text_t *p_texts, uint16_t count)
+{
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_text_burst(p_texts, count);
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    check_swap();
+}
+
+/* text, button and toggle fields are sent as widgets first and appended once they were recorded, */
+/* the display list from CMD_APPEND has to be the same as the one from the widgets */
+static void check_text_fields(void)
+{
+    EVE_text_t texts[3U];
+    EVE_text_stats_t text_stats;
+    uint32_t words[96U];
+    uint32_t length;
+    uint32_t equal = 1U;
+
+    EVE_ram_init(0U);
+    EVE_text_get_stats(&text_stats, 1U);
+    EVE_text_init(&texts[0U], 10, 10, 28U, 0U);
+    EVE_text_init_button(&texts[1U], 10, 50, 100U, 40U, 28U, 0U);
+#if EVE_GEN > 2
+    EVE_text_init_toggle(&texts[2U], 10, 100, 60U, 28U, EVE_OPT_FORMAT, 0U);
+    CHECK(0U == texts[2U].options); /* formatted on the host */
+#else
+    EVE_text_init_toggle(&texts[2U], 10, 100, 60U, 28U, 0U, 0U);
+#endif
+    EVE_text_set_int(&texts[0U], -1234L, 2U);
+    CHECK(0 == strcmp(texts[0U].text, "-12.34"));
+    EVE_text_set(&texts[1U], "Button");
+    EVE_text_set(&texts[2U], "off\xffon");
+
+    EVE_text_update(texts, 3U);
+    check_text_frame(texts, 3U);
+    length = EVE_model_peek32(REG_CMD_DL);
+    CHECK((length > 12U) && (length <= sizeof(words)));
+    for (uint32_t index = 0U; (index < (length / 4U)) && (index < 96U); index++)
+    {
+        words[index] = EVE_model_peek32(EVE_RAM_DL + (index * 4U));
+    }
+
+    EVE_text_set(&texts[1U], "Button"); /* the same string, no change */
+    EVE_text_update(texts, 3U);
+    check_text_frame(texts, 3U);
+    CHECK(length == EVE_model_peek32(REG_CMD_DL));
+    for (uint32_t index = 0U; (index < (length / 4U)) && (index < 96U); index++)
+    {
+        if (words[index] != EVE_model_peek32(EVE_RAM_DL + (index * 4U)))
+        {
+            equal = 0U;
+        }
+    }
+    CHECK(0U != equal);
+
+    EVE_text_set_state(&texts[2U], 65535U);
+    EVE_text_update(texts, 3U);
+    check_text_frame(texts, 3U);
+
+    EVE_text_get_stats(&text_stats, 1U);
+    CHECK(3U == text_stats.frames);
+    CHECK(3U == text_stats.records);
+    CHECK(4U == text_stats.texts); /* all three in the first frame, the toggle in the last one */
+    CHECK(5U == text_stats.appends);
+
+    for (uint8_t index = 0U; index < 3U; index++)
+    {
+        EVE_ram_free(texts[index].segment.handle);
+    }
+}
+
+/* the six REG_TOUCH_TRANSFORM_x registers are one CMD_MEMWRITE in a batch, REG_PWM_DUTY a second one, */
+/* EVE_memRead_regs() and EVE_memWrite_regs() move all six in one transfer each */
+static void check_reg_batch(void)
+{
+    EVE_reg_batch_t batch;
+    EVE_model_stats_t stats;
+    uint32_t words[13U];
+    uint32_t saved[6U];
+    uint32_t values[6U];
+    uint32_t pwm_duty = EVE_memRead8(REG_PWM_DUTY);
+
+    EVE_memRead_regs(REG_TOUCH_TRANSFORM_A, saved, 6U);
+    for (uint8_t index = 0U; index < 6U; index++)
+    {
+        CHECK(saved[index] == EVE_model_peek32(REG_TOUCH_TRANSFORM_A + (index * 4UL)));
+    }
+
+    EVE_reg_batch_init(&batch, words, 13U);
+    for (uint8_t index = 0U; index < 6U; index++)
+    {
+        CHECK(E_OK == EVE_reg_batch_write(&batch, REG_TOUCH_TRANSFORM_A + (index * 4UL), 0x10000UL + index));
+    }
+    CHECK(E_OK == EVE_reg_batch_write(&batch, REG_PWM_DUTY, 42UL));
+    CHECK(E_NOT_OK == EVE_reg_batch_write(&batch, REG_MACRO_0, 0UL)); /* the batch is full */
+    CHECK(13U == batch.count);
+    CHECK((6UL * 4UL) == words[2U]);
+
+    EVE_model_clear_stats();
+    EVE_reg_batch_send(&batch);
+    EVE_execute_cmd();
+    EVE_model_get_stats(&stats);
+    CHECK((13UL * 4UL) == stats.fifo_bytes);
+    CHECK(0U == batch.count);
+    CHECK(42UL == EVE_model_peek32(REG_PWM_DUTY));
+
+    EVE_model_clear_stats();
+    EVE_memRead_regs(REG_TOUCH_TRANSFORM_A, values, 6U);
+    EVE_model_get_stats(&stats);
+    CHECK(1U == stats.cs_cycles);
+    for (uint8_t index = 0U; index < 6U; index++)
+    {
+        CHECK((0x10000UL + index) == values[index]);
+    }
+
+    EVE_model_clear_stats();
+    EVE_memWrite_regs(REG_TOUCH_TRANSFORM_A, saved, 6U);
+    EVE_model_get_stats(&stats);
+    CHECK(1U == stats.cs_cycles);
+    CHECK((3UL + (6UL * 4UL)) == stats.spi_bytes);
+    for (uint8_t index = 0U; index < 6U; index++)
+    {
+        CHECK(saved[index] == EVE_model_peek32(REG_TOUCH_TRANSFORM_A + (index * 4UL)));
+    }
+    EVE_memWrite8(REG_PWM_DUTY, (uint8_t) pwm_duty);
+}
+
+/* takes the next touch event and compares its type and finger */
+static uint8_t check_touch_next(EVE_touch_event_t *p_event, uint8_t type, uint8_t finger)
+{
+    uint8_t ret = 0U;
+
+    if (E_OK == EVE_touch_get_event(p_event))
+    {
+        ret = ((type == p_event->type) && (finger == p_event->finger)) ? 1U : 0U;
+    }
+    return (ret);
+}
+
+/* one pass of the main loop of an application */
+static uint8_t check_touch_loop(uint32_t time_ms)
+{
+    (void) EVE_int_service();
+    return (EVE_touch_service(time_ms));
+}
+
+/* two fingers on touch points 0 and 4, the first one swipes to the right and the second one is a long-press, */
+/* the registers are only read between a touch interrupt and the release of the last finger */
+static void check_touch_events(void)
+{
+    EVE_touch_event_t event;
+    EVE_touch_stats_t touch_stats;
+    EVE_model_stats_t stats;
+
+    (void) EVE_memRead8(REG_INT_FLAGS);
+    EVE_model_set_int_hook(EVE_int_edge);
+    EVE_touch_init(5U);
+    EVE_touch_get_stats(&touch_stats, 1U);
+    CHECK(0U == check_touch_loop(1000UL)); /* the first sample after the init, nobody is touching */
+
+    EVE_model_clear_stats();
+    CHECK(0U == check_touch_loop(1020UL));
+    EVE_model_get_stats(&stats);
+    CHECK(0U == stats.spi_bytes); /* idle */
+
+    EVE_model_touch_point(0U, (100UL << 16U) | 50UL, 7U);
+    EVE_model_touch_point(4U, (300UL << 16U) | 200UL, 9U);
+    CHECK(0U == check_touch_loop(1040UL)); /* the debounce */
+    CHECK(0U == check_touch_loop(1045UL)); /* not yet EVE_TOUCH_INTERVAL_MS later */
+    CHECK(2U == check_touch_loop(1050UL));
+    CHECK(0U != check_touch_next(&event, EVE_TOUCH_PRESS, 0U));
+    CHECK((100 == event.xc0) && (50 == event.yc0) && (7U == event.tag));
+    CHECK(0U != check_touch_next(&event, EVE_TOUCH_PRESS, 4U));
+    CHECK((300 == event.xc0) && (200 == event.yc0) && (9U == event.tag));
+
+    EVE_model_touch_point(0U, (200UL << 16U) | 50UL, 7U);
+    CHECK(1U == check_touch_loop(1060UL));
+    CHECK(0U != check_touch_next(&event, EVE_TOUCH_DRAG, 0U));
+    CHECK((100 == event.dx) && (0 == event.dy));
+
+    EVE_model_touch_point(0U, 0x80008000UL, 0U);
+    CHECK(0U == check_touch_loop(1070UL));
+    CHECK(2U == check_touch_loop(1080UL));
+    CHECK(0U != check_touch_next(&event, EVE_TOUCH_SWIPE, 0U));
+    CHECK(EVE_SWIPE_RIGHT == event.direction);
+    CHECK(0U != check_touch_next(&event, EVE_TOUCH_RELEASE, 0U));
+    CHECK(200 == event.xc0);
+
+    CHECK(1U == check_touch_loop(1900UL));
+    CHECK(0U != check_touch_next(&event, EVE_TOUCH_LONG, 4U));
+    EVE_model_touch_point(4U, 0x80008000UL, 0U);
+    CHECK(0U == check_touch_loop(1910UL));
+    CHECK(1U == check_touch_loop(1920UL));
+    CHECK(0U != check_touch_next(&event, EVE_TOUCH_RELEASE, 4U));
+    CHECK(E_NOT_OK == EVE_touch_get_event(&event));
+
+    EVE_model_clear_stats();
+    CHECK(0U == check_touch_loop(2000UL));
+    EVE_model_get_stats(&stats);
+    CHECK(0U == stats.spi_bytes); /* all fingers are up, idle again */
+
+    EVE_touch_get_stats(&touch_stats, 1U);
+    CHECK(7U == touch_stats.events);
+    CHECK(0U == touch_stats.dropped);
+    CHECK(9U == touch_stats.samples); /* from 1000 to 1920, none at 1045 and 2000 */
+
+    EVE_int_set_callback(EVE_INT_TOUCH, NULL);
+    EVE_model_set_int_hook(NULL);
+    EVE_memWrite8(REG_CTOUCH_EXTENDED, 1U);
+}
+
+static void check_list_row(uint16_t row)
+{
+    check_callbacks++;
+    EVE_cmd_dl(DL_COLOR_RGB | (0x070000UL + row));
+}
+
+/* a frame with the list, compares RAM_DL with the rows from first to first + count - 1 */
+/* and returns the bytes the frame took in the CMD-FIFO */
+static uint32_t check_list_frame(const EVE_list_t *p_list, uint16_t first, uint16_t count)
+{
+    EVE_model_stats_t stats;
+    uint32_t address = EVE_RAM_DL + 20UL; /* behind CLEAR_COLOR_RGB, CLEAR, SAVE_CONTEXT and the scissor */
+    uint32_t equal = 1U;
+
+    EVE_model_clear_stats();
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_cmd_dl_burst(DL_CLEAR_COLOR_RGB);
+    EVE_cmd_dl_burst(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    EVE_list_burst(p_list);
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    check_swap();
+    EVE_model_get_stats(&stats);
+
+    CHECK(SCISSOR_SIZE(p_list->width, p_list->height) == EVE_model_peek32(EVE_RAM_DL + 16UL));
+    for (uint16_t row = first; row < (first + count); row++)
+    {
+        int32_t translate = (((int32_t) p_list->yc0 + ((int32_t) row * (int32_t) p_list->row_height)) * 16) - p_list->offset;
+
+        if ((VERTEX_TRANSLATE_X((int32_t) p_list->xc0 * 16) != EVE_model_peek32(address))
+            || (VERTEX_TRANSLATE_Y(translate) != EVE_model_peek32(address + 4UL))
+            || ((DL_COLOR_RGB | (0x070000UL + row)) != EVE_model_peek32(address + 8UL)))
+        {
+            equal = 0U;
+        }
+        address += 12UL;
+    }
+    CHECK(0U != equal);
+    CHECK(DL_RESTORE_CONTEXT == EVE_model_peek32(address));
+    CHECK(DL_DISPLAY == EVE_model_peek32(address + 4UL));
+    return (stats.fifo_bytes);
+}
+
+/* 500 rows of 20 pixels in a window for five of them, only the rows that scroll into the window are recorded */
+/* and a frame takes the same bytes no matter where in the list it is */
+static void check_list_scroll(void)
+{
+    EVE_list_t list;
+    uint32_t bytes;
+    uint16_t first;
+
+    EVE_ram_init(0U);
+    EVE_list_init(&list, check_list_row, 500U, 20U);
+    EVE_list_window(&list, 10, 40, 200U, 100U);
+
+    check_callbacks = 0U;
+    EVE_list_update(&list);
+    CHECK(5U == check_callbacks);
+    bytes = check_list_frame(&list, 0U, 5U);
+    EVE_list_update(&list);
+    CHECK(5U == check_callbacks); /* nothing new in the window */
+    CHECK(bytes == check_list_frame(&list, 0U, 5U));
+
+    EVE_list_drag(&list, -10); /* ten pixels up, row 5 is half in the window */
+    EVE_list_update(&list);
+    CHECK(6U == check_callbacks);
+    CHECK((10 * 16) == list.offset);
+    (void) check_list_frame(&list, 0U, 6U);
+    CHECK(0 == EVE_list_row_at(&list, 40));
+    CHECK(2 == EVE_list_row_at(&list, 80));
+    CHECK(-1 == EVE_list_row_at(&list, 140));
+
+    EVE_list_track(&list, 0xffff0000UL); /* the scrollbar all the way down */
+    EVE_list_update(&list);
+    CHECK(11U == check_callbacks);
+    CHECK(((500 * 20) - 100) * 16 == list.offset);
+    CHECK(bytes == check_list_frame(&list, 495U, 5U));
+    CHECK(499 == EVE_list_row_at(&list, 139));
+
+    EVE_list_drag(&list, 32);
+    EVE_list_release(&list);
+    for (uint8_t frame = 0U; (frame < 100U) && (0 != list.velocity); frame++)
+    {
+        EVE_list_update(&list);
+    }
+    CHECK(0 == list.velocity);
+    CHECK(list.offset < ((((500 * 20) - 100) - 32 - 100) * 16)); /* it kept going after the release */
+    first = (uint16_t) (list.offset / (20 * 16));
+    (void) check_list_frame(&list, first, (uint16_t) ((((list.offset + (100 * 16)) - 1) / (20 * 16)) + 1 - first));
+
+    EVE_ram_init(0U);
+}
+
+/* a frame with the chart, every vertex in RAM_DL has to show a bitmap of up to 256 samples that starts */
+/* with the sample for its pixel and ends at the right edge or at the end of a block of 256 bytes of the ring, */
+/* returns the pixels shown by all the vertices */
+static uint32_t check_chart_frame(const EVE_chart_t *p_chart)
+{
+    uint32_t address = EVE_RAM_DL + 8UL; /* behind CLEAR_COLOR_RGB and CLEAR */
+    uint32_t base = EVE_ram_address(p_chart->handle);
+    uint32_t source = 0UL;
+    uint32_t offset = 0UL;
+    uint32_t count = 0UL;
+    uint32_t pixels = 0UL;
+    uint32_t word;
+
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_cmd_dl_burst(DL_CLEAR_COLOR_RGB);
+    EVE_cmd_dl_burst(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    EVE_chart_burst(p_chart);
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    check_swap();
+
+    do
+    {
+        word = EVE_model_peek32(address);
+        address += 4UL;
+
+        if (DL_VERTEX2F == (word & 0xc0000000UL))
+        {
+            uint32_t pos = ((word >> 15U) & 0x7fffUL) - (uint32_t) p_chart->xc0;
+            uint32_t sample = (((uint32_t) p_chart->head - p_chart->width) + pos) & (p_chart->length - 1U);
+
+            CHECK((source - base + offset) == sample);
+            CHECK((count <= 256UL) && ((pos + count) <= p_chart->width));
+            CHECK(((pos + count) == p_chart->width) || ((offset + count) == 256UL));
+            pixels += count;
+        }
+        else if (DL_BITMAP_LAYOUT == (word & 0xff000000UL))
+        {
+            CHECK(((word >> 9U) & 0x3ffUL) <= 256UL);
+        }
+        else if (DL_BITMAP_SOURCE == (word & 0xff000000UL))
+        {
+            source = word & 0x3fffffUL;
+        }
+        else if (DL_BITMAP_SIZE == (word & 0xff000000UL))
+        {
+            count = (word >> 9U) & 0x1ffUL;
+        }
+        else if (DL_BITMAP_TRANSFORM_C == (word & 0xff000000UL))
+        {
+            offset = (word & 0xffffffUL) >> 8U;
+        }
+        else
+        {
+        }
+    } while ((DL_DISPLAY != word) && (address < (EVE_RAM_DL + 8192UL)));
+
+    CHECK(DL_DISPLAY == word);
+    return (pixels);
+}
+
+/* a chart of 600 samples is three tiles, before and after the ring of 1024 bytes wraps around, */
+/* a chart of 200 samples is one tile, the samples are kept upside down in RAM_G */
+static void check_chart(void)
+{
+    EVE_chart_t chart;
+
+    EVE_ram_init(0U);
+    CHECK(E_NOT_OK == EVE_chart_init(&chart, 1U, 10, 20, 1025U, 100U));
+    CHECK(E_OK == EVE_chart_init(&chart, 1U, 10, 20, 600U, 100U));
+    CHECK(1024U == chart.length);
+
+    for (uint16_t sample = 0U; sample < 700U; sample++)
+    {
+        EVE_chart_add(&chart, (uint8_t) sample);
+    }
+    CHECK((255U - 99U) == EVE_memRead8(EVE_ram_address(chart.handle) + 99UL));
+    CHECK(600UL == check_chart_frame(&chart));
+
+    for (uint16_t sample = 700U; sample < 1200U; sample++)
+    {
+        EVE_chart_add(&chart, (uint8_t) sample);
+    }
+    CHECK((uint8_t) (255U - (uint8_t) 1100U) == EVE_memRead8(EVE_ram_address(chart.handle) + 76UL));
+    CHECK(600UL == check_chart_frame(&chart));
+    EVE_chart_line(&chart, 2U);
+    CHECK(1800UL == check_chart_frame(&chart)); /* three vertices for each tile */
+    EVE_chart_free(&chart);
+
+    CHECK(E_OK == EVE_chart_init(&chart, 1U, 10, 20, 200U, 100U));
+    for (uint16_t sample = 0U; sample < 300U; sample++)
+    {
+        EVE_chart_add(&chart, (uint8_t) sample);
+    }
+    CHECK(200UL == check_chart_frame(&chart)); /* REPEAT wraps the ring of 256 bytes in one tile */
+    EVE_chart_free(&chart);
+
+    EVE_ram_init(0U);
+}
+
+/* count frames that are sent when the frame pacing says they are due, each one is built for build_us, */
+/* with refresh set the display is not running and REG_FRAMES is counted up here between the frames, */
+/* the frame pacing sees that the last frame is on screen with the next call of EVE_pace_service() */
+static void check_pace_frames(uint32_t count, uint32_t build_us, uint8_t refresh)
+{
+    for (uint32_t frame = 0UL; frame < count; frame++)
+    {
+        (void) EVE_int_service();
+        while (E_OK != EVE_pace_service())
+        {
+            if (0U != refresh)
+            {
+                EVE_model_poke32(REG_FRAMES, EVE_model_peek32(REG_FRAMES) + 1UL);
+            }
+            else
+            {
+                EVE_model_advance_us(100UL);
+            }
+            (void) EVE_int_service();
+        }
+        EVE_model_advance_us(build_us);
+        EVE_start_cmd_burst();
+        check_frame(0x0d0000UL, 10U);
+        EVE_end_cmd_burst();
+        EVE_pace_sent();
+        if (0U != refresh)
+        {
+            EVE_execute_cmd(); /* the swap is right away, before REG_FRAMES is counted up */
+        }
+    }
+}
+
+/* frames that are fast enough go out with every refresh, a frame that takes one and a half refresh lowers the rate */
+/* to every second refresh and after EVE_PACE_SETTLE fast frames it is raised again, */
+/* frames that are on screen with the refresh they were due in do not lower the divider below 1 */
+static void check_pace(void)
+{
+    EVE_pace_stats_t pace;
+    uint32_t frames = EVE_model_peek32(REG_FRAMES);
+    uint8_t pclk = EVE_memRead8(REG_PCLK);
+
+    EVE_pace_init(4U, 0U);
+    check_pace_frames(20UL, 0UL, 0U);
+    frames = EVE_model_peek32(REG_FRAMES) - frames;
+    EVE_pace_get_stats(&pace, 1U);
+    CHECK((20UL == pace.frames) && (0UL == pace.missed) && (1U == pace.divider));
+    CHECK((frames >= 19UL) && (frames <= 21UL)); /* one frame every refresh */
+    CHECK(0UL != pace.refresh_us);
+
+    check_pace_frames(1UL, (pace.refresh_us * 3UL) / 2UL, 0U);
+    check_pace_frames(EVE_PACE_SETTLE, 0UL, 0U); /* the slow frame and EVE_PACE_SETTLE - 1 fast ones are done */
+    EVE_pace_get_stats(&pace, 1U);
+    CHECK((1UL == pace.missed) && (2U == pace.divider));
+    check_pace_frames(2UL, 0UL, 0U);
+    EVE_pace_get_stats(&pace, 1U);
+    CHECK((0UL == pace.missed) && (1U == pace.divider));
+    EVE_execute_cmd();
+    check_swap();
+
+    (void) EVE_memRead8(REG_INT_FLAGS);
+    EVE_model_set_int_hook(EVE_int_edge);
+    EVE_memWrite8(REG_PCLK, 0U); /* the swap is right away, REG_FRAMES stays */
+    EVE_pace_init(4U, 1U);
+    check_pace_frames((EVE_PACE_SETTLE * 2UL) + 1UL, 0UL, 1U);
+    EVE_pace_get_stats(&pace, 1U);
+    CHECK((0UL == pace.missed) && (1U == pace.divider));
+    EVE_execute_cmd();
+    check_swap();
+
+    EVE_memWrite8(REG_PCLK, pclk);
+    EVE_int_set_callback(EVE_INT_SWAP, NULL);
+    EVE_model_set_int_hook(NULL);
+}
+
+#if EVE_GEN > 2
+
+static const EVE_asset_t check_assets[2U] =
+{
+    {0x10000UL, BENCH_BLOCK_SIZE, 0U},
+    {0x20800UL, BENCH_BLOCK_SIZE, 1U} /* crosses a 4kiB boundary of the flash, can be used from the flash */
+};
+
+/* the assets are read from the flash to RAM_G, an asset that is in RAM_G already is not read again */
+/* and with only room for one of them the least recently used one is evicted */
+static void check_assets_load(void)
+{
+    static const uint16_t ids[2U] = {0U, 1U};
+    EVE_model_stats_t stats;
+    uint8_t hog;
+
+    EVE_model_flash_load(check_assets[0U].flash_address, bench_pattern, BENCH_BLOCK_SIZE);
+    EVE_model_flash_load(check_assets[1U].flash_address, bench_pattern, BENCH_BLOCK_SIZE);
+    CHECK(E_OK == EVE_init_flash());
+
+    EVE_ram_init(0U);
+    EVE_asset_init(check_assets, 2U);
+    CHECK(E_OK == EVE_asset_load(ids, 2U));
+    CHECK(0U != check_pattern(EVE_asset_address(0U)));
+    CHECK(0U != check_pattern(EVE_asset_address(1U)));
+    CHECK(EVE_asset_address(0U) != EVE_asset_address(1U));
+
+    EVE_model_clear_stats();
+    CHECK(E_OK == EVE_asset_load(ids, 2U));
+    EVE_model_get_stats(&stats);
+    CHECK(0U == stats.fifo_bytes);
+
+    EVE_ram_init(0U); /* leaves room for one asset */
+    hog = EVE_ram_alloc(EVE_RAM_G_SIZE - BENCH_BLOCK_SIZE - 1000UL, 4UL);
+    EVE_asset_init(check_assets, 2U);
+    CHECK(E_OK == EVE_asset_load(&ids[1U], 1U));
+    CHECK(0U != check_pattern(EVE_asset_address(1U)));
+    CHECK(E_OK == EVE_asset_load(&ids[0U], 1U));
+    CHECK(0U != check_pattern(EVE_asset_address(0U)));
+    CHECK((0x800000UL | (0x20800UL / 32UL)) == EVE_asset_address(1U)); /* evicted, drawn from the flash */
+    CHECK(E_OK == EVE_asset_load(ids, 2U)); /* asset 1 does not fit next to asset 0 and stays in the flash */
+    CHECK(0U != check_pattern(EVE_asset_address(0U)));
+    CHECK((0x800000UL | (0x20800UL / 32UL)) == EVE_asset_address(1U));
+
+    EVE_asset_init(NULL, 0U);
+    EVE_ram_free(hog);
+}
+
+/* the same writes, reads and a frame with 1, 2 and 4 data lines, the same bytes go over the SPI, only faster */
+static void check_spi_width(void)
+{
+    static const uint8_t widths[3U] = {1U, 2U, 4U};
+    EVE_model_stats_t stats;
+    uint32_t spi_bytes[3U];
+
+    CHECK(E_NOT_OK == EVE_set_spi_width(3U));
+
+    for (uint8_t index = 0U; index < 3U; index++)
+    {
+        CHECK(E_OK == EVE_set_spi_width(widths[index]));
+        CHECK((uint32_t) (widths[index] >> 1U) == (EVE_model_peek32(REG_SPI_WIDTH) & 3UL));
+        EVE_model_clear_stats();
+
+        (void) memset(bench_readback, 0, BENCH_BLOCK_SIZE);
+        EVE_memWrite_sram_buffer(BENCH_MEM + (index * BENCH_BLOCK_SIZE), bench_pattern, BENCH_BLOCK_SIZE);
+        EVE_memRead_sram_buffer(BENCH_MEM + (index * BENCH_BLOCK_SIZE), bench_readback, BENCH_BLOCK_SIZE);
+        CHECK(0 == memcmp(bench_pattern, bench_readback, BENCH_BLOCK_SIZE));
+        CHECK(0U != check_pattern(BENCH_MEM + (index * BENCH_BLOCK_SIZE)));
+        EVE_memWrite32(BENCH_MEM, 0x12345678UL + index);
+        CHECK((0x12345678UL + index) == EVE_memRead32(BENCH_MEM));
+        EVE_model_get_stats(&stats);
+        spi_bytes[index] = stats.spi_bytes;
+
+        EVE_start_cmd_burst();
+        check_frame(0x0c0000UL + index, 100U);
+        EVE_end_cmd_burst();
+        EVE_execute_cmd();
+        check_swap();
+        check_frame_dl(0x0c0000UL + index, 100U);
+
+        EVE_model_get_stats(&stats);
+        CHECK(0U == stats.protocol_errors);
+    }
+
+    CHECK(spi_bytes[0U] == spi_bytes[1U]);
+    CHECK(spi_bytes[0U] == spi_bytes[2U]);
+    CHECK(E_OK == EVE_set_spi_width(1U));
+}
+
+#endif /* EVE_GEN > 2 */
+
+#if defined (EVE_DMA)
+
+/* a burst with a command the coprocessor does not know, it faults when it gets to it */
+static void check_fault_burst(void)
+{
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(0xffffffffUL);
+    EVE_end_cmd_burst();
+}
+
+/* the fault is counted by the model and remembered by EVE_busy(), check_run() would report both */
+static void check_fault_clear(void)
+{
+    EVE_model_stats_t stats;
+
+    EVE_model_get_stats(&stats);
+    CHECK(1U == stats.faults);
+    CHECK(EVE_FAULT_RECOVERED == EVE_get_and_reset_fault_state());
+    EVE_model_clear_stats();
+}
+
+/* the next frames are built while the co-processor still waits for the swap of the first one, */
+/* with two buffers the host gets two frames ahead before it has to wait for the first swap, */
+/* a frame that is queued when a fault is found is dropped, the one after the recovery is sent */
+static void check_dma_ring(void)
+{
+    EVE_model_stats_t stats;
+
+    EVE_start_cmd_burst();
+    check_frame(0UL, 0U);
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    check_swap(); /* the frames below start right after a swap */
+    EVE_model_clear_stats();
+
+    for (uint32_t frame = 0U; frame < (2U + EVE_DMA_BUFFERS); frame++)
+    {
+        EVE_start_cmd_burst();
+        check_frame(frame * 0x10000UL, 600U);
+        EVE_end_cmd_burst();
+    }
+
+    EVE_model_get_stats(&stats);
+    CHECK(0U == stats.swaps); /* all of the frames were built before the first one was on screen */
+    CHECK(EVE_IS_BUSY == EVE_busy());
+    CHECK(EVE_model_peek32(REG_CMD_READ) != EVE_model_peek32(REG_CMD_WRITE));
+
+    EVE_execute_cmd();
+    check_swap();
+    EVE_model_get_stats(&stats);
+    CHECK((2U + EVE_DMA_BUFFERS) == stats.swaps);
+    check_frame_dl((1UL + EVE_DMA_BUFFERS) * 0x10000UL, 600U);
+
+    EVE_model_clear_stats();
+    check_fault_burst();
+    EVE_start_cmd_burst();
+    check_frame(0x0e0000UL, 40U);
+    EVE_end_cmd_burst(); /* EVE_busy() finds the fault */
+    EVE_start_cmd_burst();
+    check_frame(0x0f0000UL, 40U);
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    check_swap();
+    EVE_model_get_stats(&stats);
+    CHECK(1U == stats.swaps);
+    check_frame_dl(0x0f0000UL, 40U);
+    check_fault_clear();
+}
+
+/* a frame that is identical to the last one is not sent, RAM_DL keeps the last one, */
+/* unless the last one was lost to a coprocessor fault */
+static void check_frame_skip(void)
+{
+    EVE_frame_stats_t frame_stats;
+    EVE_model_stats_t stats;
+
+    EVE_frame_get_stats(&frame_stats, 1U);
+
+    EVE_frame_start();
+    check_frame(0x010000UL, 32U);
+    CHECK(E_OK == EVE_frame_end());
+    EVE_execute_cmd();
+    check_swap();
+
+    EVE_model_clear_stats();
+    EVE_frame_start();
+    check_frame(0x010000UL, 32U);
+    CHECK(EVE_FRAME_SKIPPED == EVE_frame_end());
+    EVE_execute_cmd();
+    EVE_model_get_stats(&stats);
+    CHECK(0U == stats.fifo_bytes);
+    CHECK(0U == stats.swaps);
+
+    EVE_frame_start();
+    check_frame(0x020000UL, 32U);
+    CHECK(E_OK == EVE_frame_end());
+    EVE_execute_cmd();
+    check_swap();
+    check_frame_dl(0x020000UL, 32U);
+
+    EVE_frame_invalidate();
+    EVE_frame_start();
+    check_frame(0x020000UL, 32U);
+    CHECK(E_OK == EVE_frame_end());
+    EVE_execute_cmd();
+    check_swap();
+    EVE_model_get_stats(&stats);
+    CHECK(2U == stats.swaps);
+
+    EVE_frame_get_stats(&frame_stats, 1U);
+    CHECK(4U == frame_stats.frames);
+    CHECK(1U == frame_stats.skipped);
+
+    check_fault_burst();
+    EVE_frame_start();
+    check_frame(0x030000UL, 32U);
+    CHECK(E_OK == EVE_frame_end()); /* dropped by the fault recovery */
+    EVE_execute_cmd();
+    EVE_frame_start();
+    check_frame(0x030000UL, 32U);
+    CHECK(E_OK == EVE_frame_end()); /* not on screen, the same frame is sent again */
+    EVE_execute_cmd();
+    check_swap();
+    check_frame_dl(0x030000UL, 32U);
+    check_fault_clear();
+}
+
+#endif /* EVE_DMA */
+
+#if EVE_MODEL_INSTANCES > 1
+
+static EVE_ctx_t check_ctx[2U];
+#if defined (EVE_DMA)
+static uint32_t check_ring[EVE_DMA_RING_WORDS]; /* the second EVE needs its own DMA buffers */
+#endif
+
+static void check_select_first(void)
+{
+    EVE_model_select(0U);
+}
+
+static void check_select_second(void)
+{
+    EVE_model_select(1U);
+}
+
+static void check_edge_second(void)
+{
+    EVE_ctx_int_edge(&check_ctx[1U]);
+}
+
+static void check_frame_first(void)
+{
+    EVE_start_cmd_burst();
+    check_frame(0x0b0000UL, 50U);
+    EVE_end_cmd_burst();
+}
+
+/* two EVE with their own display list, INT_N and interrupt callbacks, */
+/* with EVE_DMA the burst for the second EVE is continued after a frame was sent to the first one */
+static void check_contexts(void)
+{
+    EVE_model_stats_t stats;
+    uint32_t *p_ring = NULL;
+
+#if defined (EVE_DMA)
+    p_ring = check_ring;
+#endif
+    EVE_ctx_init(&check_ctx[0U], check_select_first, NULL);
+    EVE_ctx_init(&check_ctx[1U], check_select_second, p_ring);
+    EVE_ctx_select(&check_ctx[0U]); /* the first EVE is the one EVE_init() was called for in main() */
+    EVE_ctx_select(&check_ctx[1U]);
+    CHECK(E_OK == EVE_init());
+
+    check_callbacks = 0U;
+    EVE_model_set_int_hook(check_edge_second);
+    (void) EVE_memRead8(REG_INT_FLAGS);
+    EVE_int_set_callback(EVE_INT_SWAP, check_callback);
+
+    EVE_start_cmd_burst();
+    check_frame(0x0a0000UL, 40U);
+#if defined (EVE_DMA)
+    EVE_ctx_select(&check_ctx[0U]);
+    check_frame_first();
+    EVE_ctx_select(&check_ctx[1U]);
+#endif
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    check_swap();
+    check_frame_dl(0x0a0000UL, 40U);
+
+    EVE_ctx_select(&check_ctx[0U]);
+    CHECK(0U == EVE_model_peek32(REG_INT_MASK)); /* the callback is only set for the second EVE */
+    CHECK(0U == EVE_int_service()); /* the edge was on INT_N of the second EVE */
+#if !defined (EVE_DMA)
+    check_frame_first();
+#endif
+    EVE_execute_cmd();
+    check_swap();
+    check_frame_dl(0x0b0000UL, 50U);
+    CHECK(0U == check_callbacks);
+
+    EVE_ctx_select(&check_ctx[1U]);
+    CHECK(0U != (EVE_INT_SWAP & EVE_int_service()));
+    CHECK(1U == check_callbacks);
+    EVE_int_set_callback(EVE_INT_SWAP, NULL);
+    EVE_model_set_int_hook(NULL);
+    EVE_model_get_stats(&stats); /* check_run() only sees the first EVE */
+    CHECK(0U == (stats.faults + stats.protocol_errors + stats.fifo_overflows + stats.bit_errors));
+    EVE_ctx_select(&check_ctx[0U]);
+}
+
+#endif /* EVE_MODEL_INSTANCES > 1 */
+
+#if defined (EVE_SPI_CLOCK_MAX)
+
+#define CHECK_SPI_LIMIT 20000000UL /* the fastest clock the model works with in check_spi_clock() */
+
+/* EVE_init() raises the SPI clock up to the last step below the limit of the connection */
+static void check_spi_clock(void)
+{
+    EVE_model_stats_t stats;
+    uint32_t clock;
+
+    EVE_model_spi_limit(CHECK_SPI_LIMIT);
+    CHECK(E_OK == EVE_init());
+    clock = EVE_get_spi_clock();
+    CHECK(clock <= CHECK_SPI_LIMIT);
+    CHECK(clock > EVE_SPI_CLOCK_INIT);
+    CHECK((clock + EVE_SPI_CLOCK_STEP) > CHECK_SPI_LIMIT);
+    CHECK(clock == EVE_ramp_spi_clock()); /* the same again */
+    EVE_model_get_stats(&stats);
+    CHECK(0U != stats.bit_errors); /* the ramp went past the limit */
+    EVE_model_clear_stats(); /* check_run() counts the bit errors */
+
+    EVE_memWrite_sram_buffer(BENCH_MEM, bench_pattern, BENCH_BLOCK_SIZE);
+    CHECK(0U != check_pattern(BENCH_MEM));
+    EVE_memRead_sram_buffer(BENCH_MEM, bench_readback, BENCH_BLOCK_SIZE);
+    CHECK(0 == memcmp(bench_pattern, bench_readback, BENCH_BLOCK_SIZE));
+    EVE_model_spi_limit(0U);
+#if EVE_GEN > 2
+    CHECK(E_OK == EVE_init_flash());
+#endif
+}
+
+#endif /* EVE_SPI_CLOCK_MAX */
+
+#if defined (EVE_DL_BUDGET)
+
+#define CHECK_DL_LIMIT 200UL /* bytes, check_frame() with 48 colors goes over it */
+
+static uint32_t check_dl_estimate; /* what check_dl_callback() got last */
+
+static void check_dl_callback(uint32_t estimate)
+{
+    check_callbacks++;
+    check_dl_estimate = estimate;
+}
+
+/* a frame from check_frame() with count colors, 12 + (count * 4) bytes in RAM_DL, */
+/* returns what EVE_dl_budget_check() returned */
+static uint8_t check_dl_frame(uint32_t count)
+{
+    EVE_start_cmd_burst();
+    check_frame(0x0c0000UL, count);
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    check_swap();
+    return (EVE_dl_budget_check());
+}
+
+/* the estimate for display-list commands is exact and the callback is called once when it goes over the limit, */
+/* words from EVE_cmd_words_burst() are not estimated and are added to the next display list by the correction, */
+/* CMD_FLASHREAD does not add to the estimate and each EVE has its own budget */
+static void check_dl_budget(void)
+{
+    static uint32_t words[20U];
+    EVE_dl_budget_stats_t budget;
+    uint32_t left;
+#if EVE_GEN > 2
+    static const uint16_t id = 0U;
+#endif
+
+    EVE_dl_budget_init(CHECK_DL_LIMIT, check_dl_callback);
+    EVE_dl_budget_get_stats(NULL, 1U);
+    check_callbacks = 0U;
+
+    CHECK(E_OK == check_dl_frame(40U));
+    CHECK(0U == check_callbacks);
+    CHECK((CHECK_DL_LIMIT - 172UL) == EVE_dl_budget_left());
+    CHECK(E_NOT_OK == check_dl_frame(60U));
+    CHECK(1U == check_callbacks);
+    CHECK(204UL == check_dl_estimate); /* the color that went over the limit, not called again after that */
+    CHECK(0UL == EVE_dl_budget_left());
+    EVE_dl_budget_get_stats(&budget, 1U);
+    CHECK((2UL == budget.frames) && (1UL == budget.warnings) && (1UL == budget.over_limit));
+    CHECK((252UL == budget.estimate) && (252UL == budget.measured) && (252UL == budget.peak));
+
+    for (uint32_t index = 0UL; index < 20UL; index++)
+    {
+        words[index] = DL_COLOR_RGB | index;
+    }
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_cmd_words_burst(words, 20UL);
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    check_swap();
+    CHECK(E_OK == EVE_dl_budget_check());
+    EVE_dl_budget_get_stats(&budget, 0U);
+    CHECK((4UL == budget.estimate) && (84UL == budget.measured));
+    CHECK((CHECK_DL_LIMIT - 84UL) == EVE_dl_budget_left());
+    CHECK(E_OK == check_dl_frame(40U)); /* 172 bytes and 80 bytes of correction */
+    CHECK(2U == check_callbacks);
+    CHECK(204UL == check_dl_estimate); /* 29 colors, 80 bytes earlier than without the correction */
+    CHECK((CHECK_DL_LIMIT - 172UL) == EVE_dl_budget_left()); /* the estimate was right this time */
+
+#if EVE_GEN > 2
+    left = EVE_dl_budget_left();
+    EVE_ram_init(0U);
+    EVE_asset_init(check_assets, 2U);
+    CHECK(E_OK == EVE_asset_load(&id, 1U));
+    CHECK(left == EVE_dl_budget_left());
+    EVE_asset_init(NULL, 0U);
+    EVE_ram_init(0U);
+#endif
+
+#if EVE_MODEL_INSTANCES > 1
+    EVE_ctx_select(&check_ctx[1U]);
+    EVE_dl_budget_init(100UL, NULL);
+    EVE_dl_budget_get_stats(NULL, 1U);
+    CHECK(E_NOT_OK == check_dl_frame(40U));
+    EVE_ctx_select(&check_ctx[0U]);
+    left = EVE_dl_budget_left();
+    CHECK((CHECK_DL_LIMIT - 172UL) == left); /* the first EVE still has its own limit */
+    CHECK(E_OK == check_dl_frame(40U));
+    CHECK(2U == check_callbacks);
+    EVE_ctx_select(&check_ctx[1U]);
+    EVE_dl_budget_get_stats(&budget, 1U);
+    CHECK((1UL == budget.frames) && (1UL == budget.over_limit) && (1UL == budget.warnings));
+    EVE_ctx_select(&check_ctx[0U]);
+#endif
+    (void) left;
+
+    EVE_dl_budget_init(0UL, NULL);
+    EVE_dl_budget_get_stats(NULL, 1U);
+}
+
+#endif /* EVE_DL_BUDGET */
+
+static const check_t check_list[] =
+{
+#if defined (EVE_DMA)
+    {"EVE_DMA ring", check_dma_ring},
+    {"EVE_frame_end", check_frame_skip},
+#endif
+    {"EVE_burst_segment", check_burst_segments},
+    {"EVE_cmd_poll", check_cmd_poll},
+    {"EVE_int_service", check_int_dispatch},
+    {"EVE_segment_update", check_segment},
+    {"EVE_ram_compact", check_ram_compact},
+    {"EVE_media_poll", check_media_fifo},
+    {"EVE_text_burst", check_text_fields},
+    {"EVE_reg_batch_send", check_reg_batch},
+    {"EVE_touch_service", check_touch_events},
+    {"EVE_list_burst", check_list_scroll},
+    {"EVE_chart_burst", check_chart},
+    {"EVE_pace_service", check_pace},
+#if EVE_GEN > 2
+    {"EVE_asset_load", check_assets_load},
+    {"EVE_set_spi_width", check_spi_width},
+#endif
+#if EVE_MODEL_INSTANCES > 1
+    {"EVE_ctx_select", check_contexts},
+#endif
+#if defined (EVE_SPI_CLOCK_MAX)
+    {"EVE_ramp_spi_clock", check_spi_clock},
+#endif
+#if defined (EVE_DL_BUDGET)
+    {"EVE_dl_budget_check", check_dl_budget},
+#endif
+    {NULL, NULL}
+};
+
+/* ################################################################## */
+
+static uint64_t bench_nsec(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((((uint64_t) now.tv_sec) * 1000000000ULL) + ((uint64_t) now.tv_nsec));
+}
+
+/* runs p_function in BENCH_REPEAT batches, each on a fresh display list */
+static void bench_run(void (*p_function)(void), uint8_t mode, uint8_t calls, bench_result_t *p_result)
+{
+    EVE_model_stats_t stats;
+
+    p_result->spi_bytes = 0U;
+    p_result->cs_cycles = 0U;
+    p_result->nsec = 0U;
+    p_result->calls = 0U;
+    p_result->errors = 0U;
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEAT; repeat++)
+    {
+        uint64_t start;
+
+        EVE_cmd_dl(CMD_DLSTART);
+        EVE_execute_cmd();
+
+        EVE_model_clear_stats();
+        start = bench_nsec();
+
+        if (BENCH_BURST == mode)
+        {
+            EVE_start_cmd_burst();
+        }
+
+        for (uint8_t index = 0U; index < calls; index++)
+        {
+            p_function();
+        }
+
+        if (BENCH_BURST == mode)
+        {
+            EVE_end_cmd_burst();
+        }
+
+        p_result->nsec += bench_nsec() - start;
+        EVE_model_get_stats(&stats);
+        p_result->spi_bytes += stats.spi_bytes;
+        p_result->cs_cycles += stats.cs_cycles;
+        p_result->calls += calls;
+
+        EVE_execute_cmd(); /* let the co-processor finish and check what it thought of it */
+        EVE_model_get_stats(&stats);
+        p_result->errors += stats.faults + stats.protocol_errors + stats.fifo_overflows + bench_mismatches;
+        bench_mismatches = 0U;
+        if (EVE_FAULT_RECOVERED == EVE_get_and_reset_fault_state())
+        {
+            p_result->errors++;
+        }
+    }
+}
+
+static void bench_print(const char *p_name, uint8_t mode, const bench_result_t *p_result, const bench_result_t *p_overhead)
+{
+    double calls = (double) p_result->calls;
+    double spi_bytes = (double) p_result->spi_bytes;
+    double cs_cycles = (double) p_result->cs_cycles;
+    double nsec = (double) p_result->nsec;
+
+    if (NULL != p_overhead) /* both ran for BENCH_REPEAT batches */
+    {
+        spi_bytes -= (double) p_overhead->spi_bytes;
+        cs_cycles -= (double) p_overhead->cs_cycles;
+        nsec -= (double) p_overhead->nsec;
+    }
+
+    (void) printf("%s,%s,%lu,%.2f,%.2f,%.1f,%lu\n", p_name,
+                  (BENCH_CHECK == mode) ? "check" : ((BENCH_BURST == mode) ? "burst" : "single"),
+                  (unsigned long) p_result->calls, spi_bytes / calls, cs_cycles / calls, nsec / calls,
+                  (unsigned long) p_result->errors);
+}
+
+/* runs a behaviour check once, errors are the comparisons that failed and anything the model complained about */
+static void check_run(const check_t *p_check, bench_result_t *p_result)
+{
+    EVE_model_stats_t stats;
+    uint64_t start;
+
+    EVE_execute_cmd();
+    EVE_model_clear_stats();
+    check_failures = 0U;
+    start = bench_nsec();
+
+    p_check->p_function();
+
+    p_result->nsec = bench_nsec() - start;
+    EVE_execute_cmd();
+    CHECK(EVE_model_peek32(REG_CMD_READ) == EVE_model_peek32(REG_CMD_WRITE)); /* nothing is left in the CMD-FIFO */
+    EVE_model_get_stats(&stats);
+    p_result->spi_bytes = stats.spi_bytes;
+    p_result->cs_cycles = stats.cs_cycles;
+    p_result->calls = 1U;
+    p_result->errors = check_failures + stats.faults + stats.protocol_errors + stats.fifo_overflows + stats.bit_errors;
+    if (EVE_FAULT_RECOVERED == EVE_get_and_reset_fault_state())
+    {
+        p_result->errors++;
+    }
+}
+
+int main(void)
+{
+    bench_result_t overhead;
+    bench_result_t result;
+    uint32_t errors = 0U;
+
+    if (E_OK == EVE_init())
+    {
+#if EVE_GEN > 2
+        (void) EVE_init_flash();
+#endif
+        for (uint32_t index = 0U; index < BENCH_BLOCK_SIZE; index++)
+        {
+            bench_pattern[index] = (uint8_t) ((index * 7U) + (index >> 8U));
+        }
+
+        (void) printf("function,mode,calls,spi_bytes,cs_toggles,host_ns,errors\n");
+
+        /* an empty burst, one call per batch so this is the cost of the burst itself */
+        bench_run(bench_none, BENCH_BURST, 1U, &overhead);
+        bench_print("EVE_start_cmd_burst+EVE_end_cmd_burst", BENCH_BURST, &overhead, NULL);
+        errors += overhead.errors;
+
+        for (uint32_t entry = 0U; entry < (sizeof(bench_list) / sizeof(bench_list[0U])); entry++)
+        {
+            const bench_t *p_bench = &bench_list[entry];
+            uint8_t calls = (0U == p_bench->calls) ? BENCH_CALLS : p_bench->calls;
+
+            if (0U != (p_bench->modes & BENCH_SINGLE))
+            {
+                bench_run(p_bench->p_function, BENCH_SINGLE, calls, &result);
+                bench_print(p_bench->p_name, BENCH_SINGLE, &result, NULL);
+                errors += result.errors;
+            }
+
+            if (0U != (p_bench->modes & BENCH_BURST))
+            {
+                bench_run(p_bench->p_function, BENCH_BURST, calls, &result);
+                bench_print(p_bench->p_name, BENCH_BURST, &result, &overhead);
+                errors += result.errors;
+            }
+        }
+
+        for (uint32_t entry = 0U; NULL != check_list[entry].p_function; entry++)
+        {
+            check_run(&check_list[entry], &result);
+            bench_print(check_list[entry].p_name, BENCH_CHECK, &result, NULL);
+            errors += result.errors;
+        }
+    }
+    else
+    {
+        (void) fprintf(stderr, "EVE_init() failed\n");
+        errors = 1U;
+    }
+
+    return ((0U == errors) ? 0 : 1);
+}
@@ -0,0 +1,338 @@
+/*
+@file    stream_check.cpp
+@brief   Compares the words from EVE_cmd_stream with the EVE_cmd_xxx_burst() functions, runs on Linux with the SOFTWARE_TEST target
+@version 1.0
+@date    2026-10-17
+@author  Rudolph Riedel
+
+Each frame from frame_list[] is encoded twice, once with the EVE_cmd_xxx_burst() functions and once
+with EVE_cmd_stream, and both are sent as a burst to the model in EVE_model.c.
+The bytes that arrive in RAM_CMD are compared byte for byte and the bytes on the SPI and the
+chip-select cycles need to be the same as well.
+A stream that ran out of space must not add anything to a burst and must not be sent.
+
+It prints one line per frame as comma separated values:
+
+frame,fifo_bytes,spi_bytes,errors
+
+The exit code is not zero if any comparison failed or the model saw a coprocessor fault
+or a broken SPI transfer, the check stops at the first frame that differs.
+This is built by the "native_stream" environment, without PlatformIO it can be built from the root
+of the repository with:
+gcc -std=c99 -O2 -DSOFTWARE_TEST -DEVE_EVE3_50G -I. -c EVE_commands.c EVE_target.c EVE_model.c
+g++ -std=c++11 -O2 -DSOFTWARE_TEST -DEVE_EVE3_50G -I. examples/EVE_Benchmark_Linux_PlatformIO/src/stream_check.cpp
+EVE_commands.o EVE_target.o EVE_model.o -o stream_check
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "EVE.h"
+#include "EVE_cmd_stream.h"
+
+#define STREAM_WORDS 256U /* words in the buffer of the stream, a frame from frame_list[] fits into it */
+#define STREAM_FIFO_MASK 0xfffUL /* RAM_CMD is a ring of 4 kiB */
+
+typedef struct
+{
+    const char *p_name;
+    void (*p_burst)(void); /* the frame with the EVE_cmd_xxx_burst() functions */
+    void (*p_stream)(EVE_cmd_stream &stream); /* the same frame with EVE_cmd_stream */
+} frame_t;
+
+typedef struct
+{
+    uint8_t fifo[EVE_CMDFIFO_SIZE];
+    uint32_t length;
+    EVE_model_stats_t stats;
+} capture_t;
+
+/* counts a failed comparison */
+#define CHECK(condition) check_true((condition) ? 1U : 0U, #condition, __LINE__)
+
+static uint32_t stream_words[STREAM_WORDS];
+static uint32_t check_failures;
+static capture_t capture_burst;
+static capture_t capture_stream;
+
+/* ################################################################## */
+
+static void check_true(uint8_t condition, const char *p_text, int line)
+{
+    if (0U == condition)
+    {
+        check_failures++;
+        (void) fprintf(stderr, "stream_check.cpp:%d: check failed: %s\n", line, p_text);
+    }
+}
+
+/* ################################################################## */
+
+static void frame_widgets_burst(void)
+{
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_cmd_dl_burst(DL_CLEAR_COLOR_RGB | 0x102030UL);
+    EVE_cmd_dl_burst(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    EVE_color_rgb_burst(0xffffffUL);
+    EVE_cmd_fgcolor_burst(0x00c040UL);
+    EVE_cmd_bgcolor_burst(0x202020UL);
+    EVE_cmd_gauge_burst(100, 100, 80U, 0U, 5U, 4U, 30U, 100U);
+    EVE_cmd_keys_burst(10, 200, 300U, 40U, 28U, 0U, "12345");
+    EVE_cmd_toggle_burst(10, 250, 60U, 27U, 0U, 0xffffU, "on\xffoff");
+    EVE_cmd_number_burst(400, 10, 28U, EVE_OPT_SIGNED, -1234);
+    EVE_cmd_clock_burst(600, 100, 60U, 0U, 10U, 20U, 30U, 0U);
+    EVE_cmd_dial_burst(600, 300, 50U, 0U, 0x4000U);
+    EVE_cmd_progress_burst(10, 300, 200U, 12U, 0U, 40U, 100U);
+    EVE_cmd_slider_burst(10, 330, 200U, 12U, 0U, 60U, 100U);
+    EVE_cmd_scrollbar_burst(10, 360, 200U, 12U, 0U, 20U, 30U, 100U);
+    EVE_cmd_gradient_burst(0, 400, 0x0000ffUL, 200, 470, 0xff0000UL);
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+}
+
+static void frame_widgets_stream(EVE_cmd_stream &stream)
+{
+    stream.dlstart();
+    stream.dl(DL_CLEAR_COLOR_RGB | 0x102030UL);
+    stream.dl(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    stream.color_rgb(0xffffffUL);
+    stream.fgcolor(0x00c040UL);
+    stream.bgcolor(0x202020UL);
+    stream.gauge(100, 100, 80U, 0U, 5U, 4U, 30U, 100U);
+    stream.keys(10, 200, 300U, 40U, 28U, 0U, "12345");
+    stream.toggle(10, 250, 60U, 27U, 0U, 0xffffU, "on\xffoff");
+    stream.number(400, 10, 28U, EVE_OPT_SIGNED, -1234);
+    stream.clock(600, 100, 60U, 0U, 10U, 20U, 30U, 0U);
+    stream.dial(600, 300, 50U, 0U, 0x4000U);
+    stream.progress(10, 300, 200U, 12U, 0U, 40U, 100U);
+    stream.slider(10, 330, 200U, 12U, 0U, 60U, 100U);
+    stream.scrollbar(10, 360, 200U, 12U, 0U, 20U, 30U, 100U);
+    stream.gradient(0, 400, 0x0000ffUL, 200, 470, 0xff0000UL);
+    stream.dl(DL_DISPLAY);
+    stream.swap();
+}
+
+/* strings of 0 to 8 characters, every length of the padding to the next word */
+static void frame_text_burst(void)
+{
+    static const char *const texts[9U] = {"", "a", "ab", "abc", "abcd", "abcde", "abcdef", "abcdefg", "abcdefgh"};
+
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_cmd_dl_burst(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    for (uint8_t index = 0U; index < 9U; index++)
+    {
+        EVE_cmd_text_burst(10, (int16_t) (index * 20U), 26U, 0U, texts[index]);
+    }
+    EVE_cmd_button_burst(200, 10, 120U, 40U, 28U, 0U, "OK");
+    EVE_cmd_setfont2_burst(12UL, 0x1000UL, 32UL);
+    EVE_cmd_romfont_burst(13UL, 31UL);
+    EVE_cmd_setbitmap_burst(0x2000UL, EVE_RGB565, 64U, 32U);
+    EVE_cmd_translate_burst(65536L * 10L, -65536L * 5L);
+    EVE_cmd_scale_burst(2L * 65536L, 65536L / 2L);
+    EVE_cmd_rotate_burst(0x12345UL);
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+}
+
+static void frame_text_stream(EVE_cmd_stream &stream)
+{
+    static const char *const texts[9U] = {"", "a", "ab", "abc", "abcd", "abcde", "abcdef", "abcdefg", "abcdefgh"};
+
+    stream.dlstart();
+    stream.dl(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    for (uint8_t index = 0U; index < 9U; index++)
+    {
+        stream.text(10, (int16_t) (index * 20U), 26U, 0U, texts[index]);
+    }
+    stream.button(200, 10, 120U, 40U, 28U, 0U, "OK");
+    stream.setfont2(12UL, 0x1000UL, 32UL);
+    stream.romfont(13UL, 31UL);
+    stream.setbitmap(0x2000UL, EVE_RGB565, 64U, 32U);
+    stream.translate(65536L * 10L, -65536L * 5L);
+    stream.scale(2L * 65536L, 65536L / 2L);
+    stream.rotate(0x12345UL);
+    stream.dl(DL_DISPLAY);
+    stream.swap();
+}
+
+#if EVE_GEN > 2
+
+/* the arguments for EVE_OPT_FORMAT, without the option they are not sent */
+static void frame_format_burst(void)
+{
+    static const uint32_t one[1U] = {3300UL};
+    static const uint32_t two[2U] = {12UL, 34UL};
+
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    EVE_cmd_dl_burst(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    EVE_cmd_text_var_burst(10, 10, 28U, EVE_OPT_FORMAT, "%d mV", 1U, one);
+    EVE_cmd_text_var_burst(10, 50, 28U, 0U, "%d mV", 1U, one);
+    EVE_cmd_button_var_burst(10, 100, 120U, 40U, 28U, EVE_OPT_FORMAT, "%d:%d", 2U, two);
+    EVE_cmd_toggle_var_burst(10, 160, 60U, 27U, EVE_OPT_FORMAT, 0U, "%d\xff%d", 2U, two);
+    EVE_cmd_dl_burst(DL_DISPLAY);
+    EVE_cmd_dl_burst(CMD_SWAP);
+}
+
+static void frame_format_stream(EVE_cmd_stream &stream)
+{
+    stream.dlstart();
+    stream.dl(DL_CLEAR | CLR_COL | CLR_STN | CLR_TAG);
+    stream.text(10, 10, 28U, EVE_OPT_FORMAT, "%d mV", 3300UL);
+    stream.text(10, 50, 28U, 0U, "%d mV", 3300UL);
+    stream.button(10, 100, 120U, 40U, 28U, EVE_OPT_FORMAT, "%d:%d", 12UL, 34UL);
+    stream.toggle(10, 160, 60U, 27U, EVE_OPT_FORMAT, 0U, "%d\xff%d", 12UL, 34UL);
+    stream.dl(DL_DISPLAY);
+    stream.swap();
+}
+
+#endif /* EVE_GEN > 2 */
+
+static const frame_t frame_list[] =
+{
+    {"widgets", frame_widgets_burst, frame_widgets_stream},
+    {"text", frame_text_burst, frame_text_stream},
+#if EVE_GEN > 2
+    {"format", frame_format_burst, frame_format_stream},
+#endif
+};
+
+/* ################################################################## */
+
+/* copy the bytes the last burst wrote to RAM_CMD, it started at REG_CMD_WRITE "start" */
+static void capture_fifo(capture_t *p_capture, uint32_t start)
+{
+    uint32_t end = EVE_model_peek32(REG_CMD_WRITE) & STREAM_FIFO_MASK;
+
+    p_capture->length = (end - start) & STREAM_FIFO_MASK;
+    for (uint32_t index = 0UL; index < p_capture->length; index += 4UL)
+    {
+        uint32_t word = EVE_model_peek32(EVE_RAM_CMD + ((start + index) & STREAM_FIFO_MASK));
+
+        p_capture->fifo[index] = (uint8_t) word;
+        p_capture->fifo[index + 1UL] = (uint8_t) (word >> 8U);
+        p_capture->fifo[index + 2UL] = (uint8_t) (word >> 16U);
+        p_capture->fifo[index + 3UL] = (uint8_t) (word >> 24U);
+    }
+}
+
+/* send a frame with the EVE_cmd_xxx_burst() functions or, with p_stream set, with EVE_cmd_stream */
+/* this does not execute the frame, a stream that differs can leave the coprocessor waiting for the rest of a command */
+static void capture_frame(const frame_t *p_frame, EVE_cmd_stream *p_stream, capture_t *p_capture)
+{
+    uint32_t start = EVE_model_peek32(REG_CMD_WRITE) & STREAM_FIFO_MASK;
+
+    EVE_model_clear_stats();
+
+    if (p_stream != NULL)
+    {
+        p_stream->clear();
+        p_frame->p_stream(*p_stream);
+        CHECK(!p_stream->overflow());
+        CHECK(E_OK == p_stream->send());
+    }
+    else
+    {
+        EVE_start_cmd_burst();
+        p_frame->p_burst();
+        EVE_end_cmd_burst();
+    }
+
+    EVE_model_get_stats(&p_capture->stats);
+    capture_fifo(p_capture, start);
+}
+
+/* a stream that ran out of space adds nothing to a burst and is not sent at all */
+static void check_overflow(void)
+{
+    uint32_t small_words[8U];
+    EVE_cmd_stream small(small_words, 8U);
+    EVE_model_stats_t stats;
+    uint32_t start;
+
+    small.text(10, 10, 28U, 0U, "longer than eight words of the stream");
+    CHECK(small.overflow());
+    CHECK(8UL == small.size());
+
+    EVE_execute_cmd();
+    start = EVE_model_peek32(REG_CMD_WRITE);
+    EVE_start_cmd_burst();
+    CHECK(E_NOT_OK == small.burst());
+    EVE_end_cmd_burst();
+    EVE_execute_cmd();
+    CHECK(start == EVE_model_peek32(REG_CMD_WRITE));
+
+    EVE_model_clear_stats();
+    CHECK(E_NOT_OK == small.send());
+    EVE_model_get_stats(&stats);
+    CHECK(0U == stats.spi_bytes);
+
+    small.clear();
+    small.text(10, 10, 28U, 0U, "fits");
+    CHECK(!small.overflow());
+    CHECK(E_OK == small.send());
+    EVE_execute_cmd();
+    CHECK(((start + 20UL) & STREAM_FIFO_MASK) == EVE_model_peek32(REG_CMD_WRITE));
+}
+
+int main(void)
+{
+    EVE_cmd_stream stream(stream_words, STREAM_WORDS);
+    EVE_model_stats_t stats;
+    uint32_t errors = 0U;
+
+    if (E_OK == EVE_init())
+    {
+        (void) printf("frame,fifo_bytes,spi_bytes,errors\n");
+
+        for (uint32_t entry = 0U; (entry < (sizeof(frame_list) / sizeof(frame_list[0U]))) && (0U == errors); entry++)
+        {
+            check_failures = 0U;
+            capture_frame(&frame_list[entry], NULL, &capture_burst);
+            EVE_execute_cmd();
+            capture_frame(&frame_list[entry], &stream, &capture_stream);
+
+            CHECK(0UL != capture_burst.length);
+            CHECK(capture_burst.length == capture_stream.length);
+            CHECK(0 == memcmp(capture_burst.fifo, capture_stream.fifo, capture_burst.length));
+            CHECK(capture_burst.stats.spi_bytes == capture_stream.stats.spi_bytes);
+            CHECK(capture_burst.stats.cs_cycles == capture_stream.stats.cs_cycles);
+            CHECK(0U == (capture_stream.stats.protocol_errors + capture_burst.stats.protocol_errors));
+
+            if (0U == check_failures)
+            {
+                EVE_execute_cmd();
+                CHECK(0U == EVE_get_and_reset_fault_state());
+            }
+            else
+            {
+                /* the coprocessor is not started on a stream that differs */
+            }
+
+            (void) printf("%s,%u,%u,%u\n", frame_list[entry].p_name, (unsigned) capture_stream.length,
+                (unsigned) capture_stream.stats.spi_bytes, (unsigned) check_failures);
+            errors += check_failures;
+        }
+
+        if (0U == errors)
+        {
+            check_failures = 0U;
+            EVE_model_clear_stats();
+            check_overflow();
+            EVE_model_get_stats(&stats);
+            check_failures += stats.faults + stats.protocol_errors + stats.fifo_overflows;
+            (void) printf("overflow,0,0,%u\n", (unsigned) check_failures);
+            errors += check_failures;
+        }
+        else
+        {
+        }
+    }
+    else
+    {
+        (void) fprintf(stderr, "EVE_init() failed\n");
+        errors = 1U;
+    }
+
+    return ((0U == errors) ? 0 : 1);
+}